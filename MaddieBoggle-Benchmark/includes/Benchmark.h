@@ -0,0 +1,82 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+using namespace std;
+
+
+/// <summary>
+/// Formats the results of a benchmark run can be written in.
+/// </summary>
+enum class ReportFormat
+{
+    TEXT,   // aligned table for reading
+    CSV,    // one line per result, with a header line
+    JSON    // single object with an array of results
+};
+
+
+/// <summary>
+/// Timings of one benchmark case: a benchmark (what is measured) with one variant
+/// (the input it is measured on) and one thread count.
+/// </summary>
+struct BenchmarkResult
+{
+    string m_name;              // benchmark, e.g. "solve_board"
+    string m_variant;           // input of the benchmark, e.g. "5x5"
+    size_t m_threadCount;       // threads used, 1 for single threaded benchmarks
+    size_t m_repetitions;       // timed runs
+    size_t m_items;             // items processed per run (words, lookups, cells or tasks)
+    double m_minMilliseconds;
+    double m_medianMilliseconds;
+    double m_maxMilliseconds;
+
+    double itemsPerSecond() const;
+};
+
+
+/// <summary>
+/// The BenchmarkRunner class times benchmark cases and collects their results.
+/// Every case is run once untimed to warm up the caches (and the threads of a
+/// pool), then timed a number of times. The median is reported alongside the
+/// fastest and slowest runs, so noise from the rest of the machine is visible
+/// instead of hidden.
+///
+/// An optional setup step runs before every timed run without being measured,
+/// for anything a run consumes (like a fresh dictionary to import into).
+///
+/// Cases can be filtered by name, so a single benchmark can be rerun quickly.
+/// </summary>
+class BenchmarkRunner
+{
+public:
+    BenchmarkRunner(size_t repetitions, const string& filter);
+
+    bool isSelected(const string& name) const;
+    void run(const string& name, const string& variant, size_t threadCount, size_t items,
+        const function<void()>& body, const function<void()>& setup = nullptr);
+
+    const vector<BenchmarkResult>& getResults() const { return m_results; }
+    void writeReport(ostream& output, ReportFormat format) const;
+
+private:
+    const size_t m_repetitions;     // timed runs per case
+    const string m_filter;          // only cases whose name contains this run, empty runs all
+    vector<BenchmarkResult> m_results;
+
+    void writeText(ostream& output) const;
+    void writeCsv(ostream& output) const;
+    void writeJson(ostream& output) const;
+};
+
+
+#endif // BENCHMARK_H
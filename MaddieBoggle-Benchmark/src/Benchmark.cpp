@@ -0,0 +1,163 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+#include "Benchmark.h"
+
+
+/// <summary>
+/// Throughput of the median run.
+/// </summary>
+/// <returns>items processed per second, 0 if the run took no measurable time</returns>
+double BenchmarkResult::itemsPerSecond() const
+{
+    if (m_medianMilliseconds <= 0.0) return 0.0;
+    return static_cast<double>(m_items) * 1000.0 / m_medianMilliseconds;
+}
+
+
+/// <summary>
+/// Class constructor.
+/// </summary>
+/// <param name="repetitions">timed runs per case, at least 1</param>
+/// <param name="filter">only run cases whose name contains this, empty to run all of them</param>
+BenchmarkRunner::BenchmarkRunner(size_t repetitions, const string& filter) :
+    m_repetitions(max(repetitions, size_t{ 1 })),
+    m_filter(filter),
+    m_results()
+{
+    // intentionally blank
+}
+
+
+/// <summary>
+/// Checks if a benchmark passes the filter. Lets the caller skip building the
+/// input of a benchmark that won't run.
+/// </summary>
+/// <param name="name">name of the benchmark</param>
+/// <returns>true if cases of the benchmark are run</returns>
+bool BenchmarkRunner::isSelected(const string& name) const
+{
+    return m_filter.empty() || (name.find(m_filter) != string::npos);
+}
+
+
+/// <summary>
+/// Runs one benchmark case: a warmup run, then the timed runs, and records the
+/// result. Does nothing if the benchmark doesn't pass the filter.
+/// </summary>
+/// <param name="name">name of the benchmark</param>
+/// <param name="variant">input the benchmark runs on</param>
+/// <param name="threadCount">threads the case uses</param>
+/// <param name="items">items one run processes, for the throughput</param>
+/// <param name="body">the measured work</param>
+/// <param name="setup">optional unmeasured work before every run</param>
+void BenchmarkRunner::run(const string& name, const string& variant, size_t threadCount, size_t items,
+    const function<void()>& body, const function<void()>& setup)
+{
+    assert(body);
+    if (!isSelected(name)) return; // early return, filtered out
+
+    if (setup) setup();
+    body(); // warm up, not measured
+
+    vector<double> milliseconds{};
+    for (size_t run = 0; run < m_repetitions; run++)
+    {
+        if (setup) setup();
+
+        const auto start{ chrono::steady_clock::now() };
+        body();
+        milliseconds.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+
+    sort(milliseconds.begin(), milliseconds.end());
+    m_results.push_back({ name, variant, threadCount, m_repetitions, items,
+        milliseconds.front(), milliseconds[milliseconds.size() / 2], milliseconds.back() });
+}
+
+
+/// <summary>
+/// Writes every result recorded so far.
+/// </summary>
+/// <param name="output">stream to write the report to</param>
+/// <param name="format">format of the report</param>
+void BenchmarkRunner::writeReport(ostream& output, ReportFormat format) const
+{
+    const auto flags{ output.flags() };
+    const auto precision{ output.precision() };
+    output << fixed << setprecision(3);
+
+    switch (format)
+    {
+    case ReportFormat::TEXT:    writeText(output); break;
+    case ReportFormat::CSV:     writeCsv(output); break;
+    case ReportFormat::JSON:    writeJson(output); break;
+    }
+
+    output.flags(flags);
+    output.precision(precision);
+}
+
+
+/// <summary>
+/// Writes the results as a table, one line per case.
+/// </summary>
+/// <param name="output">stream to write to</param>
+void BenchmarkRunner::writeText(ostream& output) const
+{
+    output << left << setw(20) << "benchmark" << setw(18) << "variant" << right << setw(8) << "threads"
+        << setw(12) << "min ms" << setw(12) << "median ms" << setw(12) << "max ms" << setw(16) << "items/s" << "\n";
+
+    for (const auto& result : m_results)
+    {
+        output << left << setw(20) << result.m_name << setw(18) << result.m_variant << right << setw(8) << result.m_threadCount
+            << setw(12) << result.m_minMilliseconds << setw(12) << result.m_medianMilliseconds << setw(12) << result.m_maxMilliseconds
+            << setw(16) << setprecision(0) << result.itemsPerSecond() << setprecision(3) << "\n";
+    }
+}
+
+
+/// <summary>
+/// Writes the results as CSV with a header line. Names and variants never
+/// contain commas or quotes, so nothing is quoted.
+/// </summary>
+/// <param name="output">stream to write to</param>
+void BenchmarkRunner::writeCsv(ostream& output) const
+{
+    output << "benchmark,variant,threads,repetitions,items,min_ms,median_ms,max_ms,items_per_second\n";
+    for (const auto& result : m_results)
+    {
+        output << result.m_name << "," << result.m_variant << "," << result.m_threadCount << ","
+            << result.m_repetitions << "," << result.m_items << "," << result.m_minMilliseconds << ","
+            << result.m_medianMilliseconds << "," << result.m_maxMilliseconds << "," << result.itemsPerSecond() << "\n";
+    }
+}
+
+
+/// <summary>
+/// Writes the results as a JSON object, along with the core count of the machine
+/// so results from different machines can be told apart.
+/// </summary>
+/// <param name="output">stream to write to</param>
+void BenchmarkRunner::writeJson(ostream& output) const
+{
+    output << "{\n  \"hardware_concurrency\": " << thread::hardware_concurrency() << ",\n  \"results\": [";
+    for (size_t i = 0; i < m_results.size(); i++)
+    {
+        const auto& result{ m_results[i] };
+        output << ((i == 0) ? "\n" : ",\n")
+            << "    { \"benchmark\": \"" << result.m_name << "\", \"variant\": \"" << result.m_variant
+            << "\", \"threads\": " << result.m_threadCount << ", \"repetitions\": " << result.m_repetitions
+            << ", \"items\": " << result.m_items << ", \"min_ms\": " << result.m_minMilliseconds
+            << ", \"median_ms\": " << result.m_medianMilliseconds << ", \"max_ms\": " << result.m_maxMilliseconds
+            << ", \"items_per_second\": " << result.itemsPerSecond() << " }";
+    }
+    output << "\n  ]\n}\n";
+}
@@ -0,0 +1,383 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "BoggleBoard.h"
+#include "BoggleSolver.h"
+#include "Dictionary.h"
+#include "PuzzleGenerator.h"
+#include "ThreadPool.h"
+#include "ThreadTuner.h"
+
+
+using namespace std;
+
+
+constexpr size_t DEFAULT_REPETITIONS{ 5 };
+constexpr size_t THREAD_POOL_TASKS{ 100000 };
+constexpr uint32_t DEFAULT_SEED{ 2025 };
+constexpr size_t MAX_BOARD_TRIE_CELLS{ 36 };    // solve_board only compares the board trie up to 6x6
+constexpr size_t ENGINE_BOARD_SIZE{ 200 };      // solve_engine board rows and columns
+
+
+/// <summary>
+/// Reads the words of a dictionary file that are long enough to be imported.
+/// </summary>
+/// <param name="filepath">dictionary file</param>
+/// <param name="words">receives the words in file order</param>
+/// <returns>false if the file can't be opened</returns>
+static bool readWords(const string& filepath, vector<string>& words)
+{
+    ifstream file(filepath);
+    if (!file) return false;
+
+    string word{};
+    while (file >> word)
+    {
+        if (word.size() >= 3) words.push_back(word);
+    }
+    return true;
+}
+
+
+/// <summary>
+/// Parses a comma separated list of counts, e.g. "1,2,4".
+/// </summary>
+/// <param name="list">text to parse</param>
+/// <param name="counts">receives the counts</param>
+/// <returns>false if any entry isn't a count of at least 1</returns>
+static bool parseCounts(const string& list, vector<size_t>& counts)
+{
+    counts.clear();
+
+    stringstream entries(list);
+    string entry{};
+    while (getline(entries, entry, ','))
+    {
+        if (entry.empty() || (entry.size() > 7) || (entry.find_first_not_of("0123456789") != string::npos)) return false;
+
+        const auto count{ stoul(entry) };
+        if (count == 0) return false;
+        counts.push_back(count);
+    }
+    return !counts.empty();
+}
+
+
+/// <summary>
+/// Builds a frozen dictionary from a list of words.
+/// </summary>
+/// <param name="words">words to insert</param>
+/// <returns>frozen dictionary, nullptr if it couldn't be built</returns>
+static shared_ptr<const Dictionary> buildDictionary(const vector<string>& words)
+{
+    auto dictionary{ make_shared<Dictionary>() };
+    for (const auto& word : words)
+    {
+        if (dictionary->insertWord(word) != ErrorCode::SUCCESS) return nullptr;
+    }
+    if (dictionary->freeze() != ErrorCode::SUCCESS) return nullptr;
+    return dictionary;
+}
+
+
+int main(const int argc, const char* const argv[])
+{
+    // PROCESS CLI ARGS --------------------------------------------------------
+    ReportFormat format{ ReportFormat::TEXT };          // --format text|csv|json
+    string outputPath{};                                // --output <file> : report file instead of stdout
+    size_t repetitions{ DEFAULT_REPETITIONS };          // --repetitions <count> : timed runs per case
+    string filter{};                                    // --filter <name> : only run matching benchmarks
+    vector<size_t> threadCounts{ ThreadTuner::threadCandidates(thread::hardware_concurrency()) }; // --threads <n,n,...>
+    string dictionaryPath{ "supplementary/dictionary.txt" };    // --dictionary <file>
+    string stressBoardPath{ "supplementary/stress_test.txt" };  // --stress-board <file>
+    uint32_t seed{ DEFAULT_SEED };                      // --seed <number> : seed of the generated boards and dictionaries
+    vector<size_t> boardSizes{ 4, 8, 16, 32, 64, 128 };             // --board-sizes <n,n,...> : rows and columns of the scaling boards
+    vector<size_t> dictionarySizes{ 10000, 30000, 100000 };         // --dictionary-sizes <n,n,...> : words of the scaling dictionaries
+    string emitDirectory{};                             // --emit <directory> : write the generated puzzles to files
+    bool badArgs{ false };
+    for (int i = 1; i < argc; i++)
+    {
+        const string arg{ argv[i] };
+        const string value{ (i + 1 < argc) ? argv[i + 1] : "" };
+        const bool isCount{ !value.empty() && (value.size() < 10) && (value.find_first_not_of("0123456789") == string::npos) };
+
+        if ((arg == "--format") && (value == "text")) format = ReportFormat::TEXT;
+        else if ((arg == "--format") && (value == "csv")) format = ReportFormat::CSV;
+        else if ((arg == "--format") && (value == "json")) format = ReportFormat::JSON;
+        else if ((arg == "--output") && !value.empty()) outputPath = value;
+        else if ((arg == "--repetitions") && isCount) repetitions = stoul(value);
+        else if ((arg == "--filter") && !value.empty()) filter = value;
+        else if ((arg == "--threads") && parseCounts(value, threadCounts)) {}
+        else if ((arg == "--dictionary") && !value.empty()) dictionaryPath = value;
+        else if ((arg == "--stress-board") && !value.empty()) stressBoardPath = value;
+        else if ((arg == "--seed") && isCount) seed = static_cast<uint32_t>(stoul(value));
+        else if ((arg == "--board-sizes") && parseCounts(value, boardSizes)) {}
+        else if ((arg == "--dictionary-sizes") && parseCounts(value, dictionarySizes)) {}
+        else if ((arg == "--emit") && !value.empty()) emitDirectory = value;
+        else
+        {
+            badArgs = true;
+            break;
+        }
+        i++; // every option takes a value
+    }
+
+    vector<string> words{};
+    if (!badArgs && !readWords(dictionaryPath, words))
+    {
+        cerr << "Error finding file at path: " << dictionaryPath << ".\n";
+        badArgs = true;
+    }
+
+    if (badArgs)
+    {
+        cerr << "Usage: MaddieBoggle-Benchmark [--format text|csv|json] [--output <file>] [--repetitions <count>] [--filter <benchmark>]\n"
+            << "       [--threads <count,count,...>] [--dictionary <dictionary_filename>] [--stress-board <board_filename>] [--seed <number>]\n"
+            << "       [--board-sizes <size,size,...>] [--dictionary-sizes <words,words,...>] [--emit <directory>]" << endl;
+        return -1;
+    }
+
+    BenchmarkRunner runner(repetitions, filter);
+    cerr << "Benchmarking with " << words.size() << " words from " << dictionaryPath << "\n";
+
+    // DICTIONARY IMPORT -------------------------------------------------------
+    {
+        unique_ptr<Dictionary> dictionary{};
+        const auto freshDictionary{ [&dictionary]() { dictionary = make_unique<Dictionary>(); } };
+
+        runner.run("dictionary_import", "serial", 1, words.size(),
+            [&]() { dictionary->importDictionary(dictionaryPath); }, freshDictionary);
+        runner.run("dictionary_import", "dawg", 1, words.size(),
+            [&]() { dictionary->importMinimizedDictionary(dictionaryPath); }, freshDictionary);
+
+        for (const auto threadCount : threadCounts)
+        {
+            if (!runner.isSelected("dictionary_import")) break;
+
+            ThreadPool pool(threadCount);
+            runner.run("dictionary_import", "parallel", threadCount, words.size(),
+                [&]() { dictionary->importDictionary(dictionaryPath, pool); }, freshDictionary);
+        }
+    }
+
+    // FROZEN DICTIONARY, SHARED BY THE BENCHMARKS BELOW ----------------------------
+    auto dictionary{ make_shared<Dictionary>() };
+    if ((dictionary->importDictionary(dictionaryPath) != ErrorCode::SUCCESS) || (dictionary->freeze() != ErrorCode::SUCCESS))
+    {
+        cerr << "Unable to build the dictionary from: " << dictionaryPath << "\n";
+        return -1;
+    }
+    shared_ptr<const Dictionary> frozenDictionary{ dictionary };
+
+    // DICTIONARY SEARCH -------------------------------------------------------
+    {
+        atomic<size_t> found{ 0 };  // keeps the lookups from being optimized away
+        runner.run("search_dictionary", "word", 1, words.size(), [&]() {
+            for (const auto& word : words) found += frozenDictionary->searchDictionary(word, SearchType::WORD) ? 1 : 0;
+        });
+        runner.run("search_dictionary", "path", 1, words.size(), [&]() {
+            for (const auto& word : words) found += frozenDictionary->searchDictionary(word.substr(0, word.size() - 1), SearchType::PATH) ? 1 : 0;
+        });
+    }
+
+    // BOARD SOLVING -----------------------------------------------------------
+    if (runner.isSelected("solve_board"))
+    {
+        PuzzleGenerator generator(seed);
+        vector<pair<string, BoggleBoard>> boards{};
+        boards.push_back({ "4x4", generator.generateBoard(4, 4) });
+        boards.push_back({ "5x5", generator.generateBoard(5, 5) });
+
+        BoggleBoard stressBoard{};
+        if (importBoard(stressBoardPath, stressBoard) == ErrorCode::SUCCESS)
+        {
+            boards.push_back({ "stress_test", stressBoard });
+        }
+
+        boards.push_back({ "50x50", generator.generateBoard(50, 50) });
+        boards.push_back({ "100x100", generator.generateBoard(100, 100) });
+        boards.push_back({ "ragged_50", generator.generateRaggedBoard(50, 25, 75) });
+
+        for (const auto threadCount : threadCounts)
+        {
+            auto pool{ make_shared<ThreadPool>(threadCount) };
+            for (const auto& [variant, board] : boards)
+            {
+                const auto cells{ board.empty() ? size_t{ 0 } : board.size() * board[0].size() };
+                runner.run("solve_board", variant, threadCount, cells, [&]() {
+                    BoggleSolver solver(frozenDictionary, pool, board);
+                    solver.solveBoard();
+                    solver.waitForSolve();
+                    solver.answerCount(); // the answers are merged on first read, which is part of the solve
+                });
+
+                // the board trie only has a chance on small boards, see BoardTrie.h
+                if (cells > MAX_BOARD_TRIE_CELLS) continue;
+                runner.run("solve_board", variant + "/board_trie", threadCount, cells, [&]() {
+                    BoggleSolver solver(frozenDictionary, pool, board, BoggleSolver::MAX_SPLIT_DEPTH, {}, true);
+                    solver.solveBoard();
+                    solver.waitForSolve();
+                    solver.answerCount();
+                });
+            }
+        }
+    }
+
+    // SOLVE TIME VERSUS BOARD AND DICTIONARY SIZE -------------------------------
+    /* Every board size with every synthetic dictionary size, on the biggest thread
+    count. Each puzzle comes from its own seed, so adding a size to the lists
+    doesn't change the puzzles of the others. */
+    if (runner.isSelected("solve_scaling") || !emitDirectory.empty())
+    {
+        const auto threadCount{ threadCounts.back() };
+        auto pool{ make_shared<ThreadPool>(threadCount) };
+
+        for (const auto dictionarySize : dictionarySizes)
+        {
+            PuzzleGenerator dictionaryGenerator(seed + static_cast<uint32_t>(dictionarySize));
+            const auto syntheticWords{ dictionaryGenerator.generateWords(dictionarySize) };
+            const auto dictionaryName{ to_string(dictionarySize) + "w" };
+            if (!emitDirectory.empty())
+            {
+                PuzzleGenerator::writeWords(syntheticWords, emitDirectory + "/dictionary_" + dictionaryName + ".txt");
+            }
+
+            const auto syntheticDictionary{ buildDictionary(syntheticWords) };
+            if (!syntheticDictionary)
+            {
+                cerr << "Unable to build the synthetic dictionary of " << dictionarySize << " words\n";
+                return -1;
+            }
+
+            for (const auto boardSize : boardSizes)
+            {
+                PuzzleGenerator boardGenerator(seed + static_cast<uint32_t>(boardSize));
+                const auto board{ boardGenerator.generateBoard(boardSize, boardSize) };
+                const auto boardName{ to_string(boardSize) + "x" + to_string(boardSize) };
+                if (!emitDirectory.empty())
+                {
+                    PuzzleGenerator::writeBoard(board, emitDirectory + "/board_" + boardName + ".txt");
+                }
+
+                runner.run("solve_scaling", boardName + "/" + dictionaryName, threadCount, boardSize * boardSize, [&]() {
+                    BoggleSolver solver(syntheticDictionary, pool, board);
+                    solver.solveBoard();
+                    solver.waitForSolve();
+                    solver.answerCount();
+                });
+            }
+        }
+    }
+
+    // SEARCH ENGINES ----------------------------------------------------------
+    /* Both engines of BoggleSolver on a huge board with short word lists, on the
+    biggest thread count. The engine AUTO picks switches somewhere in between. */
+    if (runner.isSelected("solve_engine"))
+    {
+        const auto threadCount{ threadCounts.back() };
+        auto pool{ make_shared<ThreadPool>(threadCount) };
+        PuzzleGenerator boardGenerator(seed);
+        const auto board{ boardGenerator.generateBoard(ENGINE_BOARD_SIZE, ENGINE_BOARD_SIZE) };
+        const auto boardName{ to_string(ENGINE_BOARD_SIZE) + "x" + to_string(ENGINE_BOARD_SIZE) };
+
+        for (const size_t wordCount : { 100, 1000, 10000 })
+        {
+            PuzzleGenerator dictionaryGenerator(seed + static_cast<uint32_t>(wordCount));
+            const auto shortDictionary{ buildDictionary(dictionaryGenerator.generateWords(wordCount)) };
+            if (!shortDictionary)
+            {
+                cerr << "Unable to build the synthetic dictionary of " << wordCount << " words\n";
+                return -1;
+            }
+
+            for (const auto engine : { SearchEngine::BOARD, SearchEngine::DICTIONARY })
+            {
+                const string engineName{ (engine == SearchEngine::BOARD) ? "board" : "dictionary" };
+                runner.run("solve_engine", boardName + "/" + to_string(wordCount) + "w/" + engineName, threadCount, ENGINE_BOARD_SIZE * ENGINE_BOARD_SIZE, [&]() {
+                    BoggleSolver solver(shortDictionary, pool, board, BoggleSolver::MAX_SPLIT_DEPTH, {}, false, engine);
+                    solver.solveBoard();
+                    solver.waitForSolve();
+                    solver.answerCount();
+                });
+            }
+        }
+    }
+
+    // ANSWER EXPORT -----------------------------------------------------------
+    /* Writing the answers of one big board in every format, and through an
+    ofstream one line at a time as it was before AnswerWriter. */
+    if (runner.isSelected("export_answers"))
+    {
+        auto pool{ make_shared<ThreadPool>(threadCounts.back()) };
+        PuzzleGenerator generator(seed);
+        const auto board{ generator.generateBoard(100, 100) };
+        BoggleSolver solver(frozenDictionary, pool, board);
+        solver.solveBoard();
+        solver.waitForSolve();
+
+        const string exportPath{ "export_answers.tmp" };
+        const auto answerCount{ solver.answerCount() };
+        runner.run("export_answers", "ofstream", 1, answerCount, [&]() {
+            ofstream output(exportPath);
+            solver.writeAnswers(output);
+        });
+
+        const vector<pair<string, AnswerFormat>> formats{ { "text", AnswerFormat::TEXT }, { "json", AnswerFormat::JSON },
+            { "ids", AnswerFormat::WORD_IDS }, { "front_coded", AnswerFormat::FRONT_CODED } };
+        for (const auto& [variant, answerFormat] : formats)
+        {
+            runner.run("export_answers", variant, 1, answerCount, [&]() { solver.exportAnswers(exportPath, answerFormat); });
+        }
+        remove(exportPath.c_str());
+    }
+
+    // THREAD POOL THROUGHPUT --------------------------------------------------
+    if (runner.isSelected("thread_pool"))
+    {
+        for (const auto threadCount : threadCounts)
+        {
+            for (const auto scheduling : { TaskScheduling::SHARED_QUEUE, TaskScheduling::WORK_STEALING })
+            {
+                ThreadPool pool(threadCount, scheduling);
+                atomic<size_t> tasksRun{ 0 };
+                const string variant{ (scheduling == TaskScheduling::SHARED_QUEUE) ? "shared_queue" : "work_stealing" };
+
+                runner.run("thread_pool", variant, threadCount, THREAD_POOL_TASKS, [&]() {
+                    for (size_t i = 0; i < THREAD_POOL_TASKS; i++)
+                    {
+                        pool.queueTask([&tasksRun]() { tasksRun++; });
+                    }
+                    pool.waitForCompletion();
+                });
+            }
+        }
+    }
+
+    // REPORT ------------------------------------------------------------------
+    if (outputPath.empty())
+    {
+        runner.writeReport(cout, format);
+        return 0;
+    }
+
+    ofstream output(outputPath);
+    if (!output)
+    {
+        cerr << "Unable to write report to: " << outputPath << "\n";
+        return static_cast<int>(ErrorCode::FILE_NOT_FOUND);
+    }
+    runner.writeReport(output, format);
+    return 0;
+}
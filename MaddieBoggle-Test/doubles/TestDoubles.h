@@ -7,13 +7,14 @@
 class LetterNodePool_Double : public LetterNodePool
 {
 public:
-	LetterNodePool_Double(size_t poolSize) :
-		LetterNodePool(poolSize)
+	LetterNodePool_Double(size_t nodeLimit = NO_NODE_LIMIT) :
+		LetterNodePool(nodeLimit)
 	{
 
 	}
 
-	size_t getPoolSize() { return m_pool.size(); }
+	size_t getChunkCount() { return m_chunks.size(); }
+	size_t getNodesCreated() { return m_nodesCreated; }
 	size_t getFreeNodesLeft() { return m_freeNodes.size(); }
 };
 
@@ -32,19 +33,39 @@ public:
 };
 
 
+// Frozen dictionary of "pen", "peg" and "ten", shared the way solvers take it.
+inline shared_ptr<const Dictionary> makeSharedDictionary()
+{
+	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->insertWord("pen");
+	dictionary->insertWord("peg");
+	dictionary->insertWord("ten");
+	dictionary->freeze();
+	return shared_ptr<const Dictionary>(move(dictionary));
+}
+
+
 class BoggleSolver_Double : public BoggleSolver
 {
 public:
 	BoggleSolver_Double(
 		shared_ptr<const Dictionary> dictionary,
 		shared_ptr<ThreadPool> threadPool,
-		const BoggleBoard& board
-	) : BoggleSolver(dictionary, threadPool, board)
+		const BoggleBoard& board,
+		WordLengthRange lengths = {}
+	) : BoggleSolver(dictionary, threadPool, board, MAX_SPLIT_DEPTH, lengths)
 	{
 
 	}
 
 	set<string>* getAnswers() { return &m_answers; }
-	void findWordsPassThrough(size_t row, size_t col) { findWordsAtIndex(row, col); }
+	void findWordsPassThrough(size_t row, size_t col) { findWordsAtIndex(row, col); mergeAnswers(); }
+	void findWordsFromPathPassThrough(const vector<uint32_t>& cells)
+	{
+		SearchPath path{ {}, cells.size(), false };
+		copy(cells.begin(), cells.end(), path.m_cells);
+		findWordsFromPath(path);
+		mergeAnswers();
+	}
 };
 
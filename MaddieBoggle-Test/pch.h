@@ -6,11 +6,24 @@
 
 #include "gtest/gtest.h"
 
+#include "AnswerWriter.h"
+#include "BatchSolver.h"
+#include "BoardGraph.h"
+#include "BoardTrie.h"
 #include "BoggleBoard.h"
+#include "BoggleServer.h"
 #include "BoggleSolver.h"
 #include "BoggleSolverHelper.h"
+#include "ChildArena.h"
+#include "CompiledTrie.h"
+#include "DawgBuilder.h"
+#include "DictionaryImage.h"
 #include "ErrorCodes.h"
 #include "LetterNode.h"
 #include "LetterNodePool.h"
 #include "Dictionary.h"
+#include "PuzzleGenerator.h"
+#include "StatsReport.h"
 #include "ThreadPool.h"
+#include "ThreadTuner.h"
+#include "WordScanner.h"
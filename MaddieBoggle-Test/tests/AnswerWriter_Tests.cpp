@@ -0,0 +1,219 @@
+#include "pch.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+
+static string readFile(const string& filepath)
+{
+	ifstream file(filepath, ios::binary);
+	return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+
+// Reads an unsigned LEB128 varint starting at position, moving position past it.
+static uint64_t readVarint(const string& bytes, size_t& position)
+{
+	uint64_t value{ 0 };
+	for (uint32_t shift = 0; position < bytes.size(); shift += 7)
+	{
+		const auto byte{ static_cast<unsigned char>(bytes[position++]) };
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) break;
+	}
+	return value;
+}
+
+
+TEST(AnswerWriter_Tests, TextAndJsonHaveEveryAnswerInOrder)
+{
+	// Arrange
+	const set<string> answers{ "bats", "bat", "bath" };
+	const CompiledTrie noDictionary{};	// only word ids need one
+	AnswerWriter text(AnswerFormat::TEXT);
+	AnswerWriter json(AnswerFormat::JSON);
+	ASSERT_EQ(ErrorCode::SUCCESS, text.open("AnswerWriter_Tests.txt"));
+	ASSERT_EQ(ErrorCode::SUCCESS, json.open("AnswerWriter_Tests.json"));
+
+	// Act
+	auto textStatus = text.write(answers, noDictionary);
+	auto jsonStatus = json.write(answers, noDictionary);
+	text.close();
+	json.close();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, textStatus);
+	EXPECT_EQ(ErrorCode::SUCCESS, jsonStatus);
+	EXPECT_EQ("bat\nbath\nbats\n", readFile("AnswerWriter_Tests.txt"));
+	EXPECT_EQ("{ \"count\": 3, \"answers\": [ \"bat\", \"bath\", \"bats\" ] }\n", readFile("AnswerWriter_Tests.json"));
+
+	remove("AnswerWriter_Tests.txt");
+	remove("AnswerWriter_Tests.json");
+}
+
+
+TEST(AnswerWriter_Tests, FrontCodedAnswersDecodeBack)
+{
+	// Arrange
+	const set<string> answers{ "bat", "bath", "bats", "cat", "catalog" };
+	AnswerWriter writer(AnswerFormat::FRONT_CODED);
+	ASSERT_EQ(ErrorCode::SUCCESS, writer.open("AnswerWriter_Tests_front.bin"));
+
+	// Act
+	auto status = writer.write(answers, CompiledTrie());
+	writer.close();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	const auto bytes{ readFile("AnswerWriter_Tests_front.bin") };
+	ASSERT_EQ("MBFC", bytes.substr(0, 4));
+	size_t position{ 4 };
+	ASSERT_EQ(answers.size(), readVarint(bytes, position));
+
+	vector<string> decoded{};
+	string previous{};
+	for (size_t i = 0; i < answers.size(); i++)
+	{
+		const auto shared{ readVarint(bytes, position) };
+		const auto length{ readVarint(bytes, position) };
+		previous = previous.substr(0, shared) + bytes.substr(position, length);
+		position += length;
+		decoded.push_back(previous);
+	}
+	EXPECT_EQ(vector<string>(answers.begin(), answers.end()), decoded);
+	EXPECT_EQ(bytes.size(), position);
+	EXPECT_EQ(4 + 1 + (2 + 3) + (2 + 1) + (2 + 1) + (2 + 3) + (2 + 4), bytes.size());	// "catalog" shares "cat"
+
+	remove("AnswerWriter_Tests_front.bin");
+}
+
+
+TEST(AnswerWriter_Tests, WordIdsAreTheDictionaryIds)
+{
+	// Arrange
+	Dictionary dictionary(1000);
+	for (const auto word : { "ant", "bat", "bath", "bats", "cat", "quit" }) dictionary.insertWord(word);
+	ASSERT_EQ(ErrorCode::SUCCESS, dictionary.freeze(DictionaryLayout::RADIX));
+	const set<string> answers{ "bath", "ant", "quit", "bats" };
+	AnswerWriter writer(AnswerFormat::WORD_IDS);
+	ASSERT_EQ(ErrorCode::SUCCESS, writer.open("AnswerWriter_Tests_ids.bin"));
+
+	// Act
+	auto status = writer.write(answers, dictionary.getCompiledTrie());
+	writer.close();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	const auto bytes{ readFile("AnswerWriter_Tests_ids.bin") };
+	ASSERT_EQ("MBID", bytes.substr(0, 4));
+	size_t position{ 4 };
+	ASSERT_EQ(answers.size(), readVarint(bytes, position));
+
+	vector<string> decoded{};
+	uint64_t wordId{ 0 };
+	for (size_t i = 0; i < answers.size(); i++)
+	{
+		wordId += readVarint(bytes, position);
+		decoded.push_back(dictionary.wordFromId(static_cast<uint32_t>(wordId)));
+	}
+	EXPECT_EQ(vector<string>(answers.begin(), answers.end()), decoded);
+	EXPECT_EQ(bytes.size(), position);
+
+	remove("AnswerWriter_Tests_ids.bin");
+}
+
+
+TEST(AnswerWriter_Tests, AnswersBiggerThanTheBufferAreAllWritten)
+{
+	// Arrange
+	set<string> answers{};
+	string expected{};
+	for (size_t i = 0; answers.size() * 8 < 3 * AnswerWriter::BUFFER_SIZE; i++)
+	{
+		string word{ "aaaaaaa" };
+		for (auto value = i, position = word.size(); (value > 0) && (position > 0); value /= 26, position--)
+		{
+			word[position - 1] = static_cast<char>('a' + value % 26);
+		}
+		answers.insert(word);
+		expected += word + "\n";
+	}
+	AnswerWriter writer(AnswerFormat::TEXT);
+	ASSERT_EQ(ErrorCode::SUCCESS, writer.open("AnswerWriter_Tests_big.txt"));
+
+	// Act
+	auto status = writer.write(answers, CompiledTrie());
+	auto closeStatus = writer.close();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	EXPECT_EQ(ErrorCode::SUCCESS, closeStatus);
+	EXPECT_EQ(expected, readFile("AnswerWriter_Tests_big.txt"));
+
+	remove("AnswerWriter_Tests_big.txt");
+}
+
+
+TEST(AnswerWriter_Tests, AttachedDescriptorIsLeftOpen)
+{
+	// Arrange
+	auto file = fopen("AnswerWriter_Tests_attached.txt", "wb");
+	ASSERT_NE(nullptr, file);
+	AnswerWriter writer(AnswerFormat::TEXT);
+
+	// Act
+#ifdef _WIN32
+	writer.attach(_fileno(file));
+#else
+	writer.attach(fileno(file));
+#endif
+	auto status = writer.write({ "bee" }, CompiledTrie());
+	auto closeStatus = writer.close();
+	fputs("end\n", file);
+	auto fileClosed = fclose(file);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	EXPECT_EQ(ErrorCode::SUCCESS, closeStatus);
+	EXPECT_EQ(0, fileClosed);
+	EXPECT_EQ("bee\nend\n", readFile("AnswerWriter_Tests_attached.txt"));
+
+	remove("AnswerWriter_Tests_attached.txt");
+}
+
+
+TEST(AnswerWriter_Tests, WritingWithNothingOpenFails)
+{
+	// Arrange
+	AnswerWriter writer(AnswerFormat::JSON);
+	AnswerFormat format{ AnswerFormat::TEXT };
+
+	// Act
+	auto status = writer.write({ "bee" }, CompiledTrie());
+	auto openStatus = writer.open("this/path/should/not/exist.txt");
+	auto parsed = AnswerWriter::parseFormat("front-coded", format);
+	auto parsedBad = AnswerWriter::parseFormat("xml", format);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::UNKNOWN_FILE_ERR, status);
+	EXPECT_EQ(ErrorCode::UNKNOWN_FILE_ERR, openStatus);
+	EXPECT_TRUE(parsed);
+	EXPECT_FALSE(parsedBad);
+	EXPECT_EQ(AnswerFormat::FRONT_CODED, format);
+}
+
+
+/*
+TEST(AnswerWriter_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
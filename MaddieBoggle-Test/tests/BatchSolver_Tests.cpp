@@ -0,0 +1,193 @@
+#include "pch.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "TestDoubles.h"
+
+
+static vector<string> readLines(const string& filepath)
+{
+	vector<string> lines{};
+	ifstream file(filepath);
+	string line{};
+	while (getline(file, line)) lines.push_back(line);
+	return lines;
+}
+
+
+TEST(BatchSolver_Tests, EveryBoardGetsItsOwnAnswerFile)
+{
+	// Arrange
+	{ ofstream("BatchSolver_Tests_a.txt") << "pe\ngn\n"; }
+	{ ofstream("BatchSolver_Tests_b.txt") << "te\nxn\n"; }
+	auto pool = make_shared<ThreadPool>(2);
+	BatchSolver batch(makeSharedDictionary(), pool);
+	batch.addBoard("BatchSolver_Tests_a.txt", "BatchSolver_Tests_a_answers.txt");
+	batch.addBoard("BatchSolver_Tests_b.txt", "BatchSolver_Tests_b_answers.txt");
+	ostringstream log;
+
+	// Act
+	auto status = batch.solveAll(log);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	ASSERT_EQ(2, batch.getResults().size());
+	EXPECT_EQ(2, batch.getResults()[0].m_wordCount);
+	EXPECT_EQ(1, batch.getResults()[1].m_wordCount);
+	EXPECT_EQ(vector<string>({ "peg", "pen" }), readLines("BatchSolver_Tests_a_answers.txt"));
+	EXPECT_EQ(vector<string>({ "ten" }), readLines("BatchSolver_Tests_b_answers.txt"));
+	EXPECT_NE(string::npos, log.str().find("Batch: 2 boards (0 failed), 3 words"));
+	EXPECT_FALSE(log.flags() & ios::fixed);	// the caller's format is left as it was
+
+	remove("BatchSolver_Tests_a.txt");
+	remove("BatchSolver_Tests_b.txt");
+	remove("BatchSolver_Tests_a_answers.txt");
+	remove("BatchSolver_Tests_b_answers.txt");
+}
+
+
+TEST(BatchSolver_Tests, MissingBoardDoesNotStopTheBatch)
+{
+	// Arrange
+	{ ofstream("BatchSolver_Tests_c.txt") << "te\nxn\n"; }
+	auto pool = make_shared<ThreadPool>(1);
+	BatchSolver batch(makeSharedDictionary(), pool);
+	batch.addBoard("this/path/should/not/exist.txt", "BatchSolver_Tests_missing_answers.txt");
+	batch.addBoard("BatchSolver_Tests_c.txt", "BatchSolver_Tests_c_answers.txt");
+	ostringstream log;
+
+	// Act
+	auto status = batch.solveAll(log);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::FILE_NOT_FOUND, status);
+	ASSERT_EQ(2, batch.getResults().size());
+	EXPECT_EQ(ErrorCode::FILE_NOT_FOUND, batch.getResults()[0].m_errorCode);
+	EXPECT_EQ(ErrorCode::SUCCESS, batch.getResults()[1].m_errorCode);
+	EXPECT_EQ(vector<string>({ "ten" }), readLines("BatchSolver_Tests_c_answers.txt"));
+
+	remove("BatchSolver_Tests_c.txt");
+	remove("BatchSolver_Tests_c_answers.txt");
+}
+
+
+TEST(BatchSolver_Tests, FailedSolveIsReportedForItsBoard)
+{
+	// Arrange
+	{ ofstream("BatchSolver_Tests_f.txt") << "pe\ngn\n"; }
+	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->insertWord("pen");	// never frozen
+	auto pool = make_shared<ThreadPool>(1);
+	BatchSolver batch(shared_ptr<const Dictionary>(move(dictionary)), pool);
+	batch.addBoard("BatchSolver_Tests_f.txt", "BatchSolver_Tests_f_answers.txt");
+	ostringstream log;
+
+	// Act
+	auto status = batch.solveAll(log);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::DICTIONARY_NOT_FROZEN, status);
+	ASSERT_EQ(1, batch.getResults().size());
+	EXPECT_EQ(ErrorCode::DICTIONARY_NOT_FROZEN, batch.getResults()[0].m_errorCode);
+	EXPECT_NE(string::npos, log.str().find("Batch: 1 boards (1 failed)"));
+
+	remove("BatchSolver_Tests_f.txt");
+	remove("BatchSolver_Tests_f_answers.txt");
+}
+
+
+TEST(BatchSolver_Tests, ManifestListsBoardsInOrder)
+{
+	// Arrange
+	{ ofstream("BatchSolver_Tests_manifest.txt") << "# nightly boards\nBatchSolver_Tests_d.txt\n\nBatchSolver_Tests_e.txt\r\n"; }
+	auto pool = make_shared<ThreadPool>(1);
+	BatchSolver batch(makeSharedDictionary(), pool);
+
+	// Act
+	auto status = batch.collectBoards("BatchSolver_Tests_manifest.txt", ".");
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	ASSERT_EQ(2, batch.getEntries().size());
+	EXPECT_EQ("BatchSolver_Tests_d.txt", batch.getEntries()[0].m_boardPath);
+	EXPECT_EQ("BatchSolver_Tests_e.txt", batch.getEntries()[1].m_boardPath);
+	EXPECT_NE(string::npos, batch.getEntries()[1].m_outputPath.find("BatchSolver_Tests_e_answers.txt"));
+
+	remove("BatchSolver_Tests_manifest.txt");
+}
+
+
+TEST(BatchSolver_Tests, AnswerFilesTakeTheExtensionOfTheirFormat)
+{
+	// Arrange
+	{ ofstream("BatchSolver_Tests_json_board.txt") << "pe\ngn\n"; }
+	{ ofstream("BatchSolver_Tests_json_manifest.txt") << "BatchSolver_Tests_json_board.txt\n"; }
+	auto pool = make_shared<ThreadPool>(2);
+	BatchSolver batch(makeSharedDictionary(), pool, BoggleSolver::MAX_SPLIT_DEPTH, {}, false, SearchEngine::AUTO, AnswerFormat::JSON);
+	ostringstream log;
+
+	// Act
+	auto listStatus = batch.collectBoards("BatchSolver_Tests_json_manifest.txt", "BatchSolver_Tests_json_out");
+	auto status = batch.solveAll(log);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, listStatus);
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	EXPECT_EQ(vector<string>({ "{ \"count\": 2, \"answers\": [ \"peg\", \"pen\" ] }" }),
+		readLines("BatchSolver_Tests_json_out/BatchSolver_Tests_json_board_answers.json"));
+
+	remove("BatchSolver_Tests_json_out/BatchSolver_Tests_json_board_answers.json");
+	remove("BatchSolver_Tests_json_out");
+	remove("BatchSolver_Tests_json_manifest.txt");
+	remove("BatchSolver_Tests_json_board.txt");
+}
+
+
+TEST(BatchSolver_Tests, BoardsWithTheSameNameAreRejected)
+{
+	// Arrange
+	{ ofstream("BatchSolver_Tests_same_manifest.txt") << "first/board.txt\nsecond/board.txt\n"; }
+	auto pool = make_shared<ThreadPool>(1);
+	BatchSolver batch(makeSharedDictionary(), pool);
+
+	// Act
+	auto status = batch.collectBoards("BatchSolver_Tests_same_manifest.txt", ".");
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::DUPLICATE_OUTPUT, status);
+	EXPECT_TRUE(batch.getEntries().empty());
+
+	remove("BatchSolver_Tests_same_manifest.txt");
+}
+
+
+TEST(BatchSolver_Tests, MissingBoardsPathHandledCorrectly)
+{
+	// Arrange
+	auto pool = make_shared<ThreadPool>(1);
+	BatchSolver batch(makeSharedDictionary(), pool);
+
+	// Act
+	auto status = batch.collectBoards("this/path/should/not/exist", "out");
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::FILE_NOT_FOUND, status);
+	EXPECT_TRUE(batch.getEntries().empty());
+}
+
+
+/*
+TEST(BatchSolver_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
@@ -0,0 +1,146 @@
+#include "pch.h"
+
+
+const vector<vector<char>> board{
+	{'p','w','y','r'}, /* 0  - 1  - 2  - 3   */
+	{'e','n','t','h'}, /* 4  - 5  - 6  - 7   */
+	{'g','s','i','q'}, /* 8  - 9  - 10 - 11  */
+	{'o','l','s','a'}  /* 12 - 13 - 14 - 15  */
+};
+
+const vector<vector<char>> asymBoard{
+	{'p','w','y','r','a'},		/* 0  - 1  - 2  - 3  - 4        */
+	{'e','n','t','h','e','m'},  /* 5  - 6  - 7  - 8  - 9  - 10  */
+	{'g','s','i','q'},			/* 11 - 12 - 13 - 14            */
+	{'o','l','s','a','m'}		/* 15 - 16 - 17 - 18 - 19       */
+};
+
+
+TEST(BoardGraph_Tests, CellsAreIndexedRowByRow)
+{
+	// Arrange Act
+	auto graph = BoardGraph(asymBoard);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(20, graph.cellCount());
+	EXPECT_EQ(10, graph.cellIndex(1, 5));
+	EXPECT_EQ(11, graph.cellIndex(2, 0));
+	EXPECT_EQ('m', graph.letter(graph.cellIndex(1, 5)));
+	EXPECT_EQ('q', graph.letter(graph.cellIndex(2, 3)));
+}
+
+
+TEST(BoardGraph_Tests, NeighboursAreInFixedDirectionOrder)
+{
+	// Arrange
+	auto graph = BoardGraph(board);
+
+	// Act
+	auto range = graph.neighbours(graph.cellIndex(1, 1));
+	vector<uint32_t> neighbours(range.begin(), range.end());
+
+	// Assert (expected, actual)
+	/* up, up_right, right, down_right, down, down_left, up_left, left */
+	vector<uint32_t> expected{ 1, 2, 6, 10, 9, 8, 0, 4 };
+	EXPECT_EQ(expected, neighbours);
+}
+
+
+TEST(BoardGraph_Tests, CornerNodeOnlyHasThreeNeighbours)
+{
+	// Arrange
+	auto graph = BoardGraph(board);
+
+	// Act
+	auto range = graph.neighbours(graph.cellIndex(0, 0));
+	vector<uint32_t> neighbours(range.begin(), range.end());
+
+	// Assert (expected, actual)
+	vector<uint32_t> expected{ 1, 5, 4 };
+	EXPECT_EQ(expected, neighbours);
+}
+
+
+TEST(BoardGraph_Tests, AsymBoardNeighboursRespectRowSizes)
+{
+	// Arrange
+	auto graph = BoardGraph(asymBoard);
+
+	// Act
+	auto range = graph.neighbours(graph.cellIndex(1, 5));
+	vector<uint32_t> neighbours(range.begin(), range.end());
+
+	// Assert (expected, actual)
+	/* only up_left (0,4) and left (1,4) exist for the last node of the long row */
+	vector<uint32_t> expected{ 4, 9 };
+	EXPECT_EQ(expected, neighbours);
+}
+
+
+TEST(BoardGraph_Tests, VisitedCellsTracksSetAndClearedCells)
+{
+	// Arrange
+	VisitedCells visited{};
+	visited.reset(130); // more than 2 words of bits
+
+	// Act
+	visited.set(0);
+	visited.set(64);
+	visited.set(129);
+	visited.clear(64);
+
+	// Assert (expected, actual)
+	EXPECT_TRUE(visited.test(0));
+	EXPECT_FALSE(visited.test(64));
+	EXPECT_TRUE(visited.test(129));
+	EXPECT_FALSE(visited.test(1));
+}
+
+
+TEST(BoardGraph_Tests, VisitedCellsResetClearsEveryCell)
+{
+	// Arrange
+	VisitedCells visited{};
+	visited.reset(16);
+	visited.set(3);
+
+	// Act
+	visited.reset(16);
+
+	// Assert (expected, actual)
+	EXPECT_FALSE(visited.test(3));
+}
+
+
+TEST(BoardGraph_Tests, CellsAreGroupedByLetter)
+{
+	// Arrange
+	auto graph = BoardGraph(board);
+
+	// Act
+	auto range = graph.cellsWithLetter('s');
+	vector<uint32_t> sCells(range.begin(), range.end());
+	auto zRange = graph.cellsWithLetter('z');
+	auto notALetter = graph.cellsWithLetter('#');
+
+	// Assert (expected, actual)
+	vector<uint32_t> expected{ 9, 14 };
+	EXPECT_EQ(expected, sCells);
+	EXPECT_EQ(zRange.begin(), zRange.end());
+	EXPECT_EQ(notALetter.begin(), notALetter.end());
+}
+
+
+/*
+TEST(BoardGraph_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
@@ -0,0 +1,142 @@
+#include "pch.h"
+
+#include <sstream>
+
+
+// Every word of a trie, in word id order.
+static vector<string> wordsOf(const CompiledTrie& trie)
+{
+	vector<string> words{};
+	for (uint32_t wordId = 0; wordId < trie.wordCount(); wordId++)
+	{
+		words.push_back(trie.wordAt(wordId));
+	}
+	return words;
+}
+
+
+TEST(BoardTrie_Tests, OnlyWordsTheBoardLettersAllowAreKept)
+{
+	// Arrange
+	const BoggleBoard board{
+		{'t','o'},
+		{'p','s'}
+	};
+	auto dictionary = Dictionary(1000);
+	for (const auto word : { "pot", "pots", "stop", "too", "tot", "zoo" })
+	{
+		dictionary.insertWord(word);
+	}
+	dictionary.freeze();
+	const BoardGraph graph(board);
+	CompiledTrie trie{};
+
+	// Act
+	BoardTrie::build(dictionary, graph, trie);
+
+	// Assert (expected, actual)
+	/* "too" and "tot" need a letter twice, "zoo" a letter the board doesn't have */
+	EXPECT_EQ(vector<string>({ "pot", "pots", "stop" }), wordsOf(trie));
+	EXPECT_EQ(CompiledTrie::NO_NODE, trie.findChild(CompiledTrie::ROOT, 'z'));
+}
+
+
+TEST(BoardTrie_Tests, LettersMustBeOnNeighbouringCells)
+{
+	// Arrange
+	const BoggleBoard board{
+		{'c','a','t','x'}
+	};
+	auto dictionary = Dictionary(1000);
+	dictionary.insertWord("cat");
+	dictionary.insertWord("act");
+	dictionary.insertWord("tax");
+	dictionary.freeze(DictionaryLayout::RADIX);
+	const BoardGraph graph(board);
+	CompiledTrie trie{};
+
+	// Act
+	BoardTrie::build(dictionary, graph, trie);
+
+	// Assert (expected, actual)
+	/* every letter is on the board, but 'c' is never next to 't' and 'a' never next to 'x' */
+	EXPECT_EQ(vector<string>({ "cat" }), wordsOf(trie));
+}
+
+
+TEST(BoardTrie_Tests, QCellSpellsQu)
+{
+	// Arrange
+	const BoggleBoard board{
+		{'q','i'},
+		{'t','e'}
+	};
+	auto dictionary = Dictionary(1000);
+	dictionary.insertWord("quit");
+	dictionary.insertWord("quite");
+	dictionary.insertWord("qat");
+	dictionary.insertWord("tui");
+	dictionary.freeze();
+	const BoardGraph graph(board);
+	CompiledTrie trie{};
+
+	// Act
+	BoardTrie::build(dictionary, graph, trie);
+
+	// Assert (expected, actual)
+	/* "qat" needs a 'q' without its 'u', "tui" a 'u' that doesn't follow the 'q' */
+	EXPECT_EQ(vector<string>({ "quit", "quite" }), wordsOf(trie));
+}
+
+
+TEST(BoardTrie_Tests, SolverAnswersTheSameWithAndWithoutIt)
+{
+	// Arrange
+	const BoggleBoard board{
+		{'p','w','y','r'},
+		{'e','n','t','h'},
+		{'g','s','i','q'},
+		{'o','l','s','a'}
+	};
+	auto dictionary = make_unique<Dictionary>(1000);
+	for (const auto word : { "pen", "peg", "pens", "slog", "tent", "pyre", "sis", "quit", "this", "pensive", "zebra" })
+	{
+		dictionary->insertWord(word);
+	}
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	auto pool = make_shared<ThreadPool>(2);
+	BoggleSolver full(safeDictionary, pool, board);
+	BoggleSolver pruned(safeDictionary, pool, board, BoggleSolver::MAX_SPLIT_DEPTH, {}, true);
+
+	// Act
+	full.solveBoard();
+	pruned.solveBoard();
+	full.waitForSolve();
+	pruned.waitForSolve();
+	ostringstream fullAnswers;
+	ostringstream prunedAnswers;
+	full.writeAnswers(fullAnswers);
+	pruned.writeAnswers(prunedAnswers);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(fullAnswers.str(), prunedAnswers.str());
+	EXPECT_EQ(safeDictionary->nodeCount(), full.searchTrieNodes());
+	EXPECT_GT(safeDictionary->nodeCount(), pruned.searchTrieNodes());
+	EXPECT_GT(full.getSearchStats().m_dictionaryLookups, pruned.getSearchStats().m_dictionaryLookups);
+}
+
+
+/*
+TEST(BoardTrie_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
@@ -1,6 +1,10 @@
 
 #include "pch.h"
 
+#include <cstdio>
+#include <fstream>
+
+
 TEST(BoggleBoard_Tests, MissingFileHandledCorrectly) 
 {
 	// Arrange
@@ -16,6 +20,48 @@ TEST(BoggleBoard_Tests, MissingFileHandledCorrectly)
 }
 
 
+TEST(BoggleBoard_Tests, RowsKeepOnlyLowercasedLetters)
+{
+	// Arrange
+	string filepath = "BoggleBoard_Tests_rows.txt";
+	{
+		ofstream file(filepath);
+		file << "a B c\r\n\r\n1 2 3\nQu-i-T\nxy";	// no line break at the end
+	}
+	BoggleBoard board{};
+
+	// Act
+	auto errorCode = importBoard(filepath, board);
+
+	// Assert (expected, actual)
+	const BoggleBoard expected{ { 'a', 'b', 'c' }, { 'q', 'u', 'i', 't' }, { 'x', 'y' } };
+	EXPECT_EQ(ErrorCode::SUCCESS, errorCode);
+	EXPECT_EQ(expected, board);
+
+	remove(filepath.c_str());
+}
+
+
+TEST(BoggleBoard_Tests, EmptyFileHasNoRows)
+{
+	// Arrange
+	string filepath = "BoggleBoard_Tests_empty.txt";
+	{
+		ofstream file(filepath);
+	}
+	BoggleBoard board{};
+
+	// Act
+	auto errorCode = importBoard(filepath, board);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, errorCode);
+	EXPECT_TRUE(board.empty());
+
+	remove(filepath.c_str());
+}
+
+
 /* 
 TEST(BoggleBoard_Tests, )
 {
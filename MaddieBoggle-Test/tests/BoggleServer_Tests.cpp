@@ -0,0 +1,109 @@
+#include "pch.h"
+
+#include <sstream>
+
+#include "TestDoubles.h"
+
+
+TEST(BoggleServer_Tests, PipelinedBoardsAreAnsweredInOrder)
+{
+	// Arrange
+	auto pool = make_shared<ThreadPool>(2);
+	BoggleServer server(makeSharedDictionary(), pool, 2);
+	istringstream input("board first\npe\ngn\nend\nboard second\r\nte\nxn\nend\nboard third\nxx\nend\n");
+	ostringstream output;
+
+	// Act
+	auto shutdown = server.serve(input, output);
+
+	// Assert (expected, actual)
+	EXPECT_FALSE(shutdown);
+	EXPECT_EQ("answers first 2\npeg\npen\nanswers second 1\nten\nanswers third 0\n", output.str());
+	EXPECT_EQ(3, server.getLatencyReport().m_boardCount);
+}
+
+
+TEST(BoggleServer_Tests, MalformedRequestsGetAnError)
+{
+	// Arrange
+	auto pool = make_shared<ThreadPool>(1);
+	BoggleServer server(makeSharedDictionary(), pool);
+	istringstream input("solve this\nboard late\npe\n");
+	ostringstream output;
+
+	// Act
+	server.serve(input, output);
+
+	// Assert (expected, actual)
+	EXPECT_EQ("error this unknown request: solve this\nerror late board is missing its end line\n", output.str());
+}
+
+
+TEST(BoggleServer_Tests, ShutdownStopsReading)
+{
+	// Arrange
+	auto pool = make_shared<ThreadPool>(1);
+	BoggleServer server(makeSharedDictionary(), pool);
+	istringstream input("board a\nte\nend\nshutdown\nboard b\nte\nend\n");
+	ostringstream output;
+
+	// Act
+	auto shutdown = server.serve(input, output);
+
+	// Assert (expected, actual)
+	EXPECT_TRUE(shutdown);
+	EXPECT_EQ("answers a 0\n", output.str());
+	EXPECT_EQ(1, server.getLatencyReport().m_boardCount);
+}
+
+
+TEST(BoggleServer_Tests, BoardRequestsCanAskForWordLengths)
+{
+	// Arrange
+	auto pool = make_shared<ThreadPool>(1);
+	BoggleServer server(makeSharedDictionary(), pool);
+	istringstream input("board a 4\npe\ngn\nend\nboard b 3 3\nte\nxn\nend\nboard c 5 3\nte\nend\nboard d x\nte\nend\n");
+	ostringstream output;
+
+	// Act
+	server.serve(input, output);
+
+	// Assert (expected, actual)
+	EXPECT_EQ("answers a 0\nanswers b 1\nten\nerror c invalid word lengths: board c 5 3\nerror d invalid word lengths: board d x\n", output.str());
+}
+
+
+TEST(BoggleServer_Tests, LatencyReportIsEmptyBeforeAnyBoard)
+{
+	// Arrange
+	auto pool = make_shared<ThreadPool>(1);
+	BoggleServer server(makeSharedDictionary(), pool);
+
+	ostringstream log;
+
+	// Act
+	auto report = server.getLatencyReport();
+	server.reportLatency(log);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(0, report.m_boardCount);
+	EXPECT_EQ(0.0, report.m_p50);
+	EXPECT_EQ(0.0, report.m_p99);
+	EXPECT_EQ("Served 0 boards, p50: 0.000 ms, p99: 0.000 ms, max: 0.000 ms\n", log.str());
+	EXPECT_FALSE(log.flags() & ios::fixed);	// the caller's format is left as it was
+}
+
+
+/*
+TEST(BoggleServer_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
@@ -22,14 +22,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeUp_NodeValid)
 	// Arrange
 	size_t row = 1;
 	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeUp(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeUp(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.find({ 0,1 }) != validNodes.end());
+	EXPECT_TRUE(result);
 }
 
 
@@ -38,30 +36,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeUp_NodeOutOfIndex)
 	// Arrange
 	size_t row = 0;
 	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeUp(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeUp(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
-}
-
-
-TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeUp_NodeAlreadyVisited)
-{
-	// Arrange
-	size_t row = 1;
-	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{ {0,1} };
-
-	// Act
-	checkNodeUp(row, col, board, validNodes, visitNodes);
-
-	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
+	EXPECT_FALSE(result);
 }
 
 
@@ -71,14 +51,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeDown_NodeValid)
 	// Arrange
 	size_t row = 1;
 	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeDown(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeDown(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.find({ 2,1 }) != validNodes.end());
+	EXPECT_TRUE(result);
 }
 
 
@@ -87,30 +65,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeDown_NodeOutOfIndex)
 	// Arrange
 	size_t row = 3;
 	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeDown(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeDown(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
-}
-
-
-TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeDown_NodeAlreadyVisited)
-{
-	// Arrange
-	size_t row = 1;
-	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{ {2,1} };
-
-	// Act
-	checkNodeDown(row, col, board, validNodes, visitNodes);
-
-	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
+	EXPECT_FALSE(result);
 }
 
 
@@ -120,14 +80,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeRight_NodeValid)
 	// Arrange
 	size_t row = 1;
 	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeRight(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeRight(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.find({ 1,2 }) != validNodes.end());
+	EXPECT_TRUE(result);
 }
 
 
@@ -136,30 +94,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeRight_NodeOutOfIndex)
 	// Arrange
 	size_t row = 1;
 	size_t col = 3;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeRight(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeRight(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
-}
-
-
-TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeRight_NodeAlreadyVisited)
-{
-	// Arrange
-	size_t row = 1;
-	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{ {1,2} };
-
-	// Act
-	checkNodeRight(row, col, board, validNodes, visitNodes);
-
-	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
+	EXPECT_FALSE(result);
 }
 
 
@@ -167,66 +107,42 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeRight_NodeAlreadyVisited)
 TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeLeft_NodeValid)
 {
 	// Arrange
-	size_t row = 1;
 	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeLeft(row, col, validNodes, visitNodes);
+	auto result = checkNodeLeft(col);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.find({ 1,0 }) != validNodes.end());
+	EXPECT_TRUE(result);
 }
 
 
 TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeLeft_NodeOutOfIndex)
 {
 	// Arrange
-	size_t row = 1;
 	size_t col = 0;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeLeft(row, col, validNodes, visitNodes);
+	auto result = checkNodeLeft(col);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
+	EXPECT_FALSE(result);
 }
 
 
 
-TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeLeft_NodeAlreadyVisited)
-{
-	// Arrange
-	size_t row = 1;
-	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{ {1,0} };
-
-	// Act
-	checkNodeLeft(row, col, validNodes, visitNodes);
-
-	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
-}
-
-
 // up left tests
 TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeUpLeft_NodeValid)
 {
 	// Arrange
 	size_t row = 1;
 	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeUpLeft(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeUpLeft(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.find({ 0,0 }) != validNodes.end());
+	EXPECT_TRUE(result);
 }
 
 
@@ -235,30 +151,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeUpLeft_NodeOutOfIndex)
 	// Arrange
 	size_t row = 1;
 	size_t col = 0;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
-
-	// Act
-	checkNodeUpLeft(row, col, board, validNodes, visitNodes);
-
-	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
-}
-
-
-TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeUpLeft_NodeAlreadyVisited)
-{
-	// Arrange
-	size_t row = 1;
-	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{ {0,0} };
 
 	// Act
-	checkNodeUpLeft(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeUpLeft(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
+	EXPECT_FALSE(result);
 }
 
 
@@ -271,14 +169,12 @@ TEST(BoggleSolverHelper_Tests, AsymBoard_CheckNodeUpLeft_AsymNodeExists)
 	// Arrange
 	size_t row = 1;
 	size_t col = 5;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeUpLeft(row, col, asymBoard, validNodes, visitNodes);
+	auto result = checkNodeUpLeft(row, col, asymBoard);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.find({ 0,4 }) != validNodes.end());
+	EXPECT_TRUE(result);
 }
 
 
@@ -288,14 +184,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeUpRight_NodeValid)
 	// Arrange
 	size_t row = 1;
 	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeUpRight(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeUpRight(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.find({ 0,2 }) != validNodes.end());
+	EXPECT_TRUE(result);
 }
 
 
@@ -304,30 +198,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeUpRight_NodeOutOfIndex)
 	// Arrange
 	size_t row = 1;
 	size_t col = 3;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
-
-	// Act
-	checkNodeUpRight(row, col, board, validNodes, visitNodes);
-
-	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
-}
-
-
-TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeUpRight_NodeAlreadyVisited)
-{
-	// Arrange
-	size_t row = 1;
-	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{ {0,2} };
 
 	// Act
-	checkNodeUpRight(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeUpRight(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
+	EXPECT_FALSE(result);
 }
 
 
@@ -340,14 +216,12 @@ TEST(BoggleSolverHelper_Tests, AsymBoard_CheckNodeUpRight_AsymNodeExists)
 	// Arrange
 	size_t row = 2;
 	size_t col = 3;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeUpRight(row, col, asymBoard, validNodes, visitNodes);
+	auto result = checkNodeUpRight(row, col, asymBoard);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.find({ 1,4 }) != validNodes.end());
+	EXPECT_TRUE(result);
 }
 
 
@@ -357,14 +231,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeDownRight_NodeValid)
 	// Arrange
 	size_t row = 1;
 	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeUpRight(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeDownRight(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.find({ 0,2 }) != validNodes.end());
+	EXPECT_TRUE(result);
 }
 
 
@@ -373,30 +245,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeDownRight_NodeOutOfIndex)
 	// Arrange
 	size_t row = 1;
 	size_t col = 3;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeUpRight(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeDownRight(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
-}
-
-
-TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeDownRight_NodeAlreadyVisited)
-{
-	// Arrange
-	size_t row = 1;
-	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{ {0,2} };
-
-	// Act
-	checkNodeUpRight(row, col, board, validNodes, visitNodes);
-
-	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
+	EXPECT_FALSE(result);
 }
 
 
@@ -406,14 +260,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeDownLeft_NodeValid)
 	// Arrange
 	size_t row = 1;
 	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
 
 	// Act
-	checkNodeDownLeft(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeDownLeft(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.find({ 2,0 }) != validNodes.end());
+	EXPECT_TRUE(result);
 }
 
 
@@ -422,30 +274,12 @@ TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeDownLeft_NodeOutOfIndex)
 	// Arrange
 	size_t row = 1;
 	size_t col = 0;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{};
-
-	// Act
-	checkNodeDownLeft(row, col, board, validNodes, visitNodes);
-
-	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
-}
-
-
-TEST(BoggleSolverHelper_Tests, NormalBoard_CheckNodeDownLeft_NodeAlreadyVisited)
-{
-	// Arrange
-	size_t row = 1;
-	size_t col = 1;
-	BoggleSolver::BoardNodes validNodes{};
-	BoggleSolver::BoardNodes visitNodes{ {2,0} };
 
 	// Act
-	checkNodeDownLeft(row, col, board, validNodes, visitNodes);
+	auto result = checkNodeDownLeft(row, col, board);
 
 	// Assert (expected, actual)
-	EXPECT_TRUE(validNodes.empty());
+	EXPECT_FALSE(result);
 }
 
 
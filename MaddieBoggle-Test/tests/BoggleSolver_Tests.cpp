@@ -1,6 +1,12 @@
 
 #include "pch.h"
 
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
 #include "TestDoubles.h"
 
 
@@ -24,6 +30,7 @@ TEST(BoggleSolver_Tests, NoFoundWordsAtIndex)
 	// Arrange
 	/* setup dictionary with words */
 	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->freeze();
 	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
 	/* setup thread pool */
 	auto pool = make_shared<ThreadPool>(1);
@@ -47,6 +54,7 @@ TEST(BoggleSolver_Tests, FoundWordsAtIndex)
 	auto dictionary = make_unique<Dictionary>(1000);
 	dictionary->insertWord("pen");
 	dictionary->insertWord("peg");
+	dictionary->freeze();
 	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
 	/* setup thread pool */
 	auto pool = make_shared<ThreadPool>(1);
@@ -72,6 +80,7 @@ TEST(BoggleSolver_Tests, PathExistsButItsNotAWord)
 	/* setup dictionary with words */
 	auto dictionary = make_unique<Dictionary>(1000);
 	dictionary->insertWord("pegolsa");
+	dictionary->freeze();
 	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
 	/* setup thread pool */
 	auto pool = make_shared<ThreadPool>(1);
@@ -97,6 +106,7 @@ TEST(BoggleSolver_Tests, SearchOnAsymBoardWorks)
 	/* setup dictionary with words */
 	auto dictionary = make_unique<Dictionary>(1000);
 	dictionary->insertWord("marts");
+	dictionary->freeze();
 	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
 	/* setup thread pool */
 	auto pool = make_shared<ThreadPool>(1);
@@ -121,6 +131,7 @@ TEST(BoggleSolver_Tests, QRuleSearchesForQuCorrectly)
 	/* setup dictionary with words */
 	auto dictionary = make_unique<Dictionary>(1000);
 	dictionary->insertWord("quit");
+	dictionary->freeze();
 	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
 	/* setup thread pool */
 	auto pool = make_shared<ThreadPool>(1);
@@ -139,6 +150,363 @@ TEST(BoggleSolver_Tests, QRuleSearchesForQuCorrectly)
 }
 
 
+TEST(BoggleSolver_Tests, SearchNeverTakesTheAnswerLock)
+{
+	// Arrange
+	/* setup dictionary with words that can be found from several start nodes */
+	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->insertWord("pen");
+	dictionary->insertWord("peg");
+	dictionary->insertWord("sis");
+	dictionary->insertWord("sit");
+	dictionary->insertWord("tis");
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	/* setup thread pool */
+	auto pool = make_shared<ThreadPool>(4);
+	/* create DUT */
+	BoggleSolver solver(safeDictionary, pool, board);
+
+	// Act
+	solver.solveBoard();
+	solver.waitForSolve();
+	auto statsAfterSearch = solver.getAnswerStats();
+	auto answerCount = solver.answerCount();
+	auto statsAfterMerge = solver.getAnswerStats();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(0, statsAfterSearch.m_lockAcquisitions);
+	EXPECT_EQ(0, statsAfterSearch.m_contendedLocks);
+	EXPECT_EQ(5, answerCount);
+	EXPECT_EQ(answerCount, statsAfterMerge.m_uniqueWords);
+	EXPECT_GE(statsAfterMerge.m_wordsFound, answerCount); // "sis" is found from both 's' nodes
+	EXPECT_EQ(0, statsAfterMerge.m_contendedLocks);
+}
+
+
+TEST(BoggleSolver_Tests, WordFoundTwiceIsOnlyAnsweredOnce)
+{
+	// Arrange
+	/* setup dictionary with a palindrome, found from both of its ends */
+	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->insertWord("sis");
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	/* setup thread pool */
+	auto pool = make_shared<ThreadPool>(1);
+	/* create DUT */
+	BoggleSolver_Double solver(safeDictionary, pool, board);
+	/* get pointer to answer set */
+	auto answers = solver.getAnswers();
+
+	// Act
+	solver.findWordsPassThrough(2, 1);
+	solver.findWordsPassThrough(3, 2);
+	auto stats = solver.getAnswerStats();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(1, answers->size());
+	EXPECT_EQ(2, stats.m_wordsFound);
+	EXPECT_EQ(1, stats.m_uniqueWords);
+}
+
+
+TEST(BoggleSolver_Tests, SplitSearchOnlyFindsWordsThroughItsPath)
+{
+	// Arrange
+	/* setup dictionary with words */
+	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->insertWord("pen");
+	dictionary->insertWord("peg");
+	dictionary->insertWord("pny");
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	/* setup thread pool */
+	auto pool = make_shared<ThreadPool>(1);
+	/* create DUT */
+	BoggleSolver_Double solver(safeDictionary, pool, board);
+	/* get pointer to answer set */
+	auto answers = solver.getAnswers();
+
+	// Act
+	solver.findWordsFromPathPassThrough({ 0, 4 }); // 'p' then 'e', see the cell indexes in BoardGraph_Tests
+
+	// Assert (expected, actual)
+	EXPECT_EQ(2, answers->size());
+	EXPECT_TRUE(answers->find("pen") != answers->end());
+	EXPECT_TRUE(answers->find("peg") != answers->end());
+}
+
+
+TEST(BoggleSolver_Tests, SmallBoardIsSplitOverIdleWorkers)
+{
+	// Arrange
+	const BoggleBoard smallBoard{
+		{'t','o'},
+		{'p','s'}
+	};
+	/* setup dictionary with words */
+	auto dictionary = make_unique<Dictionary>(1000);
+	for (const auto& word : { "opts", "post", "pot", "pots", "spot", "stop", "top", "tops" })
+	{
+		dictionary->insertWord(word);
+	}
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	/* setup thread pool, with more workers than the board has nodes */
+	auto pool = make_shared<ThreadPool>(8);
+	const auto deadline = chrono::steady_clock::now() + chrono::seconds(5);
+	while ((pool->idleWorkers() < pool->threadCount()) && (chrono::steady_clock::now() < deadline))
+	{
+		this_thread::yield(); // wait for every worker to be waiting for a task
+	}
+	/* create DUT, splitting is a board engine thing */
+	BoggleSolver solver(safeDictionary, pool, smallBoard, BoggleSolver::MAX_SPLIT_DEPTH, {}, false, SearchEngine::BOARD);
+
+	// Act
+	solver.solveBoard();
+	solver.waitForSolve();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(8, solver.answerCount());
+	EXPECT_LT(0, solver.splitCount()); // workers left over after one per node, so the search was split
+}
+
+
+TEST(BoggleSolver_Tests, SplitDepthOfOneNeverSplits)
+{
+	// Arrange
+	const BoggleBoard smallBoard{
+		{'t','o'},
+		{'p','s'}
+	};
+	/* setup dictionary with words */
+	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->insertWord("stop");
+	dictionary->insertWord("tops");
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	/* setup thread pool, with more workers than the board has nodes */
+	auto pool = make_shared<ThreadPool>(8);
+	/* create DUT */
+	BoggleSolver solver(safeDictionary, pool, smallBoard, 1, {}, false, SearchEngine::BOARD);
+
+	// Act
+	solver.solveBoard();
+	solver.waitForSolve();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(2, solver.answerCount());
+	EXPECT_EQ(0, solver.splitCount());
+}
+
+
+
+TEST(BoggleSolver_Tests, SearchStatsCountEveryStep)
+{
+	// Arrange
+	const BoggleBoard smallBoard{
+		{'t','o'},
+		{'p','s'}
+	};
+	/* setup dictionary with words */
+	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->insertWord("top");
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	/* setup thread pool */
+	auto pool = make_shared<ThreadPool>(1);
+	/* create DUT */
+	BoggleSolver_Double solver(safeDictionary, pool, smallBoard);
+
+	// Act
+	solver.findWordsPassThrough(0, 0); // t, to, top, then tops, tos, tp and ts are not prefixes
+	auto stats = solver.getSearchStats();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(3, stats.m_nodesExpanded);
+	EXPECT_EQ(7, stats.m_dictionaryLookups);
+	EXPECT_EQ(4, stats.m_prunedPaths);
+}
+
+TEST(BoggleSolver_Tests, WordLengthRangeMatchesFilteringTheAnswers)
+{
+	// Arrange
+	/* setup dictionary with words */
+	auto dictionary = make_unique<Dictionary>(1000);
+	for (const auto word : { "pen", "peg", "pens", "tint", "sip", "sips", "slog", "tensile" })
+	{
+		dictionary->insertWord(word);
+	}
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	/* setup thread pool */
+	auto pool = make_shared<ThreadPool>(1);
+	/* create DUTs */
+	BoggleSolver_Double everyLength(safeDictionary, pool, board);
+	BoggleSolver_Double fourLetters(safeDictionary, pool, board, { 4, 4 });
+
+	// Act
+	for (size_t row = 0; row < board.size(); row++)
+	{
+		for (size_t col = 0; col < board[row].size(); col++)
+		{
+			everyLength.findWordsPassThrough(row, col);
+			fourLetters.findWordsPassThrough(row, col);
+		}
+	}
+
+	// Assert (expected, actual)
+	set<string> filtered{};
+	for (const auto& word : *everyLength.getAnswers())
+	{
+		if (word.size() == 4) filtered.insert(word);
+	}
+	EXPECT_FALSE(filtered.empty());
+	EXPECT_EQ(filtered, *fourLetters.getAnswers());
+	EXPECT_GT(everyLength.getSearchStats().m_nodesExpanded, fourLetters.getSearchStats().m_nodesExpanded);
+}
+
+
+TEST(BoggleSolver_Tests, PathsWithOnlyShortWordsArePruned)
+{
+	// Arrange
+	const BoggleBoard smallBoard{
+		{'t','o'},
+		{'p','s'}
+	};
+	/* setup dictionary with words */
+	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->insertWord("top");
+	dictionary->insertWord("stop");
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	/* setup thread pool */
+	auto pool = make_shared<ThreadPool>(1);
+	/* create DUT */
+	BoggleSolver_Double solver(safeDictionary, pool, smallBoard, { 4 });
+
+	// Act
+	solver.findWordsPassThrough(0, 0); // "t" only leads to "top", too short
+	auto fromT = solver.getSearchStats();
+	solver.findWordsPassThrough(1, 1); // "s" leads to "stop"
+
+	// Assert (expected, actual)
+	EXPECT_EQ(0, fromT.m_nodesExpanded);
+	EXPECT_EQ(1, fromT.m_prunedPaths);
+	EXPECT_EQ(set<string>{ "stop" }, *solver.getAnswers());
+}
+
+
+TEST(BoggleSolver_Tests, DictionaryEngineFindsTheSameWordsAsTheBoardEngine)
+{
+	// Arrange
+	/* setup dictionary with words, some spelled through the 'q' cell and some not on the board */
+	auto dictionary = make_unique<Dictionary>(1000);
+	for (const auto word : { "pen", "peg", "pens", "tint", "sip", "sips", "slog", "tensile", "quit", "quasi", "qat", "tit", "yrt" })
+	{
+		dictionary->insertWord(word);
+	}
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	/* setup thread pool */
+	auto pool = make_shared<ThreadPool>(2);
+
+	for (const auto lengths : { WordLengthRange{}, WordLengthRange{ 4, 5 } })
+	{
+		/* create DUTs */
+		BoggleSolver boardEngine(safeDictionary, pool, board, BoggleSolver::MAX_SPLIT_DEPTH, lengths, false, SearchEngine::BOARD);
+		BoggleSolver dictionaryEngine(safeDictionary, pool, board, BoggleSolver::MAX_SPLIT_DEPTH, lengths, false, SearchEngine::DICTIONARY);
+
+		// Act
+		boardEngine.solveBoard();
+		dictionaryEngine.solveBoard();
+		boardEngine.waitForSolve();
+		dictionaryEngine.waitForSolve();
+		stringstream boardAnswers{};
+		stringstream dictionaryAnswers{};
+		boardEngine.writeAnswers(boardAnswers);
+		dictionaryEngine.writeAnswers(dictionaryAnswers);
+
+		// Assert (expected, actual)
+		EXPECT_NE(0, boardEngine.answerCount());
+		EXPECT_EQ(boardAnswers.str(), dictionaryAnswers.str());
+		EXPECT_EQ(SearchEngine::DICTIONARY, dictionaryEngine.getEngine());
+	}
+}
+
+
+TEST(BoggleSolver_Tests, ExportedWordIdsAreTheDictionaryIdsWithABoardTrie)
+{
+	// Arrange
+	/* "ant" and "zoo" are not on the board, so the board trie numbers its words differently */
+	auto dictionary = make_unique<Dictionary>(1000);
+	for (const auto word : { "ant", "peg", "pen", "pens", "tin", "zoo" })
+	{
+		dictionary->insertWord(word);
+	}
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	auto pool = make_shared<ThreadPool>(2);
+	BoggleSolver solver(safeDictionary, pool, board, BoggleSolver::MAX_SPLIT_DEPTH, {}, true);
+	solver.solveBoard();
+	solver.waitForSolve();
+
+	// Act
+	auto status = solver.exportAnswers("BoggleSolver_Tests_ids.bin", AnswerFormat::WORD_IDS);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	ifstream file("BoggleSolver_Tests_ids.bin", ios::binary);
+	const string bytes((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+	file.close();
+	const string expected{ 'M', 'B', 'I', 'D', 4, 1, 1, 1, 1 };	// 4 words, ids 1 to 4 as gaps
+	EXPECT_EQ(expected, bytes);
+
+	remove("BoggleSolver_Tests_ids.bin");
+}
+
+
+TEST(BoggleSolver_Tests, ChooseEngineTakesTheDictionaryEngineForFewWordsOnAHugeBoard)
+{
+	// Arrange
+	const size_t hugeBoard{ 200 * 200 };
+	const size_t classicBoard{ 4 * 4 };
+
+	// Act
+	auto fewWords = BoggleSolver::chooseEngine(hugeBoard, 300);
+	auto manyWords = BoggleSolver::chooseEngine(hugeBoard, 100000);
+	auto smallBoard = BoggleSolver::chooseEngine(classicBoard, 1000);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(SearchEngine::DICTIONARY, fewWords);
+	EXPECT_EQ(SearchEngine::BOARD, manyWords);
+	EXPECT_EQ(SearchEngine::BOARD, smallBoard);
+}
+
+
+TEST(BoggleSolver_Tests, UnfrozenDictionaryIsRejectedInsteadOfSearched)
+{
+	// Arrange
+	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->insertWord("pen");
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	auto pool = make_shared<ThreadPool>(1);
+	BoggleSolver solver(safeDictionary, pool, board, BoggleSolver::MAX_SPLIT_DEPTH, {}, true);
+	DictionaryCursor cursor(*safeDictionary);
+
+	// Act
+	auto status = solver.solveBoard();
+	pool->waitForCompletion();
+	auto advanced = cursor.advance('p');
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::DICTIONARY_NOT_FROZEN, status);
+	EXPECT_EQ(0, solver.answerCount());
+	EXPECT_FALSE(advanced);
+}
+
+
 /*
 TEST(BoggleSolver_Tests, )
 {
@@ -0,0 +1,121 @@
+#include "pch.h"
+
+#include <cstdint>
+#include <thread>
+
+
+TEST(ChildArena_Tests, AllocationsAreAlignedAndDistinct)
+{
+	// Arrange
+	ChildArena arena{};
+
+	// Act
+	auto first = static_cast<char*>(arena.allocate(1));
+	auto second = static_cast<char*>(arena.allocate(24));
+
+	// Assert (expected, actual)
+	EXPECT_EQ(0, reinterpret_cast<uintptr_t>(first) % ChildArena::ALIGNMENT);
+	EXPECT_EQ(0, reinterpret_cast<uintptr_t>(second) % ChildArena::ALIGNMENT);
+	EXPECT_LE(first + 1, second);
+	EXPECT_EQ(1, arena.blockCount());
+}
+
+
+TEST(ChildArena_Tests, FullBlockAddsAnotherOne)
+{
+	// Arrange
+	ChildArena arena{};
+	arena.allocate(ChildArena::BLOCK_BYTES - ChildArena::ALIGNMENT);
+	ASSERT_EQ(1, arena.blockCount());
+
+	// Act
+	arena.allocate(2 * ChildArena::ALIGNMENT);
+	arena.allocate(2 * ChildArena::BLOCK_BYTES);	// bigger than a block, gets its own
+
+	// Assert (expected, actual)
+	EXPECT_EQ(3, arena.blockCount());
+	EXPECT_EQ(4 * ChildArena::BLOCK_BYTES, arena.bytesReserved());
+}
+
+
+TEST(ChildArena_Tests, ReleaseFreesEveryBlock)
+{
+	// Arrange
+	ChildArena arena{};
+	arena.allocate(100);
+	ASSERT_LT(0, arena.bytesUsed());
+
+	// Act
+	arena.release();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(0, arena.blockCount());
+	EXPECT_EQ(0, arena.bytesUsed());
+	EXPECT_NE(nullptr, arena.allocate(100));	// still usable
+}
+
+
+TEST(ChildArena_Tests, ChildVectorsOfPoolNodesUseTheArena)
+{
+	// Arrange
+	ChildArena arena{};
+	LetterNodePool pool(LetterNodePool::NO_NODE_LIMIT, &arena);
+	auto parent = pool.allocate();
+	auto child = pool.allocate();
+
+	// Act
+	parent->insertChild('a', child);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(&arena, parent->arena());
+	EXPECT_EQ(child, parent->findChild('a'));
+	EXPECT_EQ(1, arena.blockCount());
+}
+
+
+TEST(ChildArena_Tests, ThreadsAllocatingAtOnceGetSeparateMemory)
+{
+	// Arrange
+	ChildArena arena{};
+	constexpr size_t allocationsPerThread = 20000;
+	vector<vector<size_t*>> allocations(4);
+
+	// Act
+	vector<thread> threads{};
+	for (size_t t = 0; t < allocations.size(); t++)
+	{
+		threads.emplace_back([&arena, &allocations, t]() {
+			for (size_t i = 0; i < allocationsPerThread; i++)
+			{
+				auto memory = static_cast<size_t*>(arena.allocate(sizeof(size_t)));
+				*memory = t;
+				allocations[t].push_back(memory);
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	// Assert (expected, actual)
+	for (size_t t = 0; t < allocations.size(); t++)
+	{
+		for (const auto memory : allocations[t])
+		{
+			ASSERT_EQ(t, *memory); // overlapping memory would have been overwritten by another thread
+		}
+	}
+}
+
+
+/*
+TEST(ChildArena_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
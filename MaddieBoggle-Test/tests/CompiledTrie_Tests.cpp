@@ -0,0 +1,162 @@
+#include "pch.h"
+
+
+TEST(CompiledTrie_Tests, EmptyTrieOnlyHasRoot)
+{
+	// Arrange
+	auto root = LetterNode();
+	auto trie = CompiledTrie();
+	ASSERT_TRUE(trie.isEmpty());
+
+	// Act
+	trie.build(&root);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(1, trie.nodeCount());
+	EXPECT_FALSE(trie.isWord(CompiledTrie::ROOT));
+	EXPECT_EQ(CompiledTrie::NO_NODE, trie.findChild(CompiledTrie::ROOT, 'a'));
+}
+
+
+TEST(CompiledTrie_Tests, ChildrenAreFoundByLetter)
+{
+	// Arrange
+	/*
+			root
+		   /  |  \
+		  c   d   x
+			  |
+			  e (word)
+	*/
+	auto root = LetterNode();
+	auto node_c = LetterNode();
+	auto node_d = LetterNode();
+	auto node_x = LetterNode();
+	auto node_e = LetterNode();
+	node_e.m_isWordValid = true;
+	root.insertChild('x', &node_x);
+	root.insertChild('c', &node_c);
+	root.insertChild('d', &node_d);
+	node_d.insertChild('e', &node_e);
+	auto trie = CompiledTrie();
+
+	// Act
+	trie.build(&root);
+	auto child_c = trie.findChild(CompiledTrie::ROOT, 'c');
+	auto child_d = trie.findChild(CompiledTrie::ROOT, 'd');
+	auto child_x = trie.findChild(CompiledTrie::ROOT, 'x');
+	auto child_e = trie.findChild(child_d, 'e');
+
+	// Assert (expected, actual)
+	/* breadth first layout, root's children are next to each other in letter order */
+	EXPECT_EQ(5, trie.nodeCount());
+	EXPECT_EQ(1, child_c);
+	EXPECT_EQ(2, child_d);
+	EXPECT_EQ(3, child_x);
+	EXPECT_EQ(4, child_e);
+	EXPECT_TRUE(trie.isWord(child_e));
+	EXPECT_FALSE(trie.isWord(child_d));
+	EXPECT_EQ(CompiledTrie::NO_NODE, trie.findChild(CompiledTrie::ROOT, 'e'));
+}
+
+
+TEST(CompiledTrie_Tests, NonAlphabetLettersAreLeftOut)
+{
+	// Arrange
+	auto root = LetterNode();
+	auto node_a = LetterNode();
+	auto node_dash = LetterNode();
+	root.insertChild('a', &node_a);
+	root.insertChild('-', &node_dash);
+	auto trie = CompiledTrie();
+
+	// Act
+	trie.build(&root);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(2, trie.nodeCount());
+	EXPECT_EQ(CompiledTrie::NO_NODE, trie.findChild(CompiledTrie::ROOT, '-'));
+	EXPECT_NE(CompiledTrie::NO_NODE, trie.findChild(CompiledTrie::ROOT, 'a'));
+}
+
+
+TEST(CompiledTrie_Tests, RemainingDepthsBoundTheWordsBelow)
+{
+	// Arrange
+	/*
+			root
+			 |
+			 b
+			/ \
+		   a   e
+		   |   |
+		   t*  e*
+			   |
+			   t*
+	*/
+	auto root = LetterNode();
+	auto node_b = LetterNode();
+	auto node_a = LetterNode();
+	auto node_t1 = LetterNode();
+	auto node_e1 = LetterNode();
+	auto node_e2 = LetterNode();
+	auto node_t2 = LetterNode();
+	node_t1.m_isWordValid = true;
+	node_e2.m_isWordValid = true;
+	node_t2.m_isWordValid = true;
+	root.insertChild('b', &node_b);
+	node_b.insertChild('a', &node_a);
+	node_b.insertChild('e', &node_e1);
+	node_a.insertChild('t', &node_t1);
+	node_e1.insertChild('e', &node_e2);
+	node_e2.insertChild('t', &node_t2);
+	auto trie = CompiledTrie();
+
+	// Act
+	trie.build(&root);
+	auto child_b = trie.findChild(CompiledTrie::ROOT, 'b');
+	auto child_e = trie.findChild(child_b, 'e');
+	auto child_ee = trie.findChild(child_e, 'e');
+
+	// Assert (expected, actual)
+	EXPECT_EQ(4, trie.longestWord());
+	EXPECT_EQ(3, trie.shortestRemaining(CompiledTrie::ROOT));
+	EXPECT_EQ(2, trie.shortestRemaining(child_b));
+	EXPECT_EQ(3, trie.longestRemaining(child_b));
+	EXPECT_EQ(1, trie.shortestRemaining(child_e));
+	EXPECT_EQ(2, trie.longestRemaining(child_e));
+	EXPECT_EQ(0, trie.shortestRemaining(child_ee));	// "bee" ends here
+	EXPECT_EQ(1, trie.longestRemaining(child_ee));
+}
+
+
+TEST(CompiledTrie_Tests, EmptyTrieHasNoLongestWord)
+{
+	// Arrange
+	auto root = LetterNode();
+	auto trie = CompiledTrie();
+
+	// Act
+	auto beforeBuild = trie.longestWord();
+	trie.build(&root);
+	auto afterBuild = trie.longestWord();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(0, beforeBuild);
+	EXPECT_EQ(0, afterBuild);
+}
+
+
+/*
+TEST(CompiledTrie_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
@@ -0,0 +1,129 @@
+#include "pch.h"
+
+
+/* Walks the compiled trie the same way a DictionaryCursor does. */
+static uint32_t walk(const CompiledTrie& trie, const string& word)
+{
+	auto node = CompiledTrie::ROOT;
+	for (const auto letter : word)
+	{
+		node = trie.findChild(node, letter);
+		if (node == CompiledTrie::NO_NODE) break;
+	}
+	return node;
+}
+
+
+TEST(DawgBuilder_Tests, SharedSuffixesAreMerged)
+{
+	// Arrange
+	DawgBuilder builder{};
+	auto trie = CompiledTrie();
+
+	// Act
+	builder.insertWord("tap");
+	builder.insertWord("taps");
+	builder.insertWord("top");
+	builder.insertWord("tops");
+	builder.finish(trie);
+
+	/*
+		  trie (8 nodes)		dawg (5 nodes)
+			  root					root
+			   |					 |
+			   t					 t
+			 /   \					/ \
+			a     o				   a   o
+			|     |					\ /
+			p     p					 p
+			|     |					 |
+			s     s					 s
+	*/
+	// Assert (expected, actual)
+	EXPECT_EQ(8, builder.nodesBeforeMinimization());
+	EXPECT_EQ(5, builder.nodesAfterMinimization());
+}
+
+
+TEST(DawgBuilder_Tests, MinimizedGraphAnswersWordAndPathQueries)
+{
+	// Arrange
+	DawgBuilder builder{};
+	auto trie = CompiledTrie();
+	for (const auto& word : { "cat", "cats", "dog", "dogs", "tap", "taps", "top", "tops" })
+	{
+		ASSERT_EQ(ErrorCode::SUCCESS, builder.insertWord(word));
+	}
+
+	// Act
+	builder.finish(trie);
+
+	// Assert (expected, actual)
+	for (const auto& word : { "cat", "cats", "dog", "dogs", "tap", "taps", "top", "tops" })
+	{
+		auto node = walk(trie, word);
+		ASSERT_NE(CompiledTrie::NO_NODE, node);
+		EXPECT_TRUE(trie.isWord(node));
+	}
+
+	/* merging the suffixes must not create words that were never inserted */
+	EXPECT_EQ(CompiledTrie::NO_NODE, walk(trie, "dap"));
+	EXPECT_EQ(CompiledTrie::NO_NODE, walk(trie, "tog"));
+	EXPECT_FALSE(trie.isWord(walk(trie, "ca")));
+	EXPECT_FALSE(trie.isWord(walk(trie, "to")));
+}
+
+
+TEST(DawgBuilder_Tests, UnsortedInputIsRejected)
+{
+	// Arrange
+	DawgBuilder builder{};
+	ASSERT_EQ(ErrorCode::SUCCESS, builder.insertWord("dog"));
+
+	// Act
+	auto status_1 = builder.insertWord("dog"); // duplicates are ignored
+	auto status_2 = builder.insertWord("cat");
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status_1);
+	EXPECT_EQ(ErrorCode::UNSORTED_INPUT, status_2);
+}
+
+
+TEST(DawgBuilder_Tests, WordIdsSurviveSharedNodes)
+{
+	// Arrange
+	DawgBuilder builder{};
+	auto trie = CompiledTrie();
+	const vector<string> sortedWords{ "cat", "cats", "dog", "dogs", "tap", "taps", "top", "tops" };
+	for (const auto& word : sortedWords)
+	{
+		ASSERT_EQ(ErrorCode::SUCCESS, builder.insertWord(word));
+	}
+
+	// Act
+	builder.finish(trie);
+
+	// Assert (expected, actual)
+	/* "tap" and "top" end on the same record, so the id has to come from the path taken */
+	ASSERT_EQ(sortedWords.size(), trie.wordCount());
+	for (uint32_t wordId = 0; wordId < sortedWords.size(); wordId++)
+	{
+		EXPECT_EQ(sortedWords[wordId], trie.wordAt(wordId));
+	}
+}
+
+
+/*
+TEST(DawgBuilder_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
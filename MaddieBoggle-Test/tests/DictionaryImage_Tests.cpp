@@ -0,0 +1,140 @@
+#include "pch.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "TestDoubles.h"
+
+
+TEST(DictionaryImage_Tests, SavedImageLoadsWithTheSameAnswers)
+{
+	// Arrange
+	string imagePath = "DictionaryImage_Tests_roundtrip.img";
+	auto source = Dictionary(150);
+	source.insertWord("balatro");
+	source.insertWord("bat");
+	source.insertWord("cat");
+	ASSERT_EQ(ErrorCode::SUCCESS, source.freeze(DictionaryLayout::RADIX));
+	ASSERT_EQ(ErrorCode::SUCCESS, source.saveImage(imagePath, 42));
+	auto dictionary = Dictionary_Double(150);
+
+	// Act
+	auto status = dictionary.loadImage(imagePath, 42);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	EXPECT_TRUE(dictionary.isFrozen());
+	EXPECT_EQ(nullptr, dictionary.getRootNode()); // trie nodes were never needed
+	EXPECT_EQ(source.nodeCount(), dictionary.nodeCount());
+	EXPECT_TRUE(dictionary.searchDictionary("balatro", SearchType::WORD));
+	EXPECT_TRUE(dictionary.searchDictionary("bat", SearchType::WORD));
+	EXPECT_TRUE(dictionary.searchDictionary("cat", SearchType::WORD));
+	EXPECT_TRUE(dictionary.searchDictionary("balat", SearchType::PATH));
+	EXPECT_FALSE(dictionary.searchDictionary("balat", SearchType::WORD));
+	EXPECT_FALSE(dictionary.searchDictionary("cab", SearchType::PATH));
+	EXPECT_EQ(7, dictionary.longestWord());
+
+	remove(imagePath.c_str());
+}
+
+
+TEST(DictionaryImage_Tests, StaleImageIsRejected)
+{
+	// Arrange
+	string imagePath = "DictionaryImage_Tests_stale.img";
+	auto source = Dictionary(150);
+	source.insertWord("bat");
+	ASSERT_EQ(ErrorCode::SUCCESS, source.freeze());
+	ASSERT_EQ(ErrorCode::SUCCESS, source.saveImage(imagePath, 1));
+	auto dictionary = Dictionary(150);
+
+	// Act
+	auto status = dictionary.loadImage(imagePath, 2); // text dictionary changed since
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::IMAGE_INVALID, status);
+	EXPECT_FALSE(dictionary.isFrozen());
+
+	remove(imagePath.c_str());
+}
+
+
+TEST(DictionaryImage_Tests, CorruptedImageIsRejected)
+{
+	// Arrange
+	string imagePath = "DictionaryImage_Tests_corrupt.img";
+	auto source = Dictionary(150);
+	source.insertWord("bat");
+	ASSERT_EQ(ErrorCode::SUCCESS, source.freeze());
+	ASSERT_EQ(ErrorCode::SUCCESS, source.saveImage(imagePath, 7));
+	{
+		// change the last byte of the image
+		fstream file(imagePath, ios::in | ios::out | ios::binary);
+		file.seekp(-1, ios::end);
+		file.put('\x7f');
+	}
+	auto dictionary = Dictionary(150);
+
+	// Act
+	auto status = dictionary.loadImage(imagePath, 7);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::IMAGE_INVALID, status);
+	EXPECT_FALSE(dictionary.isFrozen());
+
+	remove(imagePath.c_str());
+}
+
+
+TEST(DictionaryImage_Tests, MissingImageHandledCorrectly)
+{
+	// Arrange
+	auto dictionary = Dictionary(150);
+	string imagePath = "this/path/should/not/exist.img";
+
+	// Act
+	auto status = dictionary.loadImage(imagePath, 0);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::FILE_NOT_FOUND, status);
+	EXPECT_FALSE(dictionary.isFrozen());
+}
+
+
+TEST(DictionaryImage_Tests, FingerprintChangesWithFileContent)
+{
+	// Arrange
+	string filepath = "DictionaryImage_Tests_words.txt";
+	uint64_t fingerprint_1 = 0;
+	uint64_t fingerprint_2 = 0;
+	uint64_t fingerprint_3 = 0;
+
+	// Act
+	{ ofstream(filepath) << "bat\ncat\n"; }
+	auto status = DictionaryImage::fingerprintFile(filepath, fingerprint_1);
+	DictionaryImage::fingerprintFile(filepath, fingerprint_2);
+	{ ofstream(filepath) << "bat\ncar\n"; }
+	DictionaryImage::fingerprintFile(filepath, fingerprint_3);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	EXPECT_EQ(fingerprint_1, fingerprint_2);
+	EXPECT_NE(fingerprint_1, fingerprint_3);
+
+	remove(filepath.c_str());
+}
+
+
+/*
+TEST(DictionaryImage_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
@@ -1,6 +1,14 @@
 
 #include "pch.h"
 
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
 #include "TestDoubles.h"
 
 
@@ -50,7 +58,7 @@ TEST(Dictionary_Tests, DictionaryInsertsWordCorrectly)
 	// Arrange
 	auto dictionary = Dictionary_Double(150);
 	auto root = dictionary.getRootNode();
-	ASSERT_TRUE(root->m_childLetters.empty()); // root will have no children if no words added
+	ASSERT_TRUE(root->childCount() == 0); // root will have no children if no words added
 
 	// set to something different so they can be checked for success
 	auto status_1 = ErrorCode::OUT_OF_POOL_SPACE;
@@ -70,9 +78,9 @@ TEST(Dictionary_Tests, DictionaryInsertsWordCorrectly)
 
 	// Assert (expected, actual)
 	/* check node layout */
-	EXPECT_EQ('a', root->m_childLetters[0].first);
-	EXPECT_EQ('b', root->m_childLetters[0].second->m_childLetters[0].first);
-	EXPECT_EQ('c', root->m_childLetters[0].second->m_childLetters[0].second->m_childLetters[0].first);
+	EXPECT_EQ('a', root->childLetter(0));
+	EXPECT_EQ('b', root->childNode(0)->childLetter(0));
+	EXPECT_EQ('c', root->childNode(0)->childNode(0)->childLetter(0));
 
 	/* check status codes */
 	EXPECT_EQ(ErrorCode::SUCCESS, status_1);
@@ -84,7 +92,7 @@ TEST(Dictionary_Tests, MultipleWordsInsertedCorrectly)
 	// Arrange
 	auto dictionary = Dictionary_Double(150);
 	auto root = dictionary.getRootNode();
-	ASSERT_TRUE(root->m_childLetters.empty()); // root will have no children if no words added
+	ASSERT_TRUE(root->childCount() == 0); // root will have no children if no words added
 
 	// set to something different so they can be checked for success
 	auto status_1 = ErrorCode::OUT_OF_POOL_SPACE;
@@ -109,15 +117,15 @@ TEST(Dictionary_Tests, MultipleWordsInsertedCorrectly)
 	EXPECT_EQ(ErrorCode::SUCCESS, status_2);
 
 	/* make sure node true contains the correct nodes */
-	EXPECT_EQ('a', root->m_childLetters[0].first);
-	EXPECT_EQ('b', root->m_childLetters[0].second->m_childLetters[0].first);
-	EXPECT_EQ('c', root->m_childLetters[0].second->m_childLetters[0].second->m_childLetters[0].first);
-	EXPECT_EQ('d', root->m_childLetters[0].second->m_childLetters[0].second->m_childLetters[1].first);
+	EXPECT_EQ('a', root->childLetter(0));
+	EXPECT_EQ('b', root->childNode(0)->childLetter(0));
+	EXPECT_EQ('c', root->childNode(0)->childNode(0)->childLetter(0));
+	EXPECT_EQ('d', root->childNode(0)->childNode(0)->childLetter(1));
 
 	/* check child vector sizes  */
-	EXPECT_EQ(1, root->m_childLetters.size());
-	EXPECT_EQ(1, root->m_childLetters[0].second->m_childLetters.size());
-	EXPECT_EQ(2, root->m_childLetters[0].second->m_childLetters[0].second->m_childLetters.size());
+	EXPECT_EQ(1, root->childCount());
+	EXPECT_EQ(1, root->childNode(0)->childCount());
+	EXPECT_EQ(2, root->childNode(0)->childNode(0)->childCount());
 }
 
 
@@ -126,7 +134,7 @@ TEST(Dictionary_Tests, WordsThatAreTooSmallAreNotAddedToDictionary)
 	// Arrange
 	auto dictionary = Dictionary_Double(150);
 	auto root = dictionary.getRootNode();
-	ASSERT_TRUE(root->m_childLetters.empty()); // root will have no children if no words added
+	ASSERT_TRUE(root->childCount() == 0); // root will have no children if no words added
 
 	// set to something different so they can be checked for success
 	auto status_1 = ErrorCode::OUT_OF_POOL_SPACE;
@@ -136,7 +144,7 @@ TEST(Dictionary_Tests, WordsThatAreTooSmallAreNotAddedToDictionary)
 
 	// Assert (expected, actual)
 	/* if word is too small, then the root won't have any children */
-	EXPECT_TRUE(root->m_childLetters.empty());
+	EXPECT_TRUE(root->childCount() == 0);
 
 	/* check status codes */
 	EXPECT_EQ(ErrorCode::SUCCESS, status_1);
@@ -148,7 +156,7 @@ TEST(Dictionary_Tests, DictionaryCorrectlyFindsWord)
 	// Arrange
 	auto dictionary = Dictionary_Double(150);
 	auto root = dictionary.getRootNode();
-	ASSERT_TRUE(root->m_childLetters.empty()); // root will have no children if no words added
+	ASSERT_TRUE(root->childCount() == 0); // root will have no children if no words added
 
 	bool result_1 = dictionary.searchDictionary("abc", SearchType::WORD);
 	ASSERT_FALSE(result_1);
@@ -169,7 +177,7 @@ TEST(Dictionary_Tests, DictionaryCorrectlyIndicatesPathExistence)
 	// Arrange
 	auto dictionary = Dictionary_Double(150);
 	auto root = dictionary.getRootNode();
-	ASSERT_TRUE(root->m_childLetters.empty()); // root will have no children if no words added
+	ASSERT_TRUE(root->childCount() == 0); // root will have no children if no words added
 
 	// Act
 	dictionary.insertWord("balatro");
@@ -182,6 +190,463 @@ TEST(Dictionary_Tests, DictionaryCorrectlyIndicatesPathExistence)
 }
 
 
+TEST(Dictionary_Tests, CursorWalksWordLetterByLetter)
+{
+	// Arrange
+	auto dictionary = Dictionary(150);
+	dictionary.insertWord("ant");
+	dictionary.insertWord("and");
+	dictionary.freeze();
+	auto cursor = DictionaryCursor(dictionary);
+
+	// Act
+	bool result_1 = cursor.advance('a');
+	bool result_2 = cursor.advance('n');
+	bool isWord_1 = cursor.isWord();
+	bool result_3 = cursor.advance('t');
+	bool isWord_2 = cursor.isWord();
+
+	// Assert (expected, actual)
+	EXPECT_TRUE(result_1);
+	EXPECT_TRUE(result_2);
+	EXPECT_FALSE(isWord_1); // "an" is only a path
+	EXPECT_TRUE(result_3);
+	EXPECT_TRUE(isWord_2);  // "ant" is a word
+	EXPECT_EQ(3, cursor.depth());
+}
+
+
+TEST(Dictionary_Tests, CursorFailedAdvanceLeavesPathUnchanged)
+{
+	// Arrange
+	auto dictionary = Dictionary(150);
+	dictionary.insertWord("ant");
+	dictionary.freeze();
+	auto cursor = DictionaryCursor(dictionary);
+	ASSERT_TRUE(cursor.advance('a'));
+
+	// Act
+	bool result = cursor.advance('x');
+
+	// Assert (expected, actual)
+	EXPECT_FALSE(result);
+	EXPECT_EQ(1, cursor.depth());
+	EXPECT_TRUE(cursor.advance('n')); // still able to continue from "a"
+}
+
+
+TEST(Dictionary_Tests, CursorStepBackReturnsToPreviousPrefix)
+{
+	// Arrange
+	auto dictionary = Dictionary(150);
+	dictionary.insertWord("ant");
+	dictionary.insertWord("and");
+	dictionary.freeze();
+	auto cursor = DictionaryCursor(dictionary);
+	ASSERT_TRUE(cursor.advance('a'));
+	ASSERT_TRUE(cursor.advance('n'));
+	ASSERT_TRUE(cursor.advance('t'));
+
+	// Act
+	cursor.stepBack();
+	bool result = cursor.advance('d');
+
+	// Assert (expected, actual)
+	EXPECT_TRUE(result);
+	EXPECT_TRUE(cursor.isWord()); // "and"
+	EXPECT_EQ(3, cursor.depth());
+}
+
+
+TEST(Dictionary_Tests, FrozenDictionaryStillFindsWordsAndPaths)
+{
+	// Arrange
+	auto dictionary = Dictionary(150);
+	dictionary.insertWord("balatro");
+	dictionary.insertWord("bat");
+
+	// Act
+	auto status = dictionary.freeze();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	EXPECT_TRUE(dictionary.isFrozen());
+	EXPECT_TRUE(dictionary.searchDictionary("balatro", SearchType::WORD));
+	EXPECT_TRUE(dictionary.searchDictionary("bat", SearchType::WORD));
+	EXPECT_TRUE(dictionary.searchDictionary("balat", SearchType::PATH));
+	EXPECT_FALSE(dictionary.searchDictionary("balat", SearchType::WORD));
+	EXPECT_FALSE(dictionary.searchDictionary("balay", SearchType::PATH));
+}
+
+
+TEST(Dictionary_Tests, FrozenDictionaryRejectsNewWords)
+{
+	// Arrange
+	auto dictionary = Dictionary_Double(150);
+	dictionary.insertWord("abc");
+	ASSERT_EQ(ErrorCode::SUCCESS, dictionary.freeze());
+
+	// Act
+	auto status_1 = dictionary.insertWord("abd");
+	auto status_2 = dictionary.freeze();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::DICTIONARY_FROZEN, status_1);
+	EXPECT_EQ(ErrorCode::DICTIONARY_FROZEN, status_2);
+	EXPECT_FALSE(dictionary.searchDictionary("abd", SearchType::WORD));
+	EXPECT_EQ(nullptr, dictionary.getRootNode()); // trie nodes were released
+}
+
+
+TEST(Dictionary_Tests, MinimizedImportMissingFileHandledCorrectly)
+{
+	// Arrange
+	auto dictionary = Dictionary(150);
+	string filepath = "this/path/should/not/exist.txt";
+
+	// Act
+	auto errorCode = dictionary.importMinimizedDictionary(filepath);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::FILE_NOT_FOUND, errorCode);
+	EXPECT_FALSE(dictionary.isFrozen());
+}
+
+
+TEST(Dictionary_Tests, RadixLayoutCollapsesSingleChildChains)
+{
+	// Arrange
+	auto dictionary = Dictionary(150);
+	dictionary.insertWord("balatro");
+	dictionary.insertWord("bat");
+
+	// Act
+	auto status = dictionary.freeze(DictionaryLayout::RADIX);
+
+	/*
+		   trie (9 nodes)			  radix (4 records)
+				root						root
+				 |							 |
+				 b							 b "a"
+				 |							/ \
+				 a				   "atro" l   t
+				/ \
+			   l   t
+			   |
+			   a
+			   |
+			   t
+			   |
+			   r
+			   |
+			   o
+	*/
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	EXPECT_EQ(4, dictionary.nodeCount());
+	EXPECT_TRUE(dictionary.searchDictionary("balatro", SearchType::WORD));
+	EXPECT_TRUE(dictionary.searchDictionary("bat", SearchType::WORD));
+	EXPECT_TRUE(dictionary.searchDictionary("balat", SearchType::PATH));
+	EXPECT_FALSE(dictionary.searchDictionary("balat", SearchType::WORD));
+	EXPECT_FALSE(dictionary.searchDictionary("balay", SearchType::PATH));
+	EXPECT_FALSE(dictionary.searchDictionary("ba", SearchType::WORD));
+}
+
+
+TEST(Dictionary_Tests, CursorStepsThroughRadixLabelsOneLetterAtATime)
+{
+	// Arrange
+	auto dictionary = Dictionary(150);
+	dictionary.insertWord("balatro");
+	dictionary.insertWord("bat");
+	dictionary.freeze(DictionaryLayout::RADIX);
+	auto cursor = DictionaryCursor(dictionary);
+	ASSERT_TRUE(cursor.advance('b'));
+	ASSERT_TRUE(cursor.advance('a'));
+	ASSERT_TRUE(cursor.advance('l'));
+
+	// Act
+	bool result_1 = cursor.advance('x');	// not the next label letter
+	bool result_2 = cursor.advance('a');	// next label letter
+	cursor.stepBack();
+	cursor.stepBack();
+	bool result_3 = cursor.advance('t');	// back at "ba", can take the other child
+
+	// Assert (expected, actual)
+	EXPECT_FALSE(result_1);
+	EXPECT_TRUE(result_2);
+	EXPECT_TRUE(result_3);
+	EXPECT_TRUE(cursor.isWord());
+	EXPECT_EQ(3, cursor.depth());
+}
+
+
+/* Walks a word with a cursor and returns the word id it ends on. */
+static uint32_t cursorWordId(const Dictionary& dictionary, const string& word)
+{
+	auto cursor = DictionaryCursor(dictionary);
+	for (const auto letter : word)
+	{
+		if (!cursor.advance(letter)) return CompiledTrie::NO_NODE;
+	}
+	return cursor.isWord() ? cursor.wordId() : CompiledTrie::NO_NODE;
+}
+
+
+TEST(Dictionary_Tests, WordIdsFollowSortedWordOrder)
+{
+	// Arrange
+	const vector<string> sortedWords{ "bat", "bee", "beet", "beets", "theory", "zoo" };
+	auto trieDictionary = Dictionary(150);
+	auto radixDictionary = Dictionary(150);
+	for (auto it = sortedWords.rbegin(); it != sortedWords.rend(); it++) // insertion order doesn't matter
+	{
+		trieDictionary.insertWord(*it);
+		radixDictionary.insertWord(*it);
+	}
+
+	// Act
+	trieDictionary.freeze();
+	radixDictionary.freeze(DictionaryLayout::RADIX);
+
+	// Assert (expected, actual)
+	for (const auto dictionary : { &trieDictionary, &radixDictionary })
+	{
+		ASSERT_EQ(sortedWords.size(), dictionary->wordCount());
+		for (uint32_t wordId = 0; wordId < sortedWords.size(); wordId++)
+		{
+			EXPECT_EQ(wordId, cursorWordId(*dictionary, sortedWords[wordId]));
+			EXPECT_EQ(sortedWords[wordId], dictionary->wordFromId(wordId));
+		}
+	}
+}
+
+
+TEST(Dictionary_Tests, ParallelImportBuildsTheSameTrie)
+{
+	// Arrange
+	string filepath = "Dictionary_Tests_parallel.txt";
+	{
+		/* unsorted, with duplicates, words too short to keep and shared prefixes */
+		ofstream file(filepath);
+		file << "tops\nbanana\nto\nbat\ntop\nbandana\nbat\nquit\nbalatro\nstop\nban\nzoo\n";
+	}
+	auto serialDictionary = Dictionary(1000);
+	auto parallelDictionary = Dictionary(1000);
+	ThreadPool pool(4);
+
+	// Act
+	auto serialStatus = serialDictionary.importDictionary(filepath);
+	auto parallelStatus = parallelDictionary.importDictionary(filepath, pool);
+	serialDictionary.freeze();
+	parallelDictionary.freeze();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, serialStatus);
+	EXPECT_EQ(ErrorCode::SUCCESS, parallelStatus);
+	EXPECT_EQ(serialDictionary.nodeCount(), parallelDictionary.nodeCount());
+	ASSERT_EQ(10, parallelDictionary.wordCount());
+	ASSERT_EQ(serialDictionary.wordCount(), parallelDictionary.wordCount());
+	for (uint32_t wordId = 0; wordId < parallelDictionary.wordCount(); wordId++)
+	{
+		EXPECT_EQ(serialDictionary.wordFromId(wordId), parallelDictionary.wordFromId(wordId));
+	}
+	EXPECT_FALSE(parallelDictionary.searchDictionary("to", SearchType::WORD));
+	EXPECT_TRUE(parallelDictionary.searchDictionary("to", SearchType::PATH));
+
+	remove(filepath.c_str());
+}
+
+
+TEST(Dictionary_Tests, EveryImportLowercasesAndSkipsTheSameWords)
+{
+	// Arrange
+	string filepath = "Dictionary_Tests_case.txt";
+	{
+		ofstream file(filepath);
+		file << "Zoo\r\nbee's\r\nAPPLE\r\nfresh-water\r\ncat";	// no line break at the end
+	}
+	auto serialDictionary = Dictionary(1000);
+	auto parallelDictionary = Dictionary(1000);
+	auto minimizedDictionary = Dictionary(1000);
+	ThreadPool pool(2);
+
+	// Act
+	auto serialStatus = serialDictionary.importDictionary(filepath);
+	auto parallelStatus = parallelDictionary.importDictionary(filepath, pool);
+	auto minimizedStatus = minimizedDictionary.importMinimizedDictionary(filepath);
+	serialDictionary.freeze();
+	parallelDictionary.freeze();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, serialStatus);
+	EXPECT_EQ(ErrorCode::SUCCESS, parallelStatus);
+	EXPECT_EQ(ErrorCode::SUCCESS, minimizedStatus);
+	const vector<string> expected{ "apple", "cat", "zoo" };
+	for (const auto dictionary : { &serialDictionary, &parallelDictionary, &minimizedDictionary })
+	{
+		ASSERT_EQ(expected.size(), dictionary->wordCount());
+		for (uint32_t wordId = 0; wordId < dictionary->wordCount(); wordId++)
+		{
+			EXPECT_EQ(expected[wordId], dictionary->wordFromId(wordId));
+		}
+	}
+
+	remove(filepath.c_str());
+}
+
+
+TEST(Dictionary_Tests, EmptyFileImportsNoWords)
+{
+	// Arrange
+	string filepath = "Dictionary_Tests_empty.txt";
+	{
+		ofstream file(filepath);
+	}
+	auto dictionary = Dictionary(150);
+
+	// Act
+	auto status = dictionary.importDictionary(filepath);
+	dictionary.insertWord("bat");
+	dictionary.freeze();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	EXPECT_EQ(1, dictionary.wordCount());
+
+	remove(filepath.c_str());
+}
+
+
+#ifndef _WIN32
+TEST(Dictionary_Tests, DictionaryCanBeImportedFromAPipe)
+{
+	// Arrange
+	string filepath = "Dictionary_Tests_pipe";
+	remove(filepath.c_str());
+	ASSERT_EQ(0, mkfifo(filepath.c_str(), 0600));
+	thread writer([&filepath]() {
+		ofstream pipe(filepath);	// blocks until the import opens the other end
+		pipe << "bat\nbee\nbees\n";
+	});
+	auto dictionary = Dictionary(150);
+
+	// Act
+	auto status = dictionary.importDictionary(filepath);
+	writer.join();
+	dictionary.freeze();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	EXPECT_EQ(3, dictionary.wordCount());
+	EXPECT_TRUE(dictionary.searchDictionary("bees", SearchType::WORD));
+
+	remove(filepath.c_str());
+}
+#endif
+
+
+TEST(Dictionary_Tests, ChildArenaIsReleasedWhenFrozen)
+{
+	// Arrange
+	auto dictionary = Dictionary(1000);
+	dictionary.insertWord("bat");
+	dictionary.insertWord("bee");
+	ASSERT_EQ(1, dictionary.getChildArena().blockCount());
+	ASSERT_LT(0, dictionary.getChildArena().bytesUsed());
+
+	// Act
+	dictionary.freeze();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(0, dictionary.getChildArena().blockCount());
+	EXPECT_TRUE(dictionary.searchDictionary("bee", SearchType::WORD));
+}
+
+
+TEST(Dictionary_Tests, ParallelImportAddsToInsertedWords)
+{
+	// Arrange
+	string filepath = "Dictionary_Tests_parallel_add.txt";
+	{
+		ofstream file(filepath);
+		file << "bat\nbath\ncat\n";
+	}
+	auto dictionary = Dictionary(1000);
+	dictionary.insertWord("bats");
+	ThreadPool pool(2);
+
+	// Act
+	auto status = dictionary.importDictionary(filepath, pool);
+	dictionary.freeze();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, status);
+	EXPECT_EQ(4, dictionary.wordCount());
+	EXPECT_TRUE(dictionary.searchDictionary("bats", SearchType::WORD));
+	EXPECT_TRUE(dictionary.searchDictionary("bath", SearchType::WORD));
+	EXPECT_EQ(9, dictionary.nodeCount()); // root, b-a-t-h/s, c-a-t
+
+	remove(filepath.c_str());
+}
+
+
+TEST(Dictionary_Tests, ParallelImportOutOfPoolSpaceFailsCorrectly)
+{
+	// Arrange
+	string filepath = "Dictionary_Tests_parallel_full.txt";
+	{
+		ofstream file(filepath);
+		file << "abcd\nabce\n";
+	}
+	auto dictionary = Dictionary(5); // root, a, b, c and one more
+	ThreadPool pool(2);
+
+	// Act
+	auto status = dictionary.importDictionary(filepath, pool);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::OUT_OF_POOL_SPACE, status);
+
+	remove(filepath.c_str());
+}
+
+
+TEST(Dictionary_Tests, CursorKnowsTheWordLengthsBelowItInEveryLayout)
+{
+	// Arrange
+	for (const auto layout : { DictionaryLayout::TRIE, DictionaryLayout::RADIX })
+	{
+		auto dictionary = Dictionary(150);
+		dictionary.insertWord("ant");
+		dictionary.insertWord("antelope");
+		dictionary.insertWord("bats");
+		ASSERT_EQ(ErrorCode::SUCCESS, dictionary.freeze(layout));
+		auto cursor = DictionaryCursor(dictionary);
+
+		// Act
+		auto rootShortest = cursor.shortestRemaining();
+		auto rootLongest = cursor.longestRemaining();
+		cursor.advance('a');
+		cursor.advance('n');
+		cursor.advance('t');
+		auto antShortest = cursor.shortestRemaining();
+		auto antLongest = cursor.longestRemaining();
+		cursor.advance('e');
+		cursor.advance('l');
+		auto antelShortest = cursor.shortestRemaining();	// part way through a radix label
+
+		// Assert (expected, actual)
+		EXPECT_EQ(8, dictionary.longestWord());
+		EXPECT_EQ(3, rootShortest);
+		EXPECT_EQ(8, rootLongest);
+		EXPECT_EQ(0, antShortest);
+		EXPECT_EQ(5, antLongest);
+		EXPECT_EQ(3, antelShortest);
+	}
+}
+
+
 /*
 TEST(Dictionary_Tests, )
 {
@@ -1,69 +1,70 @@
-
 #include "pch.h"
 
+#include <set>
+
 #include "TestDoubles.h"
 
-TEST(LetterNodePool_Tests, PoolIsAllocatedToExpectedSize)
+TEST(LetterNodePool_Tests, PoolStartsWithoutMemory)
 {
 	// Arrange
-	size_t poolSize = 10;
+	size_t nodeLimit = 10;
 
 	// Act
-	auto pool = LetterNodePool_Double(poolSize);
+	auto pool = LetterNodePool_Double(nodeLimit);
 
 	// Assert (expected, actual)
-	EXPECT_EQ(10, pool.getPoolSize());
-	EXPECT_EQ(10, pool.getFreeNodesLeft());
+	EXPECT_EQ(0, pool.getChunkCount());
+	EXPECT_EQ(0, pool.capacity());
+	EXPECT_EQ(10, pool.nodeLimit());
 }
 
 
-TEST(LetterNodePool_Tests, AllocatedNodeRemovesFreeNode)
+TEST(LetterNodePool_Tests, AllocatedNodeAddsTheFirstChunk)
 {
 	// Arrange
-	size_t poolSize = 10;
-	auto pool = LetterNodePool_Double(poolSize);
-	ASSERT_EQ(10, pool.getPoolSize());
-	ASSERT_EQ(10, pool.getFreeNodesLeft());
+	size_t nodeLimit = 10;
+	auto pool = LetterNodePool_Double(nodeLimit);
+	ASSERT_EQ(0, pool.getChunkCount());
 
 	// Act
 	auto node = pool.allocate(); // get 1 node from the pool
 
 	// Assert (expected, actual)
-	EXPECT_EQ(9, pool.getFreeNodesLeft());
 	EXPECT_NE(node, nullptr);
+	EXPECT_EQ(1, pool.getChunkCount());
+	EXPECT_EQ(1, pool.getNodesCreated());
+	EXPECT_EQ(0, pool.getFreeNodesLeft());
 }
 
 
 TEST(LetterNodePool_Tests, NodesGetDeallocatedCorrectly)
 {
 	// Arrange
-	size_t poolSize = 10;
-	auto pool = LetterNodePool_Double(poolSize);
-	ASSERT_EQ(10, pool.getPoolSize());
-	ASSERT_EQ(10, pool.getFreeNodesLeft());
+	size_t nodeLimit = 10;
+	auto pool = LetterNodePool_Double(nodeLimit);
 
 	auto node = pool.allocate(); // get 1 node from the pool
-	ASSERT_EQ(9, pool.getFreeNodesLeft());
+	ASSERT_EQ(0, pool.getFreeNodesLeft());
 	ASSERT_NE(node, nullptr);
 
 	// Act
 	pool.deallocate(node);
+	auto reusedNode = pool.allocate();
 
 	// Assert (expected, actual)
-	EXPECT_EQ(10, pool.getFreeNodesLeft());
+	EXPECT_EQ(node, reusedNode);
+	EXPECT_EQ(1, pool.getNodesCreated());
 }
 
 
-TEST(LetterNodePool_Tests, PoolReturnsNullPointerWhenOutOfFreeSpace)
+TEST(LetterNodePool_Tests, PoolReturnsNullPointerAtNodeLimit)
 {
 	// Arrange
-	size_t poolSize = 1;
-	auto pool = LetterNodePool_Double(poolSize);
-	ASSERT_EQ(1, pool.getPoolSize());
-	ASSERT_EQ(1, pool.getFreeNodesLeft());
+	size_t nodeLimit = 1;
+	auto pool = LetterNodePool_Double(nodeLimit);
 
 	auto node_1 = pool.allocate(); // get 1 node from the pool
-	ASSERT_EQ(0, pool.getFreeNodesLeft());
+	ASSERT_NE(nullptr, node_1);
 
 	// Act
 	auto node_2 = pool.allocate(); // get 1 node from the pool
@@ -73,6 +74,99 @@ TEST(LetterNodePool_Tests, PoolReturnsNullPointerWhenOutOfFreeSpace)
 }
 
 
+TEST(LetterNodePool_Tests, PoolGrowsWithoutMovingNodes)
+{
+	// Arrange
+	auto pool = LetterNodePool_Double();
+	auto firstNode = pool.allocate();
+	firstNode->m_isWordValid = true;
+
+	// Act
+	set<LetterNode*> nodes{ firstNode };
+	for (size_t i = 0; i < LetterNodePool::CHUNK_SIZE; i++)
+	{
+		nodes.insert(pool.allocate());
+	}
+
+	// Assert (expected, actual)
+	EXPECT_LT(size_t{ 1 }, pool.getChunkCount());
+	EXPECT_EQ(LetterNodePool::CHUNK_SIZE + 1, nodes.size());	// every node is distinct
+	EXPECT_EQ(0, nodes.count(nullptr));
+	EXPECT_TRUE(firstNode->m_isWordValid);
+}
+
+
+TEST(LetterNodePool_Tests, ReserveAllocatesChunksUpToTheNodeLimit)
+{
+	// Arrange
+	auto unlimitedPool = LetterNodePool_Double();
+	auto limitedPool = LetterNodePool_Double(10);
+
+	// Act
+	unlimitedPool.reserve(LetterNodePool::CHUNK_SIZE + 1);
+	limitedPool.reserve(LetterNodePool::CHUNK_SIZE + 1);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(2, unlimitedPool.getChunkCount());
+	EXPECT_EQ(0, unlimitedPool.getNodesCreated());
+	EXPECT_EQ(1, limitedPool.getChunkCount());
+}
+
+
+TEST(LetterNodePool_Tests, SmallPoolsDontTakeAHugePage)
+{
+	// Arrange
+	auto growingPool = LetterNodePool_Double();
+	auto reservedPool = LetterNodePool_Double();
+
+	// Act
+	growingPool.allocate();
+	reservedPool.reserve(100);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(LetterNodePool::FIRST_CHUNK_SIZE, growingPool.capacity());
+	EXPECT_EQ(1, reservedPool.getChunkCount());
+	EXPECT_EQ(100, reservedPool.capacity());
+}
+
+
+TEST(LetterNodePool_Tests, RegionMixesFreedAndNewNodes)
+{
+	// Arrange
+	auto pool = LetterNodePool_Double(4);
+	auto node = pool.allocate();
+	pool.deallocate(node);
+	vector<LetterNode*> region{};
+
+	// Act
+	const auto allocated = pool.allocateRegion(3, region);
+	const auto overLimit = pool.allocateRegion(2, region);
+
+	// Assert (expected, actual)
+	EXPECT_TRUE(allocated);
+	EXPECT_FALSE(overLimit);
+	ASSERT_EQ(3, region.size());
+	EXPECT_EQ(node, region[0]);
+	EXPECT_EQ(3, pool.getNodesCreated());
+}
+
+
+
+TEST(LetterNodePool_Tests, FreedNodesAreNotInUse)
+{
+	// Arrange
+	LetterNodePool pool{};
+	auto first = pool.allocate();
+	pool.allocate();
+	pool.allocate();
+
+	// Act
+	pool.deallocate(first);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(2, pool.nodesInUse());
+}
+
 /*
 TEST(LetterNodePool_Tests, )
 {
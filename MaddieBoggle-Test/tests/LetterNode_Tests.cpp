@@ -1,12 +1,15 @@
 #include "pch.h"
 
+#include <algorithm>
+
+
 TEST(LetterNode_Tests, CantFindMissingChild)
 {
 	// Arrange
 	auto node_1 = LetterNode();
 
 	// Act
-	ASSERT_TRUE(node_1.m_childLetters.empty());
+	ASSERT_TRUE(node_1.childCount() == 0);
 	auto node_2 = node_1.findChild('d');
 
 	// Assert (expected, actual)
@@ -22,12 +25,12 @@ TEST(LetterNode_Tests, AddChildToEmptyPool)
 	char letter = 'd';
 
 	// Act
-	ASSERT_TRUE(node_1.m_childLetters.empty());
+	ASSERT_TRUE(node_1.childCount() == 0);
 	node_1.insertChild(letter, &node_2);
 
 	// Assert (expected, actual)
-	EXPECT_EQ(1, node_1.m_childLetters.size());
-	EXPECT_EQ(letter, node_1.m_childLetters[0].first);
+	EXPECT_EQ(1, node_1.childCount());
+	EXPECT_EQ(letter, node_1.childLetter(0));
 }
 
 
@@ -37,17 +40,17 @@ TEST(LetterNode_Tests, GetChildIfItExists)
 	auto node_1 = LetterNode();
 	auto node_2 = LetterNode();
 
-	node_2.m_childLetters.emplace_back('c', nullptr); // give node_2 a "node" assigned to the char 'c'
+	node_2.insertChild('c', nullptr); // give node_2 a "node" assigned to the char 'c'
 	char letter = 'd';
 
-	ASSERT_TRUE(node_1.m_childLetters.empty());
+	ASSERT_TRUE(node_1.childCount() == 0);
 	node_1.insertChild(letter, &node_2);			  // now give node_1 a pair of char 'd' assigned to node_2	
 
 	// Act
 	auto node_3 = node_1.findChild(letter);           // the node 3 we got should actually be node 2
 
 	// Assert (expected, actual)
-	EXPECT_EQ('c', node_3->m_childLetters[0].first);
+	EXPECT_EQ('c', node_3->childLetter(0));
 }
 
 
@@ -67,32 +70,32 @@ TEST(LetterNode_Tests, ChildrenRemainInAscendingOrderWhenAdded)
 	*/
 
 	// Act 1 - first node should be assigned to 'd' since it's the only one
-	ASSERT_TRUE(node_1.m_childLetters.empty());
+	ASSERT_TRUE(node_1.childCount() == 0);
 	node_1.insertChild('d', &node_2);
-	ASSERT_TRUE(node_1.m_childLetters.size() == 1);
+	ASSERT_TRUE(node_1.childCount() == 1);
 	
 	// Assert (expected, actual)
-	EXPECT_EQ('d', node_1.m_childLetters[0].first);
+	EXPECT_EQ('d', node_1.childLetter(0));
 
 
 	// Act 2 - first node should be assigned to 'c' since it's comes before 'd', even though
 	// it was added afterwards
 	node_1.insertChild('c', &node_3);
-	ASSERT_TRUE(node_1.m_childLetters.size() == 2);
+	ASSERT_TRUE(node_1.childCount() == 2);
 
 	// Assert (expected, actual)
-	EXPECT_EQ('c', node_1.m_childLetters[0].first);
-	EXPECT_EQ('d', node_1.m_childLetters[1].first);
+	EXPECT_EQ('c', node_1.childLetter(0));
+	EXPECT_EQ('d', node_1.childLetter(1));
 
 
 	// Act 3 - 'e' should be added at the end since it comes after 'c' and 'd'
 	node_1.insertChild('e', &node_3);
-	ASSERT_TRUE(node_1.m_childLetters.size() == 3);
+	ASSERT_TRUE(node_1.childCount() == 3);
 
 	// Assert (expected, actual)
-	EXPECT_EQ('c', node_1.m_childLetters[0].first);
-	EXPECT_EQ('d', node_1.m_childLetters[1].first);
-	EXPECT_EQ('e', node_1.m_childLetters[2].first);
+	EXPECT_EQ('c', node_1.childLetter(0));
+	EXPECT_EQ('d', node_1.childLetter(1));
+	EXPECT_EQ('e', node_1.childLetter(2));
 }
 
 
@@ -102,19 +105,70 @@ TEST(LetterNode_Tests, DuplicateChildrenAreNotAdded)
 	auto node_1 = LetterNode();
 	
 	auto node_2 = LetterNode();
-	node_2.m_childLetters.emplace_back('f', nullptr); // node 2 given an f in its vector
+	node_2.insertChild('f', nullptr); // node 2 given an f in its vector
 	
 	auto node_3 = LetterNode();
-	node_3.m_childLetters.emplace_back('g', nullptr); // node 3 given a g in its vector
+	node_3.insertChild('g', nullptr); // node 3 given a g in its vector
 
 	// Act
-	ASSERT_TRUE(node_1.m_childLetters.empty());
+	ASSERT_TRUE(node_1.childCount() == 0);
 	node_1.insertChild('d', &node_2);
 	node_1.insertChild('d', &node_3);
 
 	// Assert (expected, actual)
-	EXPECT_EQ(1, node_1.m_childLetters.size());		// node_3 won't be added because 'd' is a duplicate
-	EXPECT_EQ('f', node_1.m_childLetters[0].second->m_childLetters[0].first); // the one node in here will be node 2 with an assigned 'f' char
+	EXPECT_EQ(1, node_1.childCount());		// node_3 won't be added because 'd' is a duplicate
+	EXPECT_EQ('f', node_1.childNode(0)->childLetter(0)); // the one node in here will be node 2 with an assigned 'f' char
+}
+
+
+TEST(LetterNode_Tests, WideFanOutFindsEveryChild)
+{
+	// Arrange
+	auto root = LetterNode();
+	vector<LetterNode> children(40);
+	const string letters{ "zyxwvutsrqponmlkjihgfedcba-'" };	// more than two blocks of 16, inserted backwards
+
+	// Act
+	for (size_t i = 0; i < letters.size(); i++)
+	{
+		root.insertChild(letters[i], &children[i]);
+	}
+
+	// Assert (expected, actual)
+	ASSERT_EQ(letters.size(), root.childCount());
+	EXPECT_TRUE(is_sorted(root.childLetters(), root.childLetters() + root.childCount()));
+	for (size_t i = 0; i < letters.size(); i++)
+	{
+		EXPECT_EQ(&children[i], root.findChild(letters[i])) << letters[i];
+	}
+	EXPECT_EQ(nullptr, root.findChild('A'));
+	EXPECT_EQ(nullptr, root.findChild('{'));
+	EXPECT_EQ(nullptr, root.findChild('\0'));
+}
+
+
+TEST(LetterNode_Tests, ChildPositionIsTheLowerBound)
+{
+	// Arrange
+	auto node = LetterNode();
+	for (char letter = 'a'; letter < 'a' + 16; letter++)
+	{
+		node.insertChild(letter, nullptr);	// exactly one block of 16, 'a' to 'p'
+	}
+
+	// Act
+	auto first = node.childPosition('a');
+	auto middle = node.childPosition('h');
+	auto last = node.childPosition('p');
+	auto pastTheEnd = node.childPosition('z');
+	auto beforeAll = node.childPosition('-');
+
+	// Assert (expected, actual)
+	EXPECT_EQ(0, first);
+	EXPECT_EQ(7, middle);
+	EXPECT_EQ(15, last);
+	EXPECT_EQ(16, pastTheEnd);
+	EXPECT_EQ(0, beforeAll);
 }
 
 
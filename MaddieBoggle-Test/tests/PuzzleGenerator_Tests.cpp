@@ -0,0 +1,169 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+
+
+// Matches every letter from position cell on to a different unused die that has it on a face.
+static bool matchDice(const string& letters, size_t cell, const vector<string>& dice, vector<bool>& used)
+{
+	if (cell == letters.size()) return true;
+	for (size_t die = 0; die < dice.size(); die++)
+	{
+		if (used[die] || (dice[die].find(letters[cell]) == string::npos)) continue;
+		used[die] = true;
+		if (matchDice(letters, cell + 1, dice, used)) return true;
+		used[die] = false;
+	}
+	return false;
+}
+
+
+TEST(PuzzleGenerator_Tests, SameSeedMakesTheSamePuzzles)
+{
+	// Arrange
+	PuzzleGenerator first(7);
+	PuzzleGenerator second(7);
+	PuzzleGenerator other(8);
+
+	// Act
+	auto firstBoard = first.generateBoard(10, 12);
+	auto firstWords = first.generateWords(100);
+	auto secondBoard = second.generateBoard(10, 12);
+	auto secondWords = second.generateWords(100);
+	auto otherBoard = other.generateBoard(10, 12);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(firstBoard, secondBoard);
+	EXPECT_EQ(firstWords, secondWords);
+	EXPECT_NE(firstBoard, otherBoard);
+}
+
+
+TEST(PuzzleGenerator_Tests, ClassicBoardRollsEveryDieOnce)
+{
+	// Arrange
+	const vector<string> classicDice{
+		"aaeegn", "abbjoo", "achops", "affkps", "aoottw", "cimotu", "deilrx", "delrvy",
+		"distty", "eeghnw", "eeinsu", "ehrtvw", "eiosst", "elrtty", "himnuq", "hlnnrz" };
+	PuzzleGenerator generator(2025);
+
+	// Act
+	auto board = generator.generateBoard(4, 4);
+
+	// Assert (expected, actual)
+	ASSERT_EQ(4, board.size());
+	string letters{};
+	for (const auto& row : board)
+	{
+		EXPECT_EQ(4, row.size());
+		letters.append(row.begin(), row.end());
+	}
+
+	vector<bool> used(classicDice.size(), false);
+	EXPECT_TRUE(matchDice(letters, 0, classicDice, used));
+}
+
+
+TEST(PuzzleGenerator_Tests, RaggedRowsStayWithinBounds)
+{
+	// Arrange
+	PuzzleGenerator generator(11);
+
+	// Act
+	auto board = generator.generateRaggedBoard(40, 3, 9);
+
+	// Assert (expected, actual)
+	ASSERT_EQ(40, board.size());
+	set<size_t> lengths{};
+	for (const auto& row : board)
+	{
+		EXPECT_LE(3, row.size());
+		EXPECT_GE(9, row.size());
+		EXPECT_TRUE(all_of(row.begin(), row.end(), [](char letter) { return (letter >= 'a') && (letter <= 'z'); }));
+		lengths.insert(row.size());
+	}
+	EXPECT_LT(1, lengths.size());
+}
+
+
+TEST(PuzzleGenerator_Tests, WordsAreDistinctSortedAndOfWeightedLengths)
+{
+	// Arrange
+	PuzzleGenerator generator(3);
+	const vector<double> lengthWeights{ 0, 0, 0, 0, 1, 0, 1 };	// only 4 and 6 letters
+
+	// Act
+	auto words = generator.generateWords(500, lengthWeights);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(500, words.size());
+	EXPECT_TRUE(is_sorted(words.begin(), words.end()));
+	EXPECT_EQ(words.end(), adjacent_find(words.begin(), words.end()));
+	for (const auto& word : words)
+	{
+		EXPECT_TRUE((word.size() == 4) || (word.size() == 6)) << word;
+	}
+}
+
+
+TEST(PuzzleGenerator_Tests, WordsStopWhenLengthsRunOut)
+{
+	// Arrange
+	PuzzleGenerator generator(5);
+	const vector<double> lengthWeights{ 0, 1 };	// only 26 one letter words exist
+
+	// Act
+	auto words = generator.generateWords(100, lengthWeights);
+
+	// Assert (expected, actual)
+	EXPECT_GE(26, words.size());
+	EXPECT_LT(0, words.size());
+}
+
+
+TEST(PuzzleGenerator_Tests, WrittenPuzzlesImportBack)
+{
+	// Arrange
+	PuzzleGenerator generator(13);
+	auto board = generator.generateRaggedBoard(6, 2, 5);
+	auto words = generator.generateWords(50);
+
+	// Act
+	auto boardWritten = PuzzleGenerator::writeBoard(board, "PuzzleGenerator_Tests_board.txt");
+	auto wordsWritten = PuzzleGenerator::writeWords(words, "PuzzleGenerator_Tests_words.txt");
+	BoggleBoard imported{};
+	auto boardImported = importBoard("PuzzleGenerator_Tests_board.txt", imported);
+	Dictionary dictionary{};
+	auto wordsImported = dictionary.importDictionary("PuzzleGenerator_Tests_words.txt");
+
+	// Assert (expected, actual)
+	EXPECT_EQ(ErrorCode::SUCCESS, boardWritten);
+	EXPECT_EQ(ErrorCode::SUCCESS, wordsWritten);
+	EXPECT_EQ(ErrorCode::SUCCESS, boardImported);
+	EXPECT_EQ(ErrorCode::SUCCESS, wordsImported);
+	EXPECT_EQ(board, imported);
+	for (const auto& word : words)
+	{
+		EXPECT_TRUE(dictionary.searchDictionary(word, SearchType::WORD)) << word;
+	}
+
+	remove("PuzzleGenerator_Tests_board.txt");
+	remove("PuzzleGenerator_Tests_words.txt");
+}
+
+
+/*
+TEST(PuzzleGenerator_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
@@ -0,0 +1,82 @@
+#include "pch.h"
+
+#include <sstream>
+
+
+TEST(StatsReport_Tests, StartingAPhaseEndsTheLastOne)
+{
+	// Arrange
+	StatsReport stats{};
+
+	// Act
+	stats.startPhase("import");
+	stats.startPhase("solve");
+	stats.endPhase();
+	stats.endPhase();	// nothing left to end
+
+	// Assert (expected, actual)
+	ASSERT_EQ(2, stats.getPhases().size());
+	EXPECT_EQ("import", stats.getPhases()[0].first);
+	EXPECT_EQ("solve", stats.getPhases()[1].first);
+	EXPECT_LE(0.0, stats.getPhases()[0].second);
+}
+
+
+TEST(StatsReport_Tests, TextReportListsEverything)
+{
+	// Arrange
+	StatsReport stats{};
+	stats.startPhase("solve");
+	stats.endPhase();
+	stats.addCounter("pruned_paths", 42);
+	stats.setWorkers({ { 4, 1.5, 1.0 } });
+	stringstream output{};
+
+	// Act
+	stats.write(output, StatsFormat::TEXT);
+
+	// Assert (expected, actual)
+	const auto text = output.str();
+	EXPECT_NE(string::npos, text.find("solve"));
+	EXPECT_NE(string::npos, text.find("total"));
+	EXPECT_NE(string::npos, text.find("pruned_paths"));
+	EXPECT_NE(string::npos, text.find("42"));
+	EXPECT_NE(string::npos, text.find("1.500"));
+	EXPECT_NE(string::npos, text.find("0.250"));	// mean queue wait of the 4 tasks
+}
+
+
+TEST(StatsReport_Tests, JsonReportKeysByName)
+{
+	// Arrange
+	StatsReport stats{};
+	stats.addCounter("dfs_nodes_expanded", 7);
+	stats.addCounter("pruned_paths", 4);
+	stats.setWorkers({ { 2, 1.5, 0.5 }, { 0, 0.0, 0.0 } });
+	stringstream output{};
+
+	// Act
+	stats.write(output, StatsFormat::JSON);
+
+	// Assert (expected, actual)
+	const auto json = output.str();
+	EXPECT_NE(string::npos, json.find("\"phases_ms\": { }"));
+	EXPECT_NE(string::npos, json.find("\"counters\": { \"dfs_nodes_expanded\": 7, \"pruned_paths\": 4 }"));
+	EXPECT_NE(string::npos, json.find("{ \"tasks\": 2, \"busy_ms\": 1.500, \"queue_wait_ms\": 0.500, \"mean_queue_wait_ms\": 0.250 },"));
+	EXPECT_NE(string::npos, json.find("{ \"tasks\": 0, \"busy_ms\": 0.000, \"queue_wait_ms\": 0.000, \"mean_queue_wait_ms\": 0.000 }\n  ]\n}"));
+}
+
+
+/*
+TEST(StatsReport_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
@@ -0,0 +1,148 @@
+#include "pch.h"
+
+#include <chrono>
+#include <thread>
+
+
+TEST(ThreadPool_Tests, EveryTaskRunsInBothModes)
+{
+	for (const auto scheduling : { TaskScheduling::SHARED_QUEUE, TaskScheduling::WORK_STEALING })
+	{
+		// Arrange
+		ThreadPool pool(4, scheduling);
+		atomic<size_t> tasksRun{ 0 };
+
+		// Act
+		for (size_t i = 0; i < 1000; i++)
+		{
+			pool.queueTask([&tasksRun]() { tasksRun++; });
+		}
+		pool.waitForCompletion();
+
+		// Assert (expected, actual)
+		EXPECT_EQ(1000, tasksRun.load());
+	}
+}
+
+
+TEST(ThreadPool_Tests, TasksQueuedByATaskAreWaitedFor)
+{
+	// Arrange
+	ThreadPool pool(4, TaskScheduling::WORK_STEALING);
+	atomic<size_t> tasksRun{ 0 };
+
+	// Act
+	for (size_t i = 0; i < 10; i++)
+	{
+		pool.queueTask([&pool, &tasksRun]() {
+			/* queued from inside the pool, so onto this worker's own deque */
+			for (size_t j = 0; j < 10; j++)
+			{
+				pool.queueTask([&tasksRun]() { tasksRun++; });
+			}
+		});
+	}
+	pool.waitForCompletion();
+
+	// Assert (expected, actual)
+	EXPECT_EQ(100, tasksRun.load());
+}
+
+
+TEST(ThreadPool_Tests, IdleWorkerStealsTasksOfABusyWorker)
+{
+	// Arrange
+	ThreadPool pool(2, TaskScheduling::WORK_STEALING);
+	atomic<size_t> tasksRun{ 0 };
+	atomic<bool> allRun{ false };
+
+	// Act
+	pool.queueTask([&pool, &tasksRun, &allRun]() {
+		/* these land on the running worker's own deque, which stays busy
+		until they are done, so only the other worker can run them */
+		for (size_t i = 0; i < 10; i++)
+		{
+			pool.queueTask([&tasksRun]() { tasksRun++; });
+		}
+
+		const auto deadline = chrono::steady_clock::now() + chrono::seconds(5);
+		while ((tasksRun.load() < 10) && (chrono::steady_clock::now() < deadline))
+		{
+			this_thread::yield();
+		}
+		allRun = (tasksRun.load() == 10);
+	});
+	pool.waitForCompletion();
+
+	// Assert (expected, actual)
+	EXPECT_TRUE(allRun.load());
+	EXPECT_LE(10, pool.stolenTasks()); // the outer task may have been stolen as well
+}
+
+
+
+TEST(ThreadPool_Tests, WorkerStatsAreOnlyCollectedWhenEnabled)
+{
+	for (const auto scheduling : { TaskScheduling::SHARED_QUEUE, TaskScheduling::WORK_STEALING })
+	{
+		// Arrange
+		ThreadPool pool(2, scheduling);
+		auto sleep = []() { this_thread::sleep_for(chrono::milliseconds(2)); };
+		pool.queueTask(sleep);
+		pool.waitForCompletion();
+
+		// Act
+		pool.setCollectStats(true);
+		for (size_t i = 0; i < 10; i++)
+		{
+			pool.queueTask(sleep);
+		}
+		pool.waitForCompletion();
+		auto stats = pool.getWorkerStats();
+
+		// Assert (expected, actual)
+		ASSERT_EQ(2, stats.size());
+		EXPECT_EQ(10, stats[0].m_tasksRun + stats[1].m_tasksRun);
+		EXPECT_LE(20.0, stats[0].m_busyMilliseconds + stats[1].m_busyMilliseconds);
+		EXPECT_LT(0.0, stats[0].m_queueWaitMilliseconds + stats[1].m_queueWaitMilliseconds); // 10 tasks, 2 workers
+	}
+}
+
+TEST(ThreadPool_Tests, WorkersOnlyHaveAnIndexInTheirOwnPool)
+{
+	for (const auto scheduling : { TaskScheduling::SHARED_QUEUE, TaskScheduling::WORK_STEALING })
+	{
+		// Arrange
+		ThreadPool pool(2, scheduling);
+		ThreadPool otherPool(2, scheduling);
+		atomic<size_t> ownIndex{ ThreadPool::NOT_A_WORKER };
+		atomic<size_t> otherIndex{ 0 };
+
+		// Act
+		pool.queueTask([&]() {
+			ownIndex = pool.workerIndex();
+			otherIndex = otherPool.workerIndex();
+		});
+		pool.waitForCompletion();
+
+		// Assert (expected, actual)
+		EXPECT_LT(ownIndex.load(), pool.threadCount());
+		EXPECT_EQ(ThreadPool::NOT_A_WORKER, otherIndex.load());
+		EXPECT_EQ(ThreadPool::NOT_A_WORKER, pool.workerIndex());
+	}
+}
+
+
+/*
+TEST(ThreadPool_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
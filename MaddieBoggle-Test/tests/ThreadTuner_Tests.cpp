@@ -0,0 +1,65 @@
+#include "pch.h"
+
+
+const vector<vector<char>> board{
+	{'p','w','y','r'},
+	{'e','n','t','h'},
+	{'g','s','i','q'},
+	{'o','l','s','a'}
+};
+
+
+TEST(ThreadTuner_Tests, ThreadCandidatesArePowersOfTwoUpToMax)
+{
+	// Arrange Act
+	auto candidates_1 = ThreadTuner::threadCandidates(1);
+	auto candidates_6 = ThreadTuner::threadCandidates(6);
+	auto candidates_8 = ThreadTuner::threadCandidates(8);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(vector<size_t>({ 1 }), candidates_1);
+	EXPECT_EQ(vector<size_t>({ 1, 2, 4, 6 }), candidates_6);
+	EXPECT_EQ(vector<size_t>({ 1, 2, 4, 8 }), candidates_8);
+}
+
+
+TEST(ThreadTuner_Tests, EveryCombinationIsMeasuredAndTheFastestPicked)
+{
+	// Arrange
+	auto dictionary = make_unique<Dictionary>(1000);
+	dictionary->insertWord("pen");
+	dictionary->insertWord("peg");
+	dictionary->insertWord("sit");
+	dictionary->freeze();
+	auto safeDictionary = shared_ptr<const Dictionary>(move(dictionary));
+	ThreadTuner tuner(safeDictionary, board, TaskScheduling::WORK_STEALING, {}, false, SearchEngine::AUTO, 2);
+
+	// Act
+	auto best = tuner.tune();
+
+	// Assert (expected, actual)
+	const auto& results = tuner.getResults();
+	ASSERT_EQ(2 * BoggleSolver::MAX_SPLIT_DEPTH, results.size()); // thread counts 1 and 2
+	for (const auto& result : results)
+	{
+		EXPECT_LE(best.m_milliseconds, result.m_milliseconds);
+	}
+	EXPECT_GE(size_t{ 2 }, best.m_threadCount);
+	EXPECT_LE(size_t{ 1 }, best.m_splitDepth);
+	EXPECT_GE(size_t{ BoggleSolver::MAX_SPLIT_DEPTH }, best.m_splitDepth);
+}
+
+
+/*
+TEST(ThreadTuner_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
@@ -0,0 +1,127 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <sstream>
+
+
+// Every word the scanner finds in text, as strings.
+static vector<string> scanAll(const string& text, size_t& skipped)
+{
+	WordScanner scanner(text.data(), text.size());
+	vector<string> words{};
+	WordView word{};
+	while (scanner.next(word))
+	{
+		words.emplace_back(word.m_data, word.m_length);
+	}
+	skipped = scanner.skippedWords();
+	return words;
+}
+
+
+TEST(WordScanner_Tests, SplitsOnWhitespaceLikeAStream)
+{
+	// Arrange
+	const string text{ "  bat\tbee\r\ncat\n\n\vdog\f  eel" };
+	istringstream stream(text);
+	vector<string> expected{};
+	string streamed{};
+	while (stream >> streamed) expected.push_back(streamed);
+	size_t skipped{ 0 };
+
+	// Act
+	auto words = scanAll(text, skipped);
+
+	// Assert (expected, actual)
+	EXPECT_EQ(expected, words);
+	EXPECT_EQ(0, skipped);
+}
+
+
+TEST(WordScanner_Tests, WordsPointIntoTheText)
+{
+	// Arrange
+	const string text{ "lowercase\n" };
+	WordScanner scanner(text.data(), text.size());
+	WordView word{};
+
+	// Act
+	auto found = scanner.next(word);
+	auto foundAgain = scanner.next(word);
+
+	// Assert (expected, actual)
+	EXPECT_TRUE(found);
+	EXPECT_FALSE(foundAgain);
+	EXPECT_EQ(text.data(), word.m_data);
+	EXPECT_EQ(9, word.m_length);
+}
+
+
+TEST(WordScanner_Tests, LowercasesAndSkipsOtherCharacters)
+{
+	// Arrange, long words cross the 16 byte blocks
+	const string text{ "Apple\nbee's\r\nCAT fresh-water\nabcdefghijklmnopqrstuvwxyz\nabcdefghijklmnopQ\nabcdefghijklmnop1\n\xE9t\xE9" };
+	size_t skipped{ 0 };
+
+	// Act
+	auto words = scanAll(text, skipped);
+
+	// Assert (expected, actual)
+	const vector<string> expected{ "apple", "cat", "abcdefghijklmnopqrstuvwxyz", "abcdefghijklmnopq" };
+	EXPECT_EQ(expected, words);
+	EXPECT_EQ(4, skipped);
+}
+
+
+TEST(WordScanner_Tests, EmptyTextHasNoWords)
+{
+	// Arrange
+	WordScanner scanner(nullptr, 0);
+	WordView word{};
+
+	// Act
+	auto found = scanner.next(word);
+
+	// Assert (expected, actual)
+	EXPECT_FALSE(found);
+	EXPECT_EQ(0, scanner.skippedWords());
+}
+
+
+TEST(WordScanner_Tests, ViewsSortLikeStrings)
+{
+	// Arrange
+	const string text{ "bat ba batter a bats" };
+	size_t skipped{ 0 };
+	auto expected = scanAll(text, skipped);
+	WordScanner scanner(text.data(), text.size());
+	vector<WordView> views{};
+	WordView word{};
+	while (scanner.next(word)) views.push_back(word);
+
+	// Act
+	sort(views.begin(), views.end());
+	sort(expected.begin(), expected.end());
+
+	// Assert (expected, actual)
+	ASSERT_EQ(expected.size(), views.size());
+	for (size_t i = 0; i < views.size(); i++)
+	{
+		EXPECT_EQ(expected[i], string(views[i].m_data, views[i].m_length));
+	}
+}
+
+
+/*
+TEST(WordScanner_Tests, )
+{
+	// Arrange
+
+
+	// Act
+
+
+	// Assert (expected, actual)
+
+}
+*/
@@ -0,0 +1,91 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef ANSWER_WRITER_H
+#define ANSWER_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "CompiledTrie.h"
+#include "ErrorCodes.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// Format AnswerWriter writes the answers of a board in.
+/// </summary>
+enum class AnswerFormat
+{
+    TEXT,           // one word per line
+    JSON,           // a single JSON object with the count and the words
+    WORD_IDS,       // binary, the dictionary word id of every word
+    FRONT_CODED     // binary, every word as what it doesn't share with the word before it
+};
+
+
+/// <summary>
+/// The AnswerWriter class writes the sorted answers of a board to a file, to stdout
+/// or to a file descriptor that is already open. Everything goes through a single
+/// BUFFER_SIZE buffer that is only written out when it is full and once all the
+/// answers are in, so a board with tens of thousands of answers takes a handful of
+/// writes instead of one per answer.
+///
+///   TEXT          bat\n  bath\n  bats\n
+///   JSON          { "count": 3, "answers": [ "bat", "bath", "bats" ] }
+///   WORD_IDS      "MBID" count  id  gap  gap ...
+///   FRONT_CODED   "MBFC" count  (shared, length, letters) per word:  0 3 bat, 3 1 h, 3 1 s
+///
+/// The binary formats start with their four letter tag, and every number is an
+/// unsigned LEB128 varint (7 bits per byte, low bits first, the high bit set on all
+/// but the last byte), so they have no byte order. Word ids are the ones of the
+/// dictionary's compiled trie (see DictionaryCursor::wordId()), which are numbered
+/// in sorted word order, so only the first id is written as is and every other
+/// one as the gap to the id before it.
+///
+/// Answers only ever hold 'a'-'z', so the JSON strings need no escaping.
+/// </summary>
+class AnswerWriter
+{
+public:
+    static constexpr size_t BUFFER_SIZE{ 64 * 1024 };
+    static constexpr int NO_DESCRIPTOR{ -1 };
+
+    explicit AnswerWriter(AnswerFormat format = AnswerFormat::TEXT);
+    ~AnswerWriter();
+    AnswerWriter(const AnswerWriter&) = delete;
+    AnswerWriter& operator=(const AnswerWriter&) = delete;
+
+    static bool parseFormat(const string& name, AnswerFormat& format);
+    static string fileExtension(AnswerFormat format);
+
+    ErrorCode open(const string& filepath);
+    void attach(int descriptor);
+    ErrorCode write(const set<string>& answers, const CompiledTrie& dictionary);
+    ErrorCode close();
+
+    AnswerFormat getFormat() const { return m_format; }
+    bool isOpen() const { return m_descriptor != NO_DESCRIPTOR; }
+
+private:
+    AnswerFormat m_format;
+    int m_descriptor;           // descriptor written to, NO_DESCRIPTOR if none
+    bool m_ownsDescriptor;      // only descriptors opened by open(...) are closed
+    bool m_failed;              // a write failed, everything after it is dropped
+    vector<char> m_buffer;      // BUFFER_SIZE bytes
+    size_t m_used;              // bytes of m_buffer waiting to be written
+
+    void put(const char* data, size_t size);
+    void put(const string& text) { put(text.data(), text.size()); }
+    void putVarint(uint64_t value);
+    void flush();
+};
+
+
+#endif // ANSWER_WRITER_H
@@ -0,0 +1,89 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef BATCH_SOLVER_H
+#define BATCH_SOLVER_H
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "AnswerWriter.h"
+#include "BoggleSolver.h"
+#include "Dictionary.h"
+#include "ErrorCodes.h"
+#include "ThreadPool.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// A single board of a batch and where its answers are written.
+/// </summary>
+struct BatchEntry
+{
+    string m_boardPath;
+    string m_outputPath;
+};
+
+
+/// <summary>
+/// Outcome of solving a single board of a batch.
+/// </summary>
+struct BatchResult
+{
+    ErrorCode m_errorCode;      // SUCCESS unless the board could not be imported or its answers written
+    size_t m_wordCount;         // number of words found on the board
+    double m_milliseconds;      // wall time to import, solve and export the board
+    SearchStats m_search;       // search statistics of the board, see BoggleSolver
+};
+
+
+/// <summary>
+/// The BatchSolver class solves many boards one after the other against a single
+/// dictionary and thread pool. The dictionary is imported and the threads are
+/// started once for the whole batch instead of once per board.
+///
+/// Boards can be added one by one, or collected from either:
+/// - a directory, where every file is a board
+/// - a manifest file listing one board path per line (relative paths are relative
+///   to the manifest, empty lines and lines starting with '#' are skipped)
+///
+/// Each board's answers are written to their own file, in the format of the batch
+/// (see AnswerWriter). A board that fails to import
+/// is reported and skipped, the rest of the batch still runs.
+/// </summary>
+class BatchSolver
+{
+public:
+    BatchSolver(shared_ptr<const Dictionary> dictionary, shared_ptr<ThreadPool> pool, size_t splitDepth = BoggleSolver::MAX_SPLIT_DEPTH,
+        WordLengthRange lengths = {}, bool useBoardTrie = false, SearchEngine engine = SearchEngine::AUTO, AnswerFormat format = AnswerFormat::TEXT);
+
+    static ErrorCode listBoards(const string& boardsPath, const string& outputDirectory, vector<BatchEntry>& entries,
+        AnswerFormat format = AnswerFormat::TEXT);
+    ErrorCode collectBoards(const string& boardsPath, const string& outputDirectory);
+    void addBoard(const string& boardPath, const string& outputPath);
+    ErrorCode solveAll(ostream& log);
+
+    const vector<BatchEntry>& getEntries() const { return m_entries; }
+    const vector<BatchResult>& getResults() const { return m_results; }
+
+private:
+    shared_ptr<const Dictionary> m_dictionary;  // thread safe dictionary shared by every board
+    shared_ptr<ThreadPool> m_pool;              // access to execution threads
+    const size_t m_splitDepth;                  // see BoggleSolver
+    const WordLengthRange m_lengths;            // lengths of the words to find on every board
+    const bool m_useBoardTrie;                  // see BoggleSolver
+    const SearchEngine m_engine;                // engine of every board's solver, AUTO picks one per board
+    const AnswerFormat m_format;                // format of every answer file
+    vector<BatchEntry> m_entries;               // boards to solve, in order
+    vector<BatchResult> m_results;              // one result per entry once solveAll(...) has run
+
+    BatchResult solveBoard(const BatchEntry& entry);
+};
+
+
+#endif // BATCH_SOLVER_H
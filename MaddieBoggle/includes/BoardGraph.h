@@ -0,0 +1,106 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef BOARD_GRAPH_H
+#define BOARD_GRAPH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "BoggleBoard.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// The BoardGraph class is a flattened, read-only view of a BoggleBoard that is
+/// built once per board before any searching starts. Every character node on the
+/// board is given a cell index (row by row, left to right), and the adjacent cells
+/// of every cell are precomputed into a flat table.
+///
+///   board          cell indexes
+///   { a, b, c }    { 0, 1, 2 }
+///   { d, e    }    { 3, 4    }
+///
+/// Neighbours are stored in a fixed direction order (see BoggleSolverHelper.h for
+/// the directions and the rules used for asymetrical boards):
+///   up, up_right, right, down_right, down, down_left, up_left, left
+/// so the search visits neighbours in the same order on every run.
+///
+/// The cells are also indexed by letter, so the cells holding a letter can be
+/// listed without scanning the board:
+///
+///   cellsWithLetter('a')  --> { 0 }
+///
+/// Nothing in this class changes after construction, so it can be shared between
+/// any number of searching threads.
+/// </summary>
+class BoardGraph
+{
+public:
+    static constexpr size_t MAX_NEIGHBOURS{ 8 };
+    static constexpr uint32_t ALPHABET_SIZE{ 26 };
+
+    /* Lightweight range over the neighbour cell indexes of a single cell. Allows
+    range based for loops without copying the neighbours anywhere. */
+    struct NeighbourRange
+    {
+        const uint32_t* m_begin;
+        const uint32_t* m_end;
+
+        const uint32_t* begin() const { return m_begin; }
+        const uint32_t* end() const { return m_end; }
+    };
+
+    BoardGraph(const BoggleBoard& board);
+
+    size_t cellCount() const { return m_letters.size(); }
+    size_t cellIndex(size_t row, size_t col) const { return m_rowOffsets[row] + col; }
+    char letter(size_t cell) const { return m_letters[cell]; }
+
+    NeighbourRange neighbours(size_t cell) const
+    {
+        const auto first{ &m_neighbours[cell * MAX_NEIGHBOURS] };
+        return { first, first + m_neighbourCounts[cell] };
+    }
+
+    /* Cells holding a letter, in cell order. Empty for anything but 'a'-'z'. */
+    NeighbourRange cellsWithLetter(char letter) const
+    {
+        const auto offset{ static_cast<uint32_t>(letter - 'a') };
+        if (offset >= ALPHABET_SIZE) return { nullptr, nullptr };
+        return { m_letterCells.data() + m_letterStarts[offset], m_letterCells.data() + m_letterStarts[offset + 1] };
+    }
+
+private:
+    vector<char> m_letters;             // board letters indexed by cell
+    vector<size_t> m_rowOffsets;        // cell index of the first node in each row
+    vector<uint32_t> m_neighbours;      // MAX_NEIGHBOURS slots per cell, only the first m_neighbourCounts[cell] are used
+    vector<uint8_t> m_neighbourCounts;  // number of valid neighbours per cell
+    vector<uint32_t> m_letterCells;     // cell indexes grouped by letter, 'a' cells first
+    uint32_t m_letterStarts[ALPHABET_SIZE + 1];     // per letter, index of its first cell in m_letterCells
+};
+
+
+/// <summary>
+/// Fixed size bitmask used to track which cells are part of the current search path.
+/// One bit is used per board cell. The storage is only (re)sized by reset(...), so
+/// marking and clearing cells during the search never touches the heap.
+/// </summary>
+class VisitedCells
+{
+public:
+    void reset(size_t cellCount) { m_bits.assign((cellCount + 63) / 64, 0); }
+
+    bool test(size_t cell) const { return (m_bits[cell >> 6] >> (cell & 63)) & 1; }
+    void set(size_t cell) { m_bits[cell >> 6] |= (uint64_t{ 1 } << (cell & 63)); }
+    void clear(size_t cell) { m_bits[cell >> 6] &= ~(uint64_t{ 1 } << (cell & 63)); }
+
+private:
+    vector<uint64_t> m_bits;
+};
+
+
+#endif // BOARD_GRAPH_H
@@ -0,0 +1,77 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef BOARD_TRIE_H
+#define BOARD_TRIE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "BoardGraph.h"
+#include "CompiledTrie.h"
+#include "Dictionary.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// The BoardTrie class cuts a frozen dictionary down to the words a single board
+/// could possibly spell, before the board is searched. A word is kept if:
+///   - the board has every one of its letters, at least as many times as the word uses it
+///   - every two letters next to each other in the word are on neighbouring cells
+///
+///   board   { t, o }   letters: o p s t
+///           { p, s }   pairs:   every letter can follow every other one
+///
+///   dictionary: pot, pots, stop, too, tot, zoo  -->  pot, pots, stop
+///
+/// A 'q' cell is the two letters "qu", so it adds a 'q' and a 'u', 'u' is the only
+/// letter that can follow its 'q', and its neighbours follow its 'u'.
+///
+/// Both checks are weaker than an actual path on the board, so no word the board
+/// can spell is ever dropped. What they do drop is every dictionary prefix that can't
+/// be finished on the board, which the search would otherwise walk into from every
+/// cell it starts on. On a small board, that is most of a large dictionary.
+///
+/// The result is a plain CompiledTrie (one record per node, whatever the layout of
+/// the dictionary) with its own word ids, so it is walked like any other dictionary
+/// (see DictionaryCursor). Its words are the same strings, in the same order.
+///
+/// Building it walks every dictionary prefix that passes both checks on a single
+/// thread. On the dictionaries measured so far that costs about as much as the
+/// search saves, so it is only built on request (see BoggleSolver and --board-trie).
+/// </summary>
+class BoardTrie
+{
+public:
+    static void build(const Dictionary& dictionary, const BoardGraph& graph, CompiledTrie& trie);
+
+private:
+    /* Letters of the board, indexed by letter - 'a'. */
+    struct BoardLetters
+    {
+        uint32_t m_starters;                                // mask of the letters a word can start with
+        uint32_t m_followers[CompiledTrie::ALPHABET_SIZE];  // per letter, mask of the letters that can follow it
+        uint32_t m_counts[CompiledTrie::ALPHABET_SIZE];     // per letter, number of times the board has it
+        uint32_t m_available;                               // mask of the letters with a count left
+    };
+
+    /* Kept node while the dictionary is walked. Children are linked in letter
+    order and only laid out next to each other once the walk is done. */
+    struct KeptNode
+    {
+        uint32_t m_childMask;           // letters and end of word flag, as in CompiledNode
+        uint32_t m_firstChild;          // index of the lowest lettered kept child, NO_NODE if none
+        uint32_t m_nextSibling;         // index of the next higher lettered kept sibling, NO_NODE if none
+    };
+
+    static BoardLetters readLetters(const BoardGraph& graph);
+    static uint32_t keepBelow(const CompiledTrie& source, uint32_t node, uint32_t candidates, BoardLetters& letters, vector<KeptNode>& kept);
+    static uint32_t keepChild(const CompiledTrie& source, uint32_t child, uint32_t offset, BoardLetters& letters, vector<KeptNode>& kept);
+    static void layOut(const vector<KeptNode>& kept, CompiledTrie& trie);
+};
+
+
+#endif // BOARD_TRIE_H
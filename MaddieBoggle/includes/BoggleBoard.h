@@ -5,22 +5,67 @@
 #ifndef BOGGLE_BOARD_H
 #define BOGGLE_BOARD_H
 
-#include <fstream>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <vector>
 
 #include "ErrorCodes.h"
+#include "MappedFile.h"
 
 
 using namespace std;
 using BoggleBoard = vector<vector<char>>; // alias for 2d data structure to store boggle characters
 
 
+/// <summary>
+/// Parses a single line of text into a board row and appends it to the board.
+/// Follows the same rules as importBoard(...): only 'a'-'z' are kept, 'A'-'Z' are
+/// converted to lowercase and a line without any letters is ignored.
+/// </summary>
+/// <param name="line">first character of the line, without its line break</param>
+/// <param name="length">characters in the line</param>
+/// <param name="board">board to append the row to</param>
+inline void appendBoardRow(const char* line, size_t length, BoggleBoard& board)
+{
+    vector<char> row{};
+    row.reserve(length);
+    for (size_t i = 0; i < length; i++)
+    {
+
+        // only add letters 'A'-'Z' and 'a'-'z'
+        auto letter{ line[i] };
+        if ((letter >= 'A') && (letter <= 'Z')) letter = static_cast<char>(letter - 'A' + 'a');
+        if ((letter >= 'a') && (letter <= 'z'))
+        {
+            row.push_back(letter);
+        }
+    }
+
+    // ignore empty lines
+    if (!row.empty())
+    {
+        board.push_back(move(row));
+    }
+}
+
+
+/// <summary>
+/// Same as appendBoardRow(line, length, board), for a line held in a string.
+/// </summary>
+/// <param name="line">line of text holding one row of the board</param>
+/// <param name="board">board to append the row to</param>
+inline void appendBoardRow(const string& line, BoggleBoard& board)
+{
+    appendBoardRow(line.data(), line.size(), board);
+}
+
+
 /// <summary>
 /// This function loads the boggle board from the provided file system path and
 /// stores it into the provided vector<vector<char>>& to be used by other entities.
 /// 
+/// The file is mapped and every line is read straight from the mapping (see MappedFile).
 /// Only alphabetical characters 'a'-'z' are importing. 'A'-'Z' will be converted to
 /// lowercase, while all other ascii chars will be ignored. Empty lines are skipped.
 /// 
@@ -40,36 +85,23 @@ static ErrorCode importBoard(const string& filepath, BoggleBoard& board)
 {
     try
     {
-        ifstream file(filepath);
-        if (!file)
+        MappedFile file{};
+        const auto openCode{ file.open(filepath) };
+        if (openCode != ErrorCode::SUCCESS)
         {
             cerr << "Error finding file at path: " << filepath << ".\n";
-            return ErrorCode::FILE_NOT_FOUND;
+            return openCode;
         }
-       
-        string line{};
-        while (getline(file, line)) // import line of chars
+
+        const auto end{ file.data() + file.size() };
+        for (auto line = file.data(); line < end; ) // import line of chars
         {
-            vector<char> tempVec{};
-            for (const auto& c : line)
-            {
-
-                // only add letters 'A'-'Z' and 'a'-'z'
-                const auto lowerC{ static_cast<char>(tolower(c)) };
-                if ((lowerC >= 'a') && (lowerC <= 'z'))
-                {
-                    tempVec.push_back(lowerC);
-                }
-            }
-
-            // ignore empty lines
-            if (!tempVec.empty())
-            {
-                board.push_back(tempVec);
-            }
+            const auto lineBreak{ static_cast<const char*>(memchr(line, '\n', static_cast<size_t>(end - line))) };
+            const auto lineEnd{ (lineBreak != nullptr) ? lineBreak : end };
+            appendBoardRow(line, static_cast<size_t>(lineEnd - line), board);
+            line = (lineBreak != nullptr) ? (lineBreak + 1) : end;
         }
 
-        file.close();
         return ErrorCode::SUCCESS;
     }
     catch (...)
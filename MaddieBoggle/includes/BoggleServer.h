@@ -0,0 +1,87 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef BOGGLE_SERVER_H
+#define BOGGLE_SERVER_H
+
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Dictionary.h"
+#include "ErrorCodes.h"
+#include "ThreadPool.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// Latency percentiles of the boards served so far, in milliseconds.
+/// </summary>
+struct LatencyReport
+{
+    size_t m_boardCount;
+    double m_p50;
+    double m_p99;
+    double m_max;
+};
+
+
+/// <summary>
+/// The BoggleServer class keeps a dictionary and a thread pool alive and solves
+/// boards as they arrive on a stream, writing the answers back on another stream.
+/// This saves a long running caller the process startup and dictionary import it
+/// would otherwise pay for every board.
+///
+/// Every request and response is framed by a header line, so any number of boards
+/// can be sent before reading the answers back:
+///
+///   request                     response
+///   board <id> [<min> [<max>]]  answers <id> <count>
+///   <row of letters>            <word>
+///   ...                         ... (count words, sorted)
+///   end
+///
+/// Rows follow the same rules as board files (see BoggleBoard.h). The id is any
+/// token without spaces and is echoed back untouched. The optional min and max only
+/// answer words of those lengths (see WordLengthRange), e.g. "board 7 5" for words
+/// of 5 letters or more. A malformed request is
+/// answered with "error <id> <reason>". The line "shutdown" stops the server.
+///
+/// Boards are solved concurrently: while the answers of one board are written,
+/// the boards after it are already being searched. Responses are always written
+/// in request order. At most maxInFlight boards are solved at the same time, after
+/// that reading waits for the oldest board to be answered.
+///
+/// Latency is measured from the moment a request is fully read until its response
+/// is flushed.
+/// </summary>
+class BoggleServer
+{
+public:
+    static constexpr size_t DEFAULT_MAX_IN_FLIGHT{ 8 };
+
+    BoggleServer(shared_ptr<const Dictionary> dictionary, shared_ptr<ThreadPool> pool, size_t maxInFlight = DEFAULT_MAX_IN_FLIGHT);
+
+    bool serve(istream& input, ostream& output);
+    ErrorCode serveSocket(const string& socketPath);
+
+    LatencyReport getLatencyReport() const;
+    void reportLatency(ostream& log) const;
+
+private:
+    shared_ptr<const Dictionary> m_dictionary;  // thread safe dictionary shared by every board
+    shared_ptr<ThreadPool> m_pool;              // access to execution threads
+    const size_t m_maxInFlight;                 // boards solved at the same time before reading waits
+
+    mutable mutex m_latencyMutex;               // mutex used to protect the latency samples
+    vector<double> m_latencies;                 // one sample per answered board, in milliseconds
+};
+
+
+#endif // BOGGLE_SERVER_H
@@ -5,20 +5,77 @@
 #ifndef BOGGLE_SOLVER_H
 #define BOGGLE_SOLVER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <ostream>
 #include <set>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
+#include "AnswerWriter.h"
+#include "BoardGraph.h"
+#include "BoardTrie.h"
 #include "BoggleBoard.h"
 #include "Dictionary.h"
+#include "ErrorCodes.h"
 #include "ThreadPool.h"
 
 
 using namespace std;
 
 
+/// <summary>
+/// Statistics of the answer collection, used to confirm that finding a word never
+/// takes a lock and that duplicates are skipped.
+/// </summary>
+struct AnswerStats
+{
+    size_t m_wordsFound;            // words found by the search, duplicates included
+    size_t m_uniqueWords;           // words found for the first time, the rest were skipped as duplicates
+    size_t m_lockAcquisitions;      // times the answer set mutex was taken
+    size_t m_contendedLocks;        // times a thread had to wait for the answer set mutex
+};
+
+
+/// <summary>
+/// Lengths of the words a search looks for, in letters (the 'q' cell counts as the
+/// two letters "qu"). Some game modes only score longer words, and the search skips
+/// every path that can only lead to words outside the range.
+/// </summary>
+struct WordLengthRange
+{
+    size_t m_min{ 0 };          // shortest word to find
+    size_t m_max{ SIZE_MAX };   // longest word to find
+};
+
+
+/// <summary>
+/// How a BoggleSolver looks for the words, see BoggleSolver.
+/// </summary>
+enum class SearchEngine
+{
+    AUTO,           // picked per board, see BoggleSolver::chooseEngine(...)
+    BOARD,          // search from every board cell, walking the dictionary along
+    DICTIONARY      // look for every dictionary word from the cells of its first letter
+};
+
+
+/// <summary>
+/// Statistics of the board search, used to tell why one board takes longer to
+/// solve than another. With the dictionary engine, a lookup is a dictionary word
+/// looked for and a pruned path a neighbour that doesn't have the word's next letter.
+/// </summary>
+struct SearchStats
+{
+    size_t m_nodesExpanded;         // board nodes the search stepped onto with a valid dictionary prefix
+    size_t m_dictionaryLookups;     // single letter dictionary steps tried, see DictionaryCursor::advance
+    size_t m_prunedPaths;           // paths abandoned because no dictionary word of a wanted length starts with them
+};
+
+
 /// <summary>
 /// The BoggleSolver class is built to solve all the words that can be made
 /// from a given boggle board. Words are found on a per-starter-node basis, 
@@ -29,41 +86,143 @@ using namespace std;
 /// different indexes at the same time. In order to keep the board and dictionary
 /// thread-safe, they are shared to this class in some constant form. 
 /// 
-/// Each of the search threads will keep track of their own data. The only risk of
-/// collisions is with the ORDERED set where all the threads will store found
-/// words. The set is protected with a mutex to prevent collisions.
+/// Each of the search threads will keep track of their own data, including the
+/// words they find. A found word is identified by its dictionary word id (see
+/// CompiledTrie.h), not its string: a shared bitmap with one bit per dictionary word
+/// tells if a word was already found, so a duplicate costs a single bit test. The
+/// first time a word is found, its id is appended to the answers of the pool worker
+/// that found it, so the search never takes a lock. The strings are only built once
+/// the board is solved and the answers are read for the first time.
 ///  
+/// The dictionary has to be frozen (see Dictionary::freeze). A solver given one
+/// that isn't reports it, and solveBoard() returns an error without searching.
+///
 /// After searching all the nodes on the board, this class can be instructed to 
 /// log all the found words to a file at the provided filepath.
+/// 
+/// waitForSolve() only waits for this solver's own tasks, so several solvers can
+/// share one thread pool and be waited on independently.
+/// 
+/// solveBoard() starts one task per board node, but the search trees of the nodes
+/// can differ wildly in size. While a task is still in the first splitDepth nodes
+/// (at most MAX_SPLIT_DEPTH, 1 never splits) of its path and the pool has idle workers, it hands the remaining
+/// neighbours to new tasks instead of searching them itself:
+///
+///   task { s }  --> idle workers --> task { s, e }, task { s, a }, ...
+///
+/// A split task replays its path (cursor and visited nodes) and carries on from
+/// there. This keeps every worker busy on boards with fewer nodes than workers, and
+/// at the tail of a solve when the last start nodes have the biggest trees.
+///
+/// With a WordLengthRange, only words of those lengths are answered. The dictionary
+/// knows how long the words below every prefix are (see DictionaryCursor), so a path
+/// stops as soon as all its words are too short or too long, instead of being searched
+/// and its words filtered out afterwards.
+///
+/// A small board can only spell a sliver of a large dictionary. With useBoardTrie,
+/// the dictionary is first cut down to the words the board's letters allow (see
+/// BoardTrie.h), and the search walks that instead, so it stops at every prefix
+/// that can't be finished on the board. Word ids are then the board trie's.
+///
+/// All of the above is the board engine, which searches out from every cell. On a
+/// huge board with a short word list, nearly all of that search dead ends after a
+/// letter or two, and it is far cheaper to turn it around: the dictionary engine
+/// takes every word and only looks for it from the cells holding its first letter
+/// (see BoardGraph::cellsWithLetter), following it letter by letter until it is
+/// spelled or every path fails.
+///
+///   words: sea, tea   board cells with 's': 2, with 't': 1  -->  3 short searches
+///
+/// Both engines find exactly the same words. chooseEngine(...) picks one from the
+/// board and dictionary sizes, unless the caller asks for one. The word tasks are
+/// never split, there are enough of them to keep every worker busy.
 /// </summary>
 class BoggleSolver
 {
 public:
-    BoggleSolver(shared_ptr<const Dictionary> dictionary, shared_ptr<ThreadPool> pool, const BoggleBoard& board);
+    static constexpr size_t MAX_SPLIT_DEPTH{ 3 };
+    static constexpr size_t WORD_TASKS_PER_THREAD{ 8 };     // dictionary engine, tasks the words are spread over
+    static constexpr uint64_t DICTIONARY_ENGINE_SCALE{ 32 };    // see chooseEngine
 
-    void solveBoard();
-    void exportAnswers(const string& filepath);
+    BoggleSolver(shared_ptr<const Dictionary> dictionary, shared_ptr<ThreadPool> pool, const BoggleBoard& board, size_t splitDepth = MAX_SPLIT_DEPTH,
+        WordLengthRange lengths = {}, bool useBoardTrie = false, SearchEngine engine = SearchEngine::AUTO);
 
-    /* C++17 doesn't have a hash function for type std::pair, so one 
-    needs to be provided for the unordered_set to hash correctly. */
-    struct PairHash {
-        std::size_t operator()(const pair<size_t, size_t>& p) const {
-            return std::hash<size_t>()(p.first) ^ (std::hash<size_t>()(p.second) << 1);
-        }};
+    static SearchEngine chooseEngine(size_t cellCount, size_t wordCount);
 
-    using BoardNodes = unordered_set<pair<size_t, size_t>, PairHash>;
+    ErrorCode solveBoard();
+    void waitForSolve();
+    ErrorCode exportAnswers(const string& filepath, AnswerFormat format = AnswerFormat::TEXT);
+    ErrorCode writeAnswers(AnswerWriter& writer);
+    void writeAnswers(ostream& output);
+    size_t answerCount();
+    AnswerStats getAnswerStats() const;
+    SearchStats getSearchStats() const;
+    size_t splitCount() const { return m_splitTasks.load(); }
+    size_t searchTrieNodes() const { return m_searchTrie->nodeCount(); }
+    SearchEngine getEngine() const { return m_engine; }
 
 protected:
+    /* Path of a search task, from its start node to the node it starts searching
+    from. Only the first MAX_SPLIT_DEPTH cells are kept, which is as deep as a
+    search is ever split. */
+    struct SearchPath
+    {
+        uint32_t m_cells[MAX_SPLIT_DEPTH];
+        size_t m_length;        // number of cells walked, can be more than MAX_SPLIT_DEPTH
+        bool m_canSplit;        // only searches running as this solver's pool tasks can split
+    };
+
     set<string> m_answers;      // using set here because it automatically sorts string alphabetically
     void findWordsAtIndex(size_t row, size_t col);
+    void findWordsFromPath(SearchPath path);
+    void mergeAnswers();
 
 private:
+    /* Words found by a single worker. Aligned to a cache line so workers
+    updating neighbouring entries don't invalidate each other's cache. */
+    struct alignas(64) WorkerAnswers
+    {
+        vector<uint32_t> m_wordIds; // ids of the words this worker found first
+        size_t m_wordsFound;        // words found by this worker, duplicates included
+        SearchStats m_search;       // search done by this worker
+    };
+
     const BoggleBoard& m_board;                 // thread safe board, using BoggleBoard = vector<vector<char>>
+    const BoardGraph m_graph;                   // flattened board with precomputed neighbours, built once per board
     shared_ptr<const Dictionary> m_dictionary;  // thread safe dictionary 
     shared_ptr<ThreadPool> m_pool;              // access to execution threads
+    const size_t m_splitDepth;                  // longest path a task is split off at, 1 to MAX_SPLIT_DEPTH
+    const WordLengthRange m_lengths;            // lengths of the words to answer
+    const bool m_limitLengths;                  // false when every length is wanted, which skips the length checks
+    CompiledTrie m_boardTrie;                   // dictionary cut down to this board, empty unless useBoardTrie is set
+    const CompiledTrie* m_searchTrie;           // trie the search walks, m_boardTrie or the dictionary's
+    SearchEngine m_engine;                      // BOARD or DICTIONARY, never AUTO
     
     mutex m_answersMutex;       // mutex used to protect access to the combined set of found answers
+    vector<WorkerAnswers> m_workerAnswers;  // one per pool worker, plus one for callers outside the pool
+    mutex m_outsideAnswersMutex;            // held by callers outside the pool while they use the last m_workerAnswers entry
+    unique_ptr<atomic<uint64_t>[]> m_foundWords;    // one bit per word id of m_searchTrie, set once the word is found
+    size_t m_wordsFound;                    // see AnswerStats, only updated when merging
+    size_t m_uniqueWords;
+    SearchStats m_searchStats;              // see SearchStats, only updated when merging
+    atomic<size_t> m_lockAcquisitions;
+    atomic<size_t> m_contendedLocks;
+    atomic<size_t> m_splitTasks;    // tasks split off a running search
+
+    mutex m_pendingMutex;       // mutex used to protect the pending task count
+    condition_variable m_solved;    // notified when the last pending task finishes
+    size_t m_pendingTasks;      // tasks queued by solveBoard() that haven't finished yet
     
+    void finishTask();
+    void queueSearch(const SearchPath& path);
+    void queueWordSearches();
+    void findWordsInRange(uint32_t firstWordId, uint32_t endWordId);
+    bool spellsFrom(size_t cell, const string& word, size_t position, VisitedCells& visitedCells, SearchStats& search) const;
+    void recordWord(uint32_t wordId, WorkerAnswers& answers);
+    void splitSearch(const SearchPath& path, uint32_t neighbour);
+    void findWordsFromNode(size_t cell, DictionaryCursor& cursor, VisitedCells& visitedCells, WorkerAnswers& answers, SearchPath& path);
+    unique_lock<mutex> lockAnswers();
+    unique_lock<mutex> claimWorkerAnswers(size_t& worker);
 };
 
 
@@ -0,0 +1,124 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef CHILD_ARENA_H
+#define CHILD_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+using namespace std;
+
+
+/// <summary>
+/// The ChildArena class is a bump allocator for the child arrays of LetterNodes.
+/// Memory is handed out from big blocks by moving an offset forward, and is never
+/// given back one allocation at a time, only all at once by release():
+///
+///   block:  [ node a children | node b children | node a children (grown) | free ... ]
+///                                                                           ^ next offset
+///
+/// A child array that grows leaves its old storage behind in the block. Most nodes
+/// have one child and never grow, so little is left behind, and a whole trie takes
+/// a handful of block allocations instead of one malloc per node.
+///
+/// allocate(...) can be called from several threads at once (see the parallel
+/// Dictionary::importDictionary). The offset of the current block is atomic, so
+/// only adding a new block takes the mutex. release() must not run concurrently
+/// with anything else.
+/// </summary>
+class ChildArena
+{
+public:
+    static constexpr size_t BLOCK_BYTES{ size_t{ 1 } << 20 };
+    static constexpr size_t ALIGNMENT{ alignof(max_align_t) };
+
+    ChildArena();
+    ChildArena(const ChildArena&) = delete;
+    ChildArena& operator=(const ChildArena&) = delete;
+
+    void* allocate(size_t bytes);
+    void release();
+
+    size_t blockCount() const;
+    size_t bytesReserved() const;
+    size_t bytesUsed() const;
+
+private:
+    /// <summary>
+    /// One block of memory. m_used can run past m_size when several threads race
+    /// for its last bytes, every allocation that doesn't fit moves on to a new block.
+    /// </summary>
+    struct Block
+    {
+        unique_ptr<char[]> m_data;
+        size_t m_size;
+        atomic<size_t> m_used;
+    };
+
+    mutable mutex m_mutex;              // guards m_blocks and replacing m_current
+    vector<unique_ptr<Block>> m_blocks; // every block handed out from, oldest first
+    atomic<Block*> m_current;           // block allocations are made from, nullptr before the first one
+
+    void addBlock(const Block* full, size_t bytes);
+};
+
+
+/// <summary>
+/// Standard allocator that takes its memory from a ChildArena, so standard containers
+/// and the child blocks of LetterNode can live in the arena. Deallocating arena memory
+/// does nothing, the arena frees it all at once. Without an arena, the regular heap
+/// is used.
+/// </summary>
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept : m_arena(nullptr) {}
+    explicit ArenaAllocator(ChildArena* arena) noexcept : m_arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+    T* allocate(size_t count)
+    {
+        static_assert(alignof(T) <= ChildArena::ALIGNMENT, "arena blocks are not aligned for this type");
+
+        if (m_arena == nullptr) return static_cast<T*>(::operator new(count * sizeof(T)));
+        return static_cast<T*>(m_arena->allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* memory, size_t) noexcept
+    {
+        if (m_arena == nullptr) ::operator delete(memory);
+    }
+
+    ChildArena* arena() const noexcept { return m_arena; }
+
+private:
+    ChildArena* m_arena;    // nullptr --> regular heap
+};
+
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept
+{
+    return lhs.arena() == rhs.arena();
+}
+
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept
+{
+    return lhs.arena() != rhs.arena();
+}
+
+
+#endif // CHILD_ARENA_H
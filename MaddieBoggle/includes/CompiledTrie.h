@@ -0,0 +1,218 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef COMPILED_TRIE_H
+#define COMPILED_TRIE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LetterNode.h"
+#include "MappedFile.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+using namespace std;
+
+
+/// <summary>
+/// Counts the number of set bits. C++17 has no std::popcount, so the
+/// compiler intrinsic is used directly.
+/// </summary>
+inline uint32_t countBits(uint32_t value)
+{
+#ifdef _MSC_VER
+    return __popcnt(value);
+#else
+    return static_cast<uint32_t>(__builtin_popcount(value));
+#endif
+}
+
+
+/// <summary>
+/// Single 8 byte record of the compiled trie. The low 26 bits of the mask mark
+/// which letters 'a'-'z' have a child node, the high bit marks the end of a valid
+/// word. All children of a node are stored next to each other in letter order,
+/// starting at m_firstChild.
+/// 
+/// Bits 26-30 hold the length of the node's edge label, which is only ever non-zero
+/// in the radix layout (see CompiledTrie below).
+/// </summary>
+struct CompiledNode
+{
+    uint32_t m_childMask;   // bit n set --> child for letter ('a' + n) exists, bits 26-30 --> label length, bit 31 --> end of word
+    uint32_t m_firstChild;  // index of the child with the lowest letter
+};
+
+
+/// <summary>
+/// Number of letters that can still follow a compiled record, after its edge
+/// label, before a word ends. Saturated at CompiledTrie::MAX_REMAINING_DEPTH.
+/// </summary>
+struct RemainingDepth
+{
+    uint8_t m_shortest;     // letters to the nearest word end, 0 if the record ends a word
+    uint8_t m_longest;      // letters to the farthest word end
+};
+
+
+/// <summary>
+/// The CompiledTrie class is an immutable, flat copy of a LetterNode trie. Where
+/// the LetterNode trie chases a pointer into the pool and runs a binary search for
+/// every letter, the compiled trie finds a child with one mask test and one popcount:
+///
+///   node 'b' --> mask: ......a.u..  (children 'a' and 'u'), first child: 7
+///
+///   child 'u' --> index = first child + (number of mask bits below 'u')
+///                       = 7 + 1 = 8
+///
+/// Nodes are laid out breadth first in one contiguous array, so the top levels of
+/// the trie (which every search passes through) sit next to each other in memory.
+///
+/// Only the letters 'a'-'z' are compiled, since those are the only letters a boggle
+/// board can contain. Words with any other characters are left out.
+///
+/// Nothing in the layout requires a node to have a single parent. Two records that
+/// point at the same first child share the whole block of children (and everything
+/// below it), which is how the minimized DAWG layout from DawgBuilder is stored.
+///
+/// The radix (patricia) layout collapses chains of nodes that are not the end of a
+/// word and only have one child into a single record with an edge label:
+///
+///   trie:   t --> h --> e --> o --> r --> y(word)
+///   radix:  t [label "heory"](word)
+///
+/// The letter 't' still selects the child record like it does in the trie, but the
+/// letters of the label have to be matched one at a time before the record's own
+/// children and end of word flag apply. DictionaryCursor tracks how far into a
+/// label it is, so the solver can still check prefixes one letter at a time.
+///
+/// Every word also has a word id: its position in the sorted list of all words in
+/// the trie. For every record, the number of words below its lower lettered siblings
+/// is stored, so the id of a word is simply summed up while walking down to it:
+///
+///   words: bat, bee, beet   -->   ids: bat = 0, bee = 1, beet = 2
+///
+///   b --> e: skip the 1 word below 'a'           id = 1
+///   e --> e: nothing skipped                     id = 1  ("bee" ends here)
+///   e --> t: skip "bee" itself, a shorter word   id = 2  ("beet" ends here)
+///
+/// Ids depend on the words only, so they are identical in every layout, and a
+/// solver can mark found words in a plain bitmap instead of comparing strings.
+///
+/// Every record also knows how many letters its shortest and longest words still
+/// need (see RemainingDepth), which lets a search that only wants some word lengths
+/// skip whole subtrees:
+///
+///   words: bat, bee, beet   -->   'b': shortest 2, longest 3
+///                                 'e' below 'b': shortest 1 ("bee"), longest 2 ("beet")
+///
+/// Like the word offsets, the depths only depend on what is below a record, so they
+/// are the same for every path to a shared record. The root's longest depth is the
+/// length of the longest word.
+///
+/// The records either live in the trie's own vectors (after build(...)) or straight
+/// in a mapped dictionary image (see DictionaryImage.h). Lookups only ever go
+/// through the m_*Data pointers, so they don't care which one it is. Copying is not
+/// allowed since the pointers would still point into the original's storage, moving
+/// hands the storage (and the pointers) over.
+/// </summary>
+class CompiledTrie
+{
+public:
+    static constexpr uint32_t ROOT{ 0 };
+    static constexpr uint32_t NO_NODE{ UINT32_MAX };
+    static constexpr uint32_t WORD_FLAG{ 1u << 31 };
+    static constexpr uint32_t ALPHABET_SIZE{ 26 };
+    static constexpr uint32_t LETTER_MASK{ (1u << ALPHABET_SIZE) - 1 };
+    static constexpr uint32_t LABEL_SHIFT{ 26 };
+    static constexpr uint32_t MAX_LABEL_LENGTH{ 31 };   // longer chains are split over several records
+    static constexpr uint32_t MAX_REMAINING_DEPTH{ UINT8_MAX };
+
+    CompiledTrie();
+    CompiledTrie(const CompiledTrie&) = delete;
+    CompiledTrie& operator=(const CompiledTrie&) = delete;
+    CompiledTrie(CompiledTrie&& other) noexcept;
+    CompiledTrie& operator=(CompiledTrie&& other) noexcept;
+
+    void build(const LetterNode* root, bool compressChains = false);
+    static const CompiledTrie& noWords();
+
+    size_t nodeCount() const { return m_nodeCount; }
+    size_t memoryUsage() const;
+    bool isEmpty() const { return m_nodeCount == 0; }
+    uint32_t wordCount() const { return m_wordCount; }
+    bool isMapped() const { return m_image != nullptr; }
+
+    bool isWord(uint32_t node) const { return (m_nodeData[node].m_childMask & WORD_FLAG) != 0; }
+    uint32_t findChild(uint32_t node, char letter) const;
+
+    uint32_t labelLength(uint32_t node) const { return (m_nodeData[node].m_childMask >> LABEL_SHIFT) & MAX_LABEL_LENGTH; }
+    char labelLetter(uint32_t node, uint32_t position) const { return m_labelData[m_labelStartData[node] + position]; }
+
+    uint32_t wordOffset(uint32_t node) const { return m_wordOffsetData[node]; }
+    string wordAt(uint32_t wordId) const;
+
+    uint32_t shortestRemaining(uint32_t node) const { return m_remainingDepthData[node].m_shortest; }
+    uint32_t longestRemaining(uint32_t node) const { return m_remainingDepthData[node].m_longest; }
+    uint32_t longestWord() const { return isEmpty() ? 0 : longestRemaining(ROOT); }
+
+private:
+    vector<CompiledNode> m_nodes;   // breadth first node records, m_nodes[ROOT] is the root
+    vector<uint32_t> m_labelStarts; // radix layout only, start of each node's label in m_labels
+    vector<char> m_labels;          // radix layout only, letters of all the edge labels
+    vector<uint32_t> m_wordOffsets; // per record, number of words below the lower lettered siblings
+    vector<RemainingDepth> m_remainingDepths;   // per record, see RemainingDepth
+
+    /* Views the lookups read through. They point into the vectors above, or
+    into m_image when the trie was loaded from a dictionary image. */
+    const CompiledNode* m_nodeData;
+    const uint32_t* m_labelStartData;
+    const char* m_labelData;
+    const uint32_t* m_wordOffsetData;
+    const RemainingDepth* m_remainingDepthData;
+    size_t m_nodeCount;
+    size_t m_labelCount;                // 0 unless the radix layout is used
+    uint32_t m_wordCount;               // number of words, word ids run from 0 to m_wordCount - 1
+    unique_ptr<MappedFile> m_image;     // keeps the mapped records alive, nullptr when the vectors are used
+
+    void useOwnedStorage();
+    void indexRecords();
+    uint32_t indexRecordsBelow(uint32_t node, vector<uint32_t>& counts);
+
+    friend class BoardTrie;
+    friend class DawgBuilder;
+    friend class DictionaryImage;
+};
+
+
+/// <summary>
+/// Finds the child of a node for the provided letter. Defined inline since this
+/// is called for every step of the board search.
+/// </summary>
+/// <param name="node">index of the parent node</param>
+/// <param name="letter">char letter of the child to find</param>
+/// <returns>index of the child node, NO_NODE if it doesn't exist</returns>
+inline uint32_t CompiledTrie::findChild(uint32_t node, char letter) const
+{
+    const auto offset{ static_cast<uint32_t>(letter - 'a') };
+    if (offset >= ALPHABET_SIZE) return NO_NODE; // early return, not a compiled letter
+
+    const auto& record{ m_nodeData[node] };
+    const uint32_t letterBit{ 1u << offset };
+    if ((record.m_childMask & letterBit) == 0) return NO_NODE; // early return, no child
+
+    /* Children are stored in letter order, so the number of children with a
+    lower letter is the child's offset from the first child. The label length
+    and WORD_FLAG bits are above every letter bit so they are never counted. */
+    return record.m_firstChild + countBits(record.m_childMask & (letterBit - 1));
+}
+
+
+#endif // COMPILED_TRIE_H
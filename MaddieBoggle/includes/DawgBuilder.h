@@ -0,0 +1,102 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef DAWG_BUILDER_H
+#define DAWG_BUILDER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "CompiledTrie.h"
+#include "ErrorCodes.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// The DawgBuilder class builds a minimized dictionary graph (a DAWG/DAFSA) where
+/// words don't only share common prefixes like in the trie, but common suffixes
+/// as well. See the example below.
+///
+/// dictionary: tap, taps, top, tops
+///
+///       trie (8 nodes)              dawg (5 nodes)
+///
+///           root                        root
+///            |                           |
+///            t                           t
+///          /   \                        / \      "tap(s)" and "top(s)"
+///         a     o                      a   o     share their endings
+///         |     |                       \ /
+///         p     p                        p
+///         |     |                        |
+///         s     s                        s
+///
+/// The graph is built with incremental minimization: words must be inserted in
+/// sorted order, which guarantees that once a word is inserted, the part of the
+/// previous word that isn't shared with it can never change again. That part is
+/// immediately merged with an identical node (same end of word flag and the same
+/// children) if one was already seen, so the full trie never has to exist in memory.
+///
+/// Once all words are inserted, finish(...) compiles the graph into the same flat
+/// CompiledTrie layout the frozen Dictionary uses. Merged nodes simply share their
+/// block of children, so the search code doesn't know the difference.
+/// </summary>
+class DawgBuilder
+{
+public:
+    DawgBuilder();
+    DawgBuilder(const DawgBuilder&) = delete;               // register functors point back at m_states
+    DawgBuilder& operator=(const DawgBuilder&) = delete;
+
+    ErrorCode insertWord(const string& word);
+    ErrorCode insertWord(const char* word, size_t length);
+    void finish(CompiledTrie& trie);
+
+    size_t nodesBeforeMinimization() const { return m_nodesCreated; }
+    size_t nodesAfterMinimization() const { return m_register.size() + 1; } // +1 for the root
+
+private:
+    static constexpr uint32_t ROOT_STATE{ 0 };
+
+    /* Mutable node used while building. Since words arrive in sorted order,
+    edges are always appended in letter order. */
+    struct DawgState
+    {
+        bool m_isWordValid;
+        vector<pair<char, uint32_t>> m_edges;   // sorted pairs of letters and target states
+    };
+
+    /* The register holds every state that has been minimized. Lookups compare
+    the content of the states (not their ids), which is what allows two identical
+    states to be found and merged. */
+    struct StateHash
+    {
+        const vector<DawgState>* m_states;
+        size_t operator()(uint32_t state) const;
+    };
+
+    struct StateEqual
+    {
+        const vector<DawgState>* m_states;
+        bool operator()(uint32_t lhs, uint32_t rhs) const;
+    };
+
+    vector<DawgState> m_states;         // all states, merged states are recycled through m_freeStates
+    vector<uint32_t> m_freeStates;      // ids of states that were merged away and can be reused
+    unordered_set<uint32_t, StateHash, StateEqual> m_register;
+    vector<uint32_t> m_uncheckedPath;   // states of the previous word that haven't been minimized yet
+    string m_previousWord;
+    size_t m_nodesCreated;              // number of nodes a plain trie would have needed, including the root
+
+    uint32_t createState();
+    void minimize(size_t downTo);
+};
+
+
+#endif // DAWG_BUILDER_H
@@ -5,11 +5,17 @@
 #ifndef DICTIONARY_H
 #define DICTIONARY_H
 
+#include <cassert>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "ChildArena.h"
+#include "CompiledTrie.h"
 #include "ErrorCodes.h"
 #include "LetterNode.h"
 #include "LetterNodePool.h"
+#include "ThreadPool.h"
 
 
 using namespace std;
@@ -26,6 +32,26 @@ enum class SearchType
 };
 
 
+/// <summary>
+/// Layouts a dictionary can be frozen into (see CompiledTrie.h).
+/// </summary>
+enum class DictionaryLayout
+{
+    TRIE,   // one record per trie node
+    RADIX   // single child chains collapsed into edge labels
+};
+
+
+/// <summary>
+/// Node counts recorded when a minimized (DAWG) dictionary is imported.
+/// </summary>
+struct MinimizationReport
+{
+    size_t m_nodesBefore;   // nodes a plain trie of the same words would need
+    size_t m_nodesAfter;    // nodes left once shared suffixes are merged
+};
+
+
 /// <summary>
 /// The Dictionary class is a lean version of a character trie where a 
 /// node only contains pointers to nodes that can be appended to create 
@@ -46,24 +72,239 @@ enum class SearchType
 /// 
 /// The dictionary trie is acyclic.
 /// 
+/// Once all the words are inserted, the dictionary can be frozen. Freezing compiles
+/// the trie into a flat, read-only CompiledTrie (either one record per node, or the
+/// radix layout with single child chains collapsed) and releases the LetterNode pool
+/// and the ChildArena the nodes keep their children in.
+/// A frozen dictionary can no longer be changed, but it uses a fraction of the
+/// memory and is what the DictionaryCursor (and so the BoggleSolver) walks.
+/// 
+/// The import functions map the dictionary file (see MappedFile) and split it into
+/// words in place (see WordScanner), so a word is only copied into the trie nodes.
+/// Words are lowercased, and words with anything else than letters are left out.
+/// 
+/// importDictionary(...) can also build the trie on a thread pool. The words are
+/// split by their first two letters, and every group is inserted below its own
+/// two letter prefix node by its own task. No two tasks ever touch the same node,
+/// and the trie ends up exactly the same as when the words are inserted one by one.
+/// 
+/// Alternatively, importMinimizedDictionary(...) skips the LetterNode trie entirely
+/// and builds an already frozen dictionary where common suffixes are shared as well
+/// (see DawgBuilder.h). It answers every query the same way.
+/// 
+/// A frozen dictionary can be saved to a binary image with saveImage(...) and
+/// loaded back with loadImage(...), which maps the image instead of parsing and
+/// rebuilding the trie (see DictionaryImage.h).
+/// 
 /// </summary>
 class Dictionary
 {
 public:
-    Dictionary(size_t poolSize);
+    Dictionary(size_t nodeLimit = LetterNodePool::NO_NODE_LIMIT);
 
     ErrorCode importDictionary(const string& filepath);
+    ErrorCode importDictionary(const string& filepath, ThreadPool& pool);
+    ErrorCode importMinimizedDictionary(const string& filepath);
     ErrorCode insertWord(const string& word);
+    ErrorCode insertWord(const char* word, size_t length);
     bool searchDictionary(const string& word, SearchType searchType) const;
 
+    ErrorCode saveImage(const string& imagePath, uint64_t sourceFingerprint) const;
+    ErrorCode loadImage(const string& imagePath, uint64_t sourceFingerprint);
+
+    ErrorCode freeze(DictionaryLayout layout = DictionaryLayout::TRIE);
+    bool isFrozen() const { return !m_compiled.isEmpty(); }
+    MinimizationReport getMinimizationReport() const { return m_minimizationReport; }
+    size_t nodeCount() const { return m_compiled.nodeCount(); }
+    size_t memoryUsage() const { return m_compiled.memoryUsage(); }
+    uint32_t wordCount() const { return m_compiled.wordCount(); }
+    size_t longestWord() const { return m_compiled.longestWord(); }
+    string wordFromId(uint32_t wordId) const { return m_compiled.wordAt(wordId); }
+    const CompiledTrie& getCompiledTrie() const { return isFrozen() ? m_compiled : CompiledTrie::noWords(); }
+    const ChildArena& getChildArena() const { return *m_childArena; }
+    size_t trieNodeCount() const { return m_pool.nodesInUse(); }
+
 protected:
-    LetterNode* m_root;         // root node for the trie
+    LetterNode* m_root;         // root node for the trie, nullptr once frozen
+    unique_ptr<ChildArena> m_childArena;    // child blocks of the trie nodes, on the heap so the nodes can point at it
     LetterNodePool m_pool;
+    CompiledTrie m_compiled;    // flat read-only copy of the trie, only populated once frozen
 
 private:
     static constexpr size_t m_minWordSize{ 3 };
     size_t m_wordCount;         // number of words imported
+    MinimizationReport m_minimizationReport;    // only populated by importMinimizedDictionary(...)
+
+    void reservePool(size_t fileSize);
+
+    friend class DictionaryCursor;
 };
 
 
+/// <summary>
+/// The DictionaryCursor class is a handle to a position in a frozen dictionary trie.
+/// Instead of re-walking the trie from the root for every query (which costs one
+/// child lookup per letter of the prefix), a cursor remembers the path of nodes it
+/// has already walked. Moving one letter deeper or shallower is a single step.
+/// 
+/// dictionary: ant, and
+/// 
+///   cursor.advance('a')   --> true,  path: root -> a
+///   cursor.advance('n')   --> true,  path: root -> a -> n
+///   cursor.advance('t')   --> true,  path: root -> a -> n -> t
+///   cursor.isWord()       --> true
+///   cursor.stepBack()     -->        path: root -> a -> n
+///   cursor.advance('x')   --> false, path is unchanged
+/// 
+/// While at a word, wordId() gives the word's id (see CompiledTrie.h), which is
+/// unique per word and can be turned back into the word with Dictionary::wordFromId.
+///
+/// shortestRemaining() and longestRemaining() tell how many more letters the words
+/// below the current prefix need, so a search can stop at a prefix whose words are
+/// all too short or too long:
+///
+///   dictionary: ant, antelope  -->  after "ant": shortest 0, longest 5
+/// 
+/// A cursor can also walk a compiled trie on its own (see BoardTrie.h), in which
+/// case word ids are the trie's and CompiledTrie::wordAt turns them back into words.
+///
+/// A cursor only reads from the dictionary, so any number of cursors (one per 
+/// thread) can walk the same const dictionary at the same time. The dictionary 
+/// must outlive all of its cursors.
+/// </summary>
+class DictionaryCursor
+{
+public:
+    DictionaryCursor(const Dictionary& dictionary);
+    DictionaryCursor(const CompiledTrie& trie);
+
+    bool advance(char letter);
+    void stepBack();
+    bool isWord() const;
+    uint32_t wordId() const;
+    size_t depth() const;
+    size_t shortestRemaining() const;
+    size_t longestRemaining() const;
+
+private:
+    /* Position in the compiled trie. In the radix layout a position can be part
+    way through a record's edge label, for every other layout m_labelPosition
+    is always 0. */
+    struct Position
+    {
+        uint32_t m_node;            // index of the compiled record
+        uint32_t m_labelPosition;   // number of label letters already matched
+        uint32_t m_wordId;          // number of words sorted before the current prefix
+    };
+
+    static constexpr size_t m_reservedDepth{ 32 };
+    const CompiledTrie& m_trie;         // compiled trie of the frozen dictionary
+    vector<Position> m_path;            // walked positions, m_path.front() is the root
+};
+
+
+/// <summary>
+/// Moves the cursor one letter deeper into the trie. If the letter does not
+/// continue the current prefix, the cursor is left where it was. The cursor
+/// methods are defined inline since they are called for every step of the
+/// board search.
+/// </summary>
+/// <param name="letter">char letter to append to the current prefix</param>
+/// <returns>bool true if the new prefix exists in the dictionary, otherwise false</returns>
+inline bool DictionaryCursor::advance(char letter)
+{
+    const auto current{ m_path.back() };
+
+    /* Part way through an edge label (radix layout), the only way forward
+    is the next letter of the label. */
+    if (current.m_labelPosition < m_trie.labelLength(current.m_node))
+    {
+        if (m_trie.labelLetter(current.m_node, current.m_labelPosition) != letter) return false; // early return
+
+        m_path.push_back({ current.m_node, current.m_labelPosition + 1, current.m_wordId });
+        return true;
+    }
+
+    const auto child{ m_trie.findChild(current.m_node, letter) };
+    if (child == CompiledTrie::NO_NODE) return false; // early return, prefix doesn't exist
+
+    /* Every word below the lower lettered siblings, and the current prefix itself
+    if it is a word, sorts before anything below the child. */
+    const auto wordsBefore{ m_trie.wordOffset(child) + (m_trie.isWord(current.m_node) ? 1 : 0) };
+    m_path.push_back({ child, 0, current.m_wordId + wordsBefore });
+    return true;
+}
+
+
+/// <summary>
+/// Moves the cursor one letter back towards the root, undoing the last
+/// successful advance(...). The cursor can not step back past the root.
+/// </summary>
+inline void DictionaryCursor::stepBack()
+{
+    assert(m_path.size() > 1);
+    m_path.pop_back();
+}
+
+
+/// <summary>
+/// Checks if the prefix the cursor currently points to is a complete word.
+/// </summary>
+/// <returns>bool true if the current prefix is a valid word, otherwise false</returns>
+inline bool DictionaryCursor::isWord() const
+{
+    const auto current{ m_path.back() };
+
+    // the end of word flag only applies once the whole label is matched
+    return (current.m_labelPosition == m_trie.labelLength(current.m_node)) && m_trie.isWord(current.m_node);
+}
+
+
+/// <summary>
+/// Id of the word the cursor currently points to. Only meaningful if isWord() is true.
+/// </summary>
+/// <returns>word id, from 0 to Dictionary::wordCount() - 1</returns>
+inline uint32_t DictionaryCursor::wordId() const
+{
+    return m_path.back().m_wordId;
+}
+
+
+/// <summary>
+/// Number of letters in the prefix the cursor currently points to.
+/// </summary>
+/// <returns>length of the current prefix, 0 when at the root</returns>
+inline size_t DictionaryCursor::depth() const
+{
+    return m_path.size() - 1;
+}
+
+
+/// <summary>
+/// Fewest letters that have to be added to the current prefix to make a word.
+/// </summary>
+/// <returns>0 if the prefix is a word, CompiledTrie::MAX_REMAINING_DEPTH or more if no word starts with it</returns>
+inline size_t DictionaryCursor::shortestRemaining() const
+{
+    const auto current{ m_path.back() };
+
+    // the rest of the label comes first, nothing ends part way through it
+    return (m_trie.labelLength(current.m_node) - current.m_labelPosition) + m_trie.shortestRemaining(current.m_node);
+}
+
+
+/// <summary>
+/// Most letters that can be added to the current prefix and still make a word.
+/// </summary>
+/// <returns>letters to the end of the longest word starting with the prefix, SIZE_MAX if too many to count</returns>
+inline size_t DictionaryCursor::longestRemaining() const
+{
+    const auto current{ m_path.back() };
+    const auto longest{ m_trie.longestRemaining(current.m_node) };
+    if (longest >= CompiledTrie::MAX_REMAINING_DEPTH) return SIZE_MAX; // saturated, the real depth is unknown
+
+    return (m_trie.labelLength(current.m_node) - current.m_labelPosition) + longest;
+}
+
+
 #endif // DICTIONARY_H
@@ -0,0 +1,73 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef DICTIONARY_IMAGE_H
+#define DICTIONARY_IMAGE_H
+
+#include <cstdint>
+#include <string>
+
+#include "CompiledTrie.h"
+#include "ErrorCodes.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// The DictionaryImage class writes a compiled trie to a binary image file and
+/// loads it back by mapping the file into memory. A loaded trie reads its records
+/// straight out of the mapping, so loading does no parsing and no per-node
+/// allocation, however big the dictionary is.
+///
+///   offset 0   header      magic, version, byte order, source fingerprint, counts, checksum
+///   offset 48  records     nodeCount x 8 byte CompiledNode
+///              wordOffsets nodeCount x uint32_t
+///              labelStarts labelStartCount x uint32_t (radix layout only)
+///              labels      labelCount x char (radix layout only)
+///              depths      nodeCount x 2 byte RemainingDepth
+///
+/// The header records a fingerprint of the text dictionary the image was built from.
+/// If the text changes, the fingerprint no longer matches and the image is rejected,
+/// so the caller knows to rebuild it. A checksum over everything after the header
+/// catches truncated or corrupted images the same way.
+///
+/// Images are written in the byte order of the machine that wrote them and are
+/// rejected on a machine with a different byte order.
+/// </summary>
+class DictionaryImage
+{
+public:
+    static constexpr uint32_t VERSION{ 3 };     // bump whenever the record layout changes
+
+    static ErrorCode fingerprintFile(const string& filepath, uint64_t& fingerprint);
+    static ErrorCode write(const CompiledTrie& trie, const string& imagePath, uint64_t sourceFingerprint);
+    static ErrorCode read(CompiledTrie& trie, const string& imagePath, uint64_t sourceFingerprint);
+
+private:
+    static constexpr char MAGIC[8]{ 'M', 'B', 'D', 'I', 'C', 'T', '\0', '\0' };
+    static constexpr uint32_t BYTE_ORDER_MARK{ 0x01020304 };
+
+    /* Fixed size header at the start of every image. All fields are naturally
+    aligned and the size is a multiple of 8, so the records that follow are
+    aligned when the image is mapped. */
+    struct Header
+    {
+        char m_magic[8];
+        uint32_t m_version;
+        uint32_t m_byteOrder;               // BYTE_ORDER_MARK as written by the writing machine
+        uint64_t m_sourceFingerprint;       // fingerprintFile(...) of the text dictionary
+        uint64_t m_payloadChecksum;         // checksum of every byte after the header
+        uint32_t m_nodeCount;
+        uint32_t m_labelStartCount;         // either 0 or m_nodeCount
+        uint32_t m_labelCount;
+        uint32_t m_wordCount;
+    };
+    static_assert(sizeof(Header) == 48, "image header layout changed, bump VERSION");
+
+    static uint64_t checksum(const char* data, size_t size, uint64_t seed);
+};
+
+
+#endif // DICTIONARY_IMAGE_H
@@ -14,7 +14,12 @@ enum class ErrorCode
 	SUCCESS				= 0,
 	FILE_NOT_FOUND		= 1,
 	UNKNOWN_FILE_ERR	= 2,
-	OUT_OF_POOL_SPACE	= 3
+	OUT_OF_POOL_SPACE	= 3,
+	DICTIONARY_FROZEN	= 4,
+	UNSORTED_INPUT		= 5,
+	IMAGE_INVALID		= 6,
+	DICTIONARY_NOT_FROZEN	= 7,
+	DUPLICATE_OUTPUT	= 8
 };
 
 
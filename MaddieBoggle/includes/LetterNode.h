@@ -5,7 +5,10 @@
 #ifndef LETTER_NODE_H
 #define LETTER_NODE_H
 
-#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "ChildArena.h"
 
 
 using namespace std;
@@ -13,22 +16,56 @@ using namespace std;
 
 /// <summary>
 /// Struct container that represents a letter in a word
-/// trie. Any succeeding letters are found in a LetterNode's
-/// vector where pairs of characters and pointers to the 
-/// corresponding sequential LetterNodes.
+/// trie. Any succeeding letters are kept sorted in a LetterNode's
+/// child letters, with the pointers to the corresponding sequential
+/// LetterNodes at the same positions.
 /// 
 /// Each node has a bool used to indicate if that node is the 
 /// end of word. 
+/// 
+/// The children live in a single block, the node pointers first and the letters
+/// after them, so a lookup only reads a few contiguous bytes: the root's 26 letters
+/// fit in a single cache line, where 26 letter and pointer pairs took seven.
+///
+///   capacity 4:  [ node | node | node | ---- ][ a c d - ]
+///
+/// Letters are compared 16 at a time with SSE2 where the compiler targets it (see
+/// childPosition), and one at a time otherwise. The block doubles when it is full.
+/// 
+/// The block is taken from the ChildArena the node was created with (see
+/// LetterNodePool), or from the heap without one.
 /// </summary>
 struct LetterNode
 {
     LetterNode();
+    explicit LetterNode(ChildArena* arena);
+    ~LetterNode();
+    LetterNode(LetterNode&& other) noexcept;
+    LetterNode& operator=(LetterNode&& other) noexcept;
+    LetterNode(const LetterNode&) = delete;
+    LetterNode& operator=(const LetterNode&) = delete;
 
-    vector<pair<char, LetterNode*>> m_childLetters; // sorted vector of succeeding chars
-    bool m_isWordValid; //indicates if node is the end of a valid word
-
-    LetterNode* findChild(char letter);
+    LetterNode* findChild(char letter) const;
     void insertChild(char letter, LetterNode* child);
+    size_t childPosition(char letter) const;
+
+    size_t childCount() const { return m_childCount; }
+    const char* childLetters() const { return reinterpret_cast<const char*>(m_children + m_childCapacity); }
+    char childLetter(size_t position) const { return childLetters()[position]; }
+    LetterNode* childNode(size_t position) const { return m_children[position]; }
+    ChildArena* arena() const { return m_arena; }
+
+private:
+    LetterNode** m_children;    // m_childCapacity node pointers then m_childCapacity letters, nullptr while empty
+    ChildArena* m_arena;        // arena the block comes from, nullptr for the heap
+    uint16_t m_childCount;      // children in the block, a char has at most 256 values
+    uint16_t m_childCapacity;
+
+    void growChildren();
+    void releaseChildren();
+
+public:
+    bool m_isWordValid; //indicates if node is the end of a valid word, last so it packs next to the counts
 };
 
 
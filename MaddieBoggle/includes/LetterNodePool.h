@@ -6,24 +6,75 @@
 #define LETTER_NODE_POOL_H
 
 
+#include <cstdint>
 #include <vector>
 
+#include "ChildArena.h"
 #include "LetterNode.h"
 
 
 using namespace std;
 
 
+/// <summary>
+/// The LetterNodePool class hands out the nodes of a LetterNode trie. Nodes live in
+/// chunks, and a new chunk is only allocated once the previous ones are used up, so
+/// the pool grows with the dictionary instead of being sized up front. A chunk is
+/// never moved or resized, which keeps every node at the same address for as long
+/// as the pool holds it.
+///
+/// Chunks start at FIRST_CHUNK_SIZE nodes and double up to CHUNK_SIZE nodes, which
+/// is exactly one 2 MiB huge page, aligned to it and advised as one. A huge page is
+/// committed as a whole the first time it is touched, so only pools that fill it
+/// get one: a small dictionary keeps small chunks, and reserve(...) sizes the first
+/// chunk to the expected node count when that is less than a huge page.
+///
+/// Nodes are created with the pool's ChildArena (if any), so their child blocks
+/// don't take their storage from the heap either.
+///
+/// An optional node limit brings back a hard cap, and reserve(...) allocates the
+/// chunks for an expected number of nodes ahead of time (see estimateNodeCount).
+/// </summary>
 class LetterNodePool
 {
 public:
-    LetterNodePool(size_t poolSize);
+    static constexpr size_t NO_NODE_LIMIT{ SIZE_MAX };
+    static constexpr size_t CHUNK_BYTES{ size_t{ 2 } << 20 };  // one huge page
+    static constexpr size_t CHUNK_SIZE{ CHUNK_BYTES / sizeof(LetterNode) };
+    static constexpr size_t FIRST_CHUNK_SIZE{ 1024 };
+
+    LetterNodePool(size_t nodeLimit = NO_NODE_LIMIT, ChildArena* childArena = nullptr);
+    ~LetterNodePool();
+    LetterNodePool(const LetterNodePool&) = delete;
+    LetterNodePool& operator=(const LetterNodePool&) = delete;
+    LetterNodePool(LetterNodePool&& other) noexcept;
+    LetterNodePool& operator=(LetterNodePool&& other) noexcept;
+
     LetterNode* allocate();
+    bool allocateRegion(size_t count, vector<LetterNode*>& region);
     void deallocate(LetterNode* node);
+    void reserve(size_t nodeCount);
+    void release();
+
+    size_t capacity() const { return m_capacity; }
+    size_t nodesInUse() const { return m_nodesCreated - m_freeNodes.size(); }
+    size_t nodeLimit() const { return m_nodeLimit; }
+    static size_t estimateNodeCount(size_t fileBytes);
 
 protected:
-    vector<LetterNode> m_pool;          // reserved memory
-    vector<LetterNode*> m_freeNodes;    // contains pointers to all the reserved memory blocks that are available for allocation
+    vector<LetterNode*> m_chunks;       // in allocation order
+    vector<size_t> m_chunkSizes;        // nodes in each chunk, CHUNK_SIZE for a huge page
+    size_t m_capacity;                  // nodes in all the chunks together
+    size_t m_nodesCreated;              // nodes constructed so far, the next one is created at this index
+    size_t m_currentChunk;              // chunk the next node is created in
+    size_t m_currentChunkStart;         // nodes in the chunks before the current one
+    vector<LetterNode*> m_freeNodes;    // deallocated nodes, handed out again before new ones are created
+    size_t m_nodeLimit;                 // most nodes that can ever be created
+    ChildArena* m_childArena;           // arena of every created node's children, nullptr for the heap
+
+private:
+    LetterNode* createNode();
+    void addChunk(size_t nodeCount);
 };
 
 
@@ -0,0 +1,57 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ErrorCodes.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// The MappedFile class maps a whole file read-only into memory. The operating
+/// system pages the file in on demand and shares the pages between every process
+/// that maps the same file, so nothing is copied onto the heap.
+///
+/// Pipes, FIFOs and other files that can't be mapped (and don't know their size
+/// up front) are read into a buffer the object owns instead, so a dictionary or
+/// board can still come from e.g. <(...) or /dev/stdin.
+///
+/// The mapping stays valid until the object is destroyed. Copying is not allowed
+/// since the mapping can only be released once.
+/// </summary>
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ErrorCode open(const string& filepath);
+    void close();
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool isOpen() const { return m_data != nullptr; }
+
+private:
+    const char* m_data;     // start of the mapped file, nullptr if nothing is mapped
+    size_t m_size;          // size of the mapped file in bytes
+    vector<char> m_buffer;  // content of a file that could not be mapped, empty for a mapping
+
+#ifdef _WIN32
+    void* m_file;           // HANDLE of the open file
+    void* m_mapping;        // HANDLE of the file mapping object
+#endif
+};
+
+
+#endif // MAPPED_FILE_H
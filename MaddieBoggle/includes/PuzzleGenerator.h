@@ -0,0 +1,66 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef PUZZLE_GENERATOR_H
+#define PUZZLE_GENERATOR_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BoggleBoard.h"
+#include "ErrorCodes.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// The PuzzleGenerator class makes random boards and dictionaries for scaling tests.
+/// Everything is drawn from one seeded random engine, so the same seed and the same
+/// calls always give the same boards and words. The standard distributions are not
+/// the same on every platform, so only the engine's raw output is used.
+///
+/// Boards are rolled with real Boggle dice. Boards of up to 16 cells use the 16 dice
+/// of classic Boggle, bigger ones the 25 dice of Big Boggle. The dice are shaken in a
+/// bag and each cell takes the next die, rolled. When the bag is empty, every die goes
+/// back in and the bag is shaken again, so big boards keep the letter mix of the dice:
+///
+///   4x4:    every die once
+///   10x10:  the 25 dice four times over
+///
+/// The "Qu" face is a plain 'q', like on every other board this solver reads.
+///
+/// Dictionaries are made of random words. Letters are drawn with their frequency in
+/// English text, and lengths with the provided weights (see defaultLengthWeights()).
+/// The words don't share prefixes the way real words do, so a synthetic dictionary
+/// makes a bushier trie than a real one of the same size.
+/// </summary>
+class PuzzleGenerator
+{
+public:
+    static constexpr size_t CLASSIC_CELLS{ 16 };    // biggest board rolled with the classic dice
+
+    explicit PuzzleGenerator(uint32_t seed);
+
+    BoggleBoard generateBoard(size_t rows, size_t columns);
+    BoggleBoard generateRaggedBoard(size_t rows, size_t minColumns, size_t maxColumns);
+    vector<string> generateWords(size_t wordCount, const vector<double>& lengthWeights = defaultLengthWeights());
+
+    static vector<double> defaultLengthWeights();
+    static ErrorCode writeBoard(const BoggleBoard& board, const string& filepath);
+    static ErrorCode writeWords(const vector<string>& words, const string& filepath);
+
+private:
+    mt19937 m_random;               // the one source of randomness, see the class description
+    vector<const char*> m_bag;      // faces of the dice not rolled yet for the current board, the next one is at the back
+
+    size_t pick(size_t count);
+    size_t pickWeighted(const vector<double>& weights, double totalWeight);
+    void fillBoard(BoggleBoard& board);
+};
+
+
+#endif // PUZZLE_GENERATOR_H
@@ -0,0 +1,71 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef STATS_REPORT_H
+#define STATS_REPORT_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// Format StatsReport::write(...) writes the report in.
+/// </summary>
+enum class StatsFormat
+{
+    TEXT,   // aligned tables for a person to read
+    JSON    // a single JSON object for scripts
+};
+
+
+/// <summary>
+/// The StatsReport class collects what a run of the application spent its time on
+/// (see --stats): the wall time of every phase, named counters, and the busy and
+/// queue wait time of every thread pool worker.
+///
+/// Phases are timed back to back, starting a phase ends the one before it:
+///
+///   startPhase("dictionary_import")  --> dictionary_import starts
+///   startPhase("solve")              --> dictionary_import ends, solve starts
+///   endPhase()                       --> solve ends
+///
+/// Names are written as they are, so they are kept to lower case and underscores
+/// to be valid JSON keys and line up in the text tables.
+/// </summary>
+class StatsReport
+{
+public:
+    StatsReport();
+
+    void startPhase(const string& name);
+    void endPhase();
+    void addCounter(const string& name, uint64_t value);
+    void setWorkers(const vector<WorkerStats>& workers);
+    void write(ostream& output, StatsFormat format) const;
+
+    const vector<pair<string, double>>& getPhases() const { return m_phases; }
+    const vector<pair<string, uint64_t>>& getCounters() const { return m_counters; }
+
+private:
+    vector<pair<string, double>> m_phases;      // name and milliseconds of every ended phase, in order
+    vector<pair<string, uint64_t>> m_counters;  // name and value of every counter, in order
+    vector<WorkerStats> m_workers;              // one per thread pool worker
+    string m_currentPhase;                      // phase being timed, empty if none
+    chrono::steady_clock::time_point m_phaseStart;
+
+    void writeText(ostream& output) const;
+    void writeJson(ostream& output) const;
+};
+
+
+#endif // STATS_REPORT_H
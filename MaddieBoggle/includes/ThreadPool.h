@@ -6,8 +6,12 @@
 #define THREAD_POOL_H
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <queue>
@@ -17,25 +21,113 @@
 using namespace std;
 
 
+/// <summary>
+/// How a ThreadPool hands queued tasks to its worker threads.
+/// </summary>
+enum class TaskScheduling
+{
+    SHARED_QUEUE,   // one queue and one lock shared by every worker
+    WORK_STEALING   // a deque per worker, idle workers steal from the others
+};
+
+
+/// <summary>
+/// Time a single worker spent on tasks, see ThreadPool::setCollectStats(...).
+/// </summary>
+struct WorkerStats
+{
+    size_t m_tasksRun;              // tasks run by the worker while stats were collected
+    double m_busyMilliseconds;      // time spent running those tasks
+    double m_queueWaitMilliseconds; // time those tasks spent queued before the worker took them
+};
+
+
 /// <summary>
 /// Boiler-plate thread pool class for running various tasks in parallel. Parallelized tasks
 /// will be added to a queue for the next available thread to grab and execute.
 /// 
+/// With TaskScheduling::SHARED_QUEUE, every task goes through a single queue guarded by
+/// one mutex. With TaskScheduling::WORK_STEALING, every worker owns a deque instead:
+///
+///   queueTask from outside the pool  --> deques are filled round robin
+///   queueTask from inside a task     --> back of the running worker's own deque
+///   worker looking for a task        --> back of its own deque (newest first), then
+///                                        the front of the other deques (oldest first)
+///
+/// Workers only contend when one of them steals, and a worker that runs out of tasks
+/// takes over the tasks still waiting behind a long running one, instead of idling
+/// while the others finish. The API is the same for both modes.
+/// 
+/// idleWorkers() tells tasks if there are workers with nothing to do, so a long
+/// running task can hand part of its work to them (see BoggleSolver).
+/// 
 /// Can be initialized with custom thread count (pool size); otherwise, it will default to 
 /// using the "hardware optimal" number of threads as defined by thread::hardware_concurrency.
+/// 
+/// Every worker thread knows its own index in the pool (see workerIndex()), which lets
+/// tasks write to per-worker buffers without any locking. The index is only given to
+/// workers of the pool asked, so two pools never hand the same buffer to two threads.
+/// 
+/// With setCollectStats(true), every worker also keeps track of how many tasks it ran,
+/// how long it was busy running them and how long they were queued (see WorkerStats).
+/// It costs two clock reads per task, so it is off by default.
 /// </summary>
 class ThreadPool
 {
 public:
-    ThreadPool(size_t threadCount = thread::hardware_concurrency());
+    ThreadPool(size_t threadCount = thread::hardware_concurrency(), TaskScheduling scheduling = TaskScheduling::WORK_STEALING);
     ~ThreadPool();
 
+    static constexpr size_t NOT_A_WORKER{ SIZE_MAX };
+
     void queueTask(function<void()> task);
     void waitForCompletion();
 
+    size_t threadCount() const { return m_pool.size(); }
+    TaskScheduling scheduling() const { return m_scheduling; }
+    size_t stolenTasks() const { return m_stolenTasks.load(); }
+    size_t idleWorkers() const;
+    size_t workerIndex() const;
+
+    void setCollectStats(bool collectStats) { m_collectStats.store(collectStats); }
+    vector<WorkerStats> getWorkerStats() const;
+
 private:
+    /* A task along with the time it was queued at, which is only set while
+    stats are collected. */
+    struct QueuedTask
+    {
+        function<void()> m_task;
+        chrono::steady_clock::time_point m_queuedAt;
+    };
+
+    /* Tasks of a single worker in the work stealing mode. Aligned to a cache
+    line so locking one deque doesn't invalidate its neighbours. */
+    struct alignas(64) WorkerTasks
+    {
+        mutex m_mutex;
+        deque<QueuedTask> m_tasks;          // the owner takes from the back, thieves from the front
+    };
+
+    /* Stats of a single worker, only written by the worker itself. Atomic so
+    they can be read while the worker runs. */
+    struct alignas(64) WorkerCounters
+    {
+        atomic<uint64_t> m_tasksRun;
+        atomic<uint64_t> m_busyNanoseconds;
+        atomic<uint64_t> m_queueWaitNanoseconds;
+    };
+
+    const TaskScheduling m_scheduling;
     vector<thread> m_pool;              // vector pool of threads
-    queue<function<void()>> m_tasks;    // queue of tasks 
+    queue<QueuedTask> m_tasks;          // queue of tasks, shared queue mode only
+    unique_ptr<WorkerTasks[]> m_workerTasks;    // one per worker, work stealing mode only
+    unique_ptr<WorkerCounters[]> m_workerCounters;  // one per worker
+    atomic<bool> m_collectStats;        // see setCollectStats(...)
+    atomic<size_t> m_queuedTasks;       // tasks waiting in the queue or the worker deques
+    atomic<size_t> m_sleepingWorkers;   // workers waiting on m_taskPresent
+    atomic<size_t> m_nextWorker;        // round robin target for tasks queued from outside the pool
+    atomic<size_t> m_stolenTasks;       // tasks taken from another worker's deque
 
     mutex m_queueMutex;                 // mutex used to take/add tasks to the queue
     condition_variable m_taskPresent;   // condition threads wait on until notified of a task to execute
@@ -43,7 +135,11 @@ private:
     bool m_stop;                        // flag used to tell threads to end and close
     atomic<size_t> m_activeTasks;       // keeps track of number of active tasks
 
-    void workerThread();
+    void workerThread(size_t index);
+    void stealingWorkerThread(size_t index);
+    bool takeTask(size_t index, QueuedTask& task);
+    void runTask(size_t index, QueuedTask& task);
+    void finishTask();
 };
 
 
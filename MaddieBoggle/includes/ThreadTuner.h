@@ -0,0 +1,82 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef THREAD_TUNER_H
+#define THREAD_TUNER_H
+
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include "BoggleBoard.h"
+#include "BoggleSolver.h"
+#include "Dictionary.h"
+#include "ThreadPool.h"
+
+
+using namespace std;
+
+
+/// <summary>
+/// Wall time of the calibration solves run with one combination of settings.
+/// </summary>
+struct TuningResult
+{
+    size_t m_threadCount;       // threads in the pool
+    size_t m_splitDepth;        // see BoggleSolver
+    double m_milliseconds;      // fastest calibration solve with these settings
+};
+
+
+/// <summary>
+/// The ThreadTuner class picks the thread count and task granularity (the split depth
+/// of BoggleSolver) that solve a board the fastest with the current dictionary. The
+/// best settings depend on the machine, the dictionary and the board size, so they are
+/// measured instead of guessed:
+///
+///   thread counts:  1, 2, 4, 8, ... up to maxThreads (and maxThreads itself)
+///   split depths:   1 (one task per node) to BoggleSolver::MAX_SPLIT_DEPTH
+///
+/// Every thread count gets its own pool, which is warmed up with one untimed solve.
+/// Each combination is then solved once, so a 64 thread machine runs 28 calibration
+/// solves (7 thread counts, 1 warm up and 3 split depths each) before the real one.
+/// With more runs, the fastest solve of each combination is kept, since the slower
+/// ones only add noise from the rest of the machine.
+///
+/// The calibration solves use the same word lengths, board trie and engine as the
+/// solve being tuned, so the settings are measured on the same workload.
+/// </summary>
+class ThreadTuner
+{
+public:
+    static constexpr size_t DEFAULT_RUNS{ 1 };
+
+    ThreadTuner(shared_ptr<const Dictionary> dictionary, const BoggleBoard& board, TaskScheduling scheduling,
+        WordLengthRange lengths = {}, bool useBoardTrie = false, SearchEngine engine = SearchEngine::AUTO,
+        size_t maxThreads = thread::hardware_concurrency(), size_t runs = DEFAULT_RUNS);
+
+    TuningResult tune();
+    void report(ostream& log) const;
+
+    const vector<TuningResult>& getResults() const { return m_results; }
+    static vector<size_t> threadCandidates(size_t maxThreads);
+
+private:
+    shared_ptr<const Dictionary> m_dictionary;  // thread safe dictionary the calibration board is solved with
+    const BoggleBoard& m_board;                 // calibration board
+    const TaskScheduling m_scheduling;          // scheduling of every calibration pool
+    const WordLengthRange m_lengths;            // solver options of the calibration solves, see BoggleSolver
+    const bool m_useBoardTrie;
+    const SearchEngine m_engine;
+    const size_t m_maxThreads;
+    const size_t m_runs;                        // timed solves per combination
+    vector<TuningResult> m_results;             // one per combination, in the order they were run
+    TuningResult m_best;
+
+    double timeSolve(shared_ptr<ThreadPool> pool, size_t splitDepth) const;
+};
+
+
+#endif // THREAD_TUNER_H
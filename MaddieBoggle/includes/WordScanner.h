@@ -0,0 +1,72 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifndef WORD_SCANNER_H
+#define WORD_SCANNER_H
+
+#include <cstddef>
+#include <deque>
+#include <string>
+
+
+using namespace std;
+
+
+/// <summary>
+/// Word that points into a text buffer instead of owning its letters. It is only
+/// valid while the buffer it points into is.
+/// </summary>
+struct WordView
+{
+    const char* m_data;     // first letter of the word
+    size_t m_length;        // letters in the word
+
+    /* Same order as comparing the words as strings. */
+    bool operator<(const WordView& other) const
+    {
+        const auto shorter{ (m_length < other.m_length) ? m_length : other.m_length };
+        const auto order{ char_traits<char>::compare(m_data, other.m_data, shorter) };
+        return (order < 0) || ((order == 0) && (m_length < other.m_length));
+    }
+};
+
+
+/// <summary>
+/// The WordScanner class splits a text buffer, usually a whole mapped dictionary
+/// file (see MappedFile), into words the same way reading a string from a stream
+/// does: a word is anything between whitespace.
+///
+/// The words point straight into the buffer, so nothing is copied or allocated
+/// for them. Each word is also checked on the way:
+///   - 'A'-'Z' are lowercased, the only words that are copied (see below)
+///   - a word with anything else than a letter is skipped, it can't be on a board
+///
+///   "Apple\nbee's\r\ncat"  -->  apple, cat    (1 skipped)
+///
+/// The buffer is read 16 bytes at a time with SSE2 where the compiler targets it,
+/// finding where the word ends and what it holds in the same pass, and one byte at
+/// a time otherwise. A word with upper case letters is lowercased into a string of
+/// the scanner, so every word stays valid as long as both the buffer and the
+/// scanner do.
+/// </summary>
+class WordScanner
+{
+public:
+    WordScanner(const char* data, size_t size);
+
+    bool next(WordView& word);
+
+    size_t skippedWords() const { return m_skippedWords; }
+
+private:
+    const char* m_position;     // next byte to scan
+    const char* m_end;          // end of the buffer
+    deque<string> m_lowered;    // lowercased copies, a deque so earlier words don't move
+    size_t m_skippedWords;      // words skipped for holding something else than letters
+
+    void scanWord(bool& hasUpper, bool& hasOther);
+};
+
+
+#endif // WORD_SCANNER_H
@@ -0,0 +1,348 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+#include "AnswerWriter.h"
+#include "Dictionary.h"
+
+
+#ifdef _WIN32
+static constexpr int STDOUT_DESCRIPTOR{ 1 };
+#else
+static constexpr int STDOUT_DESCRIPTOR{ STDOUT_FILENO };
+#endif
+
+
+/// <summary>
+/// Number of letters two words start with in common.
+/// </summary>
+/// <param name="previous">word before, nullptr for the first word</param>
+/// <param name="word">word after it</param>
+/// <returns>length of the shared prefix, 0 if there is no word before</returns>
+static size_t sharedPrefix(const string* previous, const string& word)
+{
+    if (previous == nullptr) return 0;
+
+    const auto limit{ (previous->size() < word.size()) ? previous->size() : word.size() };
+    size_t shared{ 0 };
+    while ((shared < limit) && ((*previous)[shared] == word[shared])) shared++;
+    return shared;
+}
+
+
+/// <summary>
+/// Class constructor. Nothing is written until open(...) or attach(...) is called.
+/// </summary>
+/// <param name="format">format to write the answers in</param>
+AnswerWriter::AnswerWriter(AnswerFormat format) :
+    m_format(format),
+    m_descriptor(NO_DESCRIPTOR),
+    m_ownsDescriptor(false),
+    m_failed(false),
+    m_buffer(BUFFER_SIZE),
+    m_used(0)
+{
+    // intentionally blank
+}
+
+
+/// <summary>
+/// Class destructor. Writes out whatever is still buffered, see close().
+/// </summary>
+AnswerWriter::~AnswerWriter()
+{
+    close();
+}
+
+
+/// <summary>
+/// Reads a format from its command line name: text, json, ids or front-coded.
+/// </summary>
+/// <param name="name">name of the format</param>
+/// <param name="format">set to the format, left as it was for an unknown name</param>
+/// <returns>false if the name is not a format</returns>
+bool AnswerWriter::parseFormat(const string& name, AnswerFormat& format)
+{
+    if (name == "text") format = AnswerFormat::TEXT;
+    else if (name == "json") format = AnswerFormat::JSON;
+    else if (name == "ids") format = AnswerFormat::WORD_IDS;
+    else if (name == "front-coded") format = AnswerFormat::FRONT_CODED;
+    else return false;
+    return true;
+}
+
+
+/// <summary>
+/// Extension of a file holding answers in the provided format, dot included.
+/// </summary>
+/// <param name="format">format of the file</param>
+/// <returns>".txt", ".json" or ".bin"</returns>
+string AnswerWriter::fileExtension(AnswerFormat format)
+{
+    switch (format)
+    {
+    case AnswerFormat::TEXT:        return ".txt";
+    case AnswerFormat::JSON:        return ".json";
+    case AnswerFormat::WORD_IDS:
+    case AnswerFormat::FRONT_CODED: return ".bin";
+    }
+    return ".txt";
+}
+
+
+/// <summary>
+/// Creates (or truncates) the provided file and writes to it. A filepath of "-"
+/// writes to stdout instead. Anything opened before is closed first.
+///
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 2 --> unable to open the output file
+/// </summary>
+/// <param name="filepath">file to write the answers to, "-" for stdout</param>
+/// <returns>error code</returns>
+ErrorCode AnswerWriter::open(const string& filepath)
+{
+    close();
+
+    if (filepath == "-")
+    {
+        cout.flush(); // anything already written to cout comes first
+#ifdef _WIN32
+        _setmode(STDOUT_DESCRIPTOR, _O_BINARY); // binary formats can't have '\n' turned into "\r\n"
+#endif
+        attach(STDOUT_DESCRIPTOR);
+        return ErrorCode::SUCCESS;
+    }
+
+#ifdef _WIN32
+    const int descriptor{ _open(filepath.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE) };
+#else
+    const int descriptor{ ::open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) };
+#endif
+    if (descriptor < 0)
+    {
+        cerr << "Error: Could not open file for writing at path: " << filepath << "\n";
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+
+    attach(descriptor);
+    m_ownsDescriptor = true;
+    return ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Writes to a file descriptor that is already open, like a pipe or socket handed
+/// over by the caller. The descriptor is left open by close(). Anything opened
+/// before is closed first.
+/// </summary>
+/// <param name="descriptor">open descriptor to write to</param>
+void AnswerWriter::attach(int descriptor)
+{
+    close();
+
+    m_descriptor = descriptor;
+    m_ownsDescriptor = false;
+    m_failed = false;
+}
+
+
+/// <summary>
+/// Writes the answers in the format of the writer. They can only be written once
+/// per open(...) or attach(...), as a single document.
+///
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 2 --> nothing is open, or a write failed
+/// </summary>
+/// <param name="answers">sorted answers of a board</param>
+/// <param name="dictionary">compiled trie of the dictionary the word ids are taken from</param>
+/// <returns>error code</returns>
+ErrorCode AnswerWriter::write(const set<string>& answers, const CompiledTrie& dictionary)
+{
+    if (!isOpen()) return ErrorCode::UNKNOWN_FILE_ERR; // early return, nowhere to write
+
+    switch (m_format)
+    {
+    case AnswerFormat::TEXT:
+        for (const auto& answer : answers)
+        {
+            put(answer);
+            put("\n", 1);
+        }
+        break;
+
+    case AnswerFormat::JSON:
+    {
+        put("{ \"count\": " + to_string(answers.size()) + ", \"answers\": [");
+        for (auto it = answers.begin(); it != answers.end(); ++it)
+        {
+            if (it != answers.begin()) put(",", 1);
+            put(" \"", 2);
+            put(*it);
+            put("\"", 1);
+        }
+        put(" ] }\n", 5);
+        break;
+    }
+
+    case AnswerFormat::WORD_IDS:
+    {
+        put("MBID", 4);
+        putVarint(answers.size());
+
+        /* One cursor walks every answer, it only steps back to where the answer
+        stops sharing the previous one's letters. */
+        DictionaryCursor cursor(dictionary);
+        const string* previous{ nullptr };
+        uint32_t previousId{ 0 };
+        for (const auto& answer : answers)
+        {
+            const auto shared{ sharedPrefix(previous, answer) };
+            while (cursor.depth() > shared) cursor.stepBack();
+            for (auto i = shared; i < answer.size(); i++) cursor.advance(answer[i]);
+            assert(cursor.isWord()); // every answer is a dictionary word
+
+            // sorted words have rising ids
+            const auto wordId{ cursor.wordId() };
+            putVarint(wordId - previousId);
+            previousId = wordId;
+            previous = &answer;
+        }
+        break;
+    }
+
+    case AnswerFormat::FRONT_CODED:
+    {
+        put("MBFC", 4);
+        putVarint(answers.size());
+        const string* previous{ nullptr };
+        for (const auto& answer : answers)
+        {
+            const auto shared{ sharedPrefix(previous, answer) };
+            putVarint(shared);
+            putVarint(answer.size() - shared);
+            put(answer.data() + shared, answer.size() - shared);
+            previous = &answer;
+        }
+        break;
+    }
+    }
+
+    flush();
+    return m_failed ? ErrorCode::UNKNOWN_FILE_ERR : ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Writes out whatever is still buffered and closes the file, unless it was
+/// attached or is stdout. Does nothing if nothing is open.
+///
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 2 --> a write failed
+/// </summary>
+/// <returns>error code</returns>
+ErrorCode AnswerWriter::close()
+{
+    if (!isOpen()) return ErrorCode::SUCCESS; // early return, nothing to close
+
+    flush();
+    if (m_ownsDescriptor)
+    {
+#ifdef _WIN32
+        if (_close(m_descriptor) != 0) m_failed = true;
+#else
+        if (::close(m_descriptor) != 0) m_failed = true;
+#endif
+    }
+
+    const auto failed{ m_failed };
+    m_descriptor = NO_DESCRIPTOR;
+    m_ownsDescriptor = false;
+    m_failed = false;
+    return failed ? ErrorCode::UNKNOWN_FILE_ERR : ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Adds bytes to the buffer, writing it out every time it fills up.
+/// </summary>
+/// <param name="data">bytes to add</param>
+/// <param name="size">number of bytes</param>
+void AnswerWriter::put(const char* data, size_t size)
+{
+    // a word nearly always fits in what is left of the buffer
+    if (size < BUFFER_SIZE - m_used)
+    {
+        memcpy(m_buffer.data() + m_used, data, size);
+        m_used += size;
+        return; // early return, nothing to write out yet
+    }
+
+    while (size > 0)
+    {
+        const auto room{ BUFFER_SIZE - m_used };
+        const auto taken{ (size < room) ? size : room };
+        memcpy(m_buffer.data() + m_used, data, taken);
+        m_used += taken;
+        data += taken;
+        size -= taken;
+
+        if (m_used == BUFFER_SIZE) flush();
+    }
+}
+
+
+/// <summary>
+/// Adds a number as an unsigned LEB128 varint (see the class description).
+/// </summary>
+/// <param name="value">number to add</param>
+void AnswerWriter::putVarint(uint64_t value)
+{
+    char bytes[10];     // 64 bits take at most 10 bytes of 7
+    size_t size{ 0 };
+    do
+    {
+        const auto low{ static_cast<char>(value & 0x7F) };
+        value >>= 7;
+        bytes[size++] = static_cast<char>((value != 0) ? (low | 0x80) : low);
+    } while (value != 0);
+    put(bytes, size);
+}
+
+
+/// <summary>
+/// Writes out the buffer. Partial writes are carried on and interrupted ones
+/// retried. Once a write fails, the rest of the answers are dropped.
+/// </summary>
+void AnswerWriter::flush()
+{
+    size_t written{ 0 };
+    while (!m_failed && (written < m_used))
+    {
+#ifdef _WIN32
+        const auto result{ _write(m_descriptor, m_buffer.data() + written, static_cast<unsigned int>(m_used - written)) };
+#else
+        const auto result{ ::write(m_descriptor, m_buffer.data() + written, m_used - written) };
+        if ((result < 0) && (errno == EINTR)) continue;
+#endif
+        if (result <= 0) m_failed = true;
+        else written += static_cast<size_t>(result);
+    }
+    m_used = 0;
+}
@@ -0,0 +1,245 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+#include "BatchSolver.h"
+#include "BoggleBoard.h"
+#include "BoggleSolver.h"
+
+
+namespace fs = std::filesystem;
+
+
+/// <summary>
+/// Class constructor for the batch solver.
+/// </summary>
+/// <param name="dictionary">shared_ptr to a const, frozen dictionary of valid words</param>
+/// <param name="pool">shared ptr to a thread pool</param>
+/// <param name="splitDepth">optional split depth of every board's solver, see BoggleSolver</param>
+/// <param name="lengths">optional lengths of the words to find, every length by default</param>
+/// <param name="useBoardTrie">optional, true to search a BoardTrie of the dictionary built for every board</param>
+/// <param name="engine">optional engine of every board's solver, see BoggleSolver</param>
+/// <param name="format">optional format of the answer files, text by default</param>
+BatchSolver::BatchSolver(shared_ptr<const Dictionary> dictionary, shared_ptr<ThreadPool> pool, size_t splitDepth, WordLengthRange lengths,
+    bool useBoardTrie, SearchEngine engine, AnswerFormat format) :
+    m_dictionary(dictionary),
+    m_pool(pool),
+    m_splitDepth(splitDepth),
+    m_lengths(lengths),
+    m_useBoardTrie(useBoardTrie),
+    m_engine(engine),
+    m_format(format),
+    m_entries(),
+    m_results()
+{
+    assert(m_dictionary);
+    assert(m_pool);
+}
+
+
+/// <summary>
+/// Adds every board found at the provided path to the batch, see listBoards(...).
+/// </summary>
+/// <param name="boardsPath">directory of boards or board manifest file</param>
+/// <param name="outputDirectory">directory to write the answer files to</param>
+/// <returns>error code</returns>
+ErrorCode BatchSolver::collectBoards(const string& boardsPath, const string& outputDirectory)
+{
+    vector<BatchEntry> entries{};
+    const auto errorCode{ listBoards(boardsPath, outputDirectory, entries, m_format) };
+
+    for (const auto& entry : entries)
+    {
+        addBoard(entry.m_boardPath, entry.m_outputPath);
+    }
+    return errorCode;
+}
+
+
+/// <summary>
+/// Lists every board found at the provided path. The path can either be a directory
+/// (every file in it is a board, in name order) or a manifest file with one board
+/// path per line. The answers for a board named "name.txt" are written to
+/// "name_answers.txt" in the output directory, which is created if needed. Other
+/// formats get their own extension instead (see AnswerWriter::fileExtension).
+/// Boards with the same name in different directories would write over each
+/// other's answers, so that is an error and no board is listed at all.
+/// 
+/// Static so the boards can be looked at before the batch (and its thread pool) exists.
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 1 --> the boards path does not exist
+/// 2 --> unprecendented error saved by a try-catch block, the directory or manifest
+///     could not be read or the output directory could not be created
+/// 8 --> two boards would write their answers to the same file
+/// </summary>
+/// <param name="boardsPath">directory of boards or board manifest file</param>
+/// <param name="outputDirectory">directory to write the answer files to</param>
+/// <param name="entries">boards found are appended to this</param>
+/// <param name="format">optional format of the answer files, text by default</param>
+/// <returns>error code</returns>
+ErrorCode BatchSolver::listBoards(const string& boardsPath, const string& outputDirectory, vector<BatchEntry>& entries, AnswerFormat format)
+{
+    try
+    {
+        if (!fs::exists(boardsPath))
+        {
+            cerr << "Error finding file at path: " << boardsPath << ".\n";
+            return ErrorCode::FILE_NOT_FOUND;
+        }
+
+        vector<fs::path> boards{};
+        if (fs::is_directory(boardsPath))
+        {
+            for (const auto& entry : fs::directory_iterator(boardsPath))
+            {
+                if (entry.is_regular_file()) boards.push_back(entry.path());
+            }
+            sort(boards.begin(), boards.end()); // directory order is not defined
+        }
+        else
+        {
+            const auto manifestDirectory{ fs::path(boardsPath).parent_path() };
+            ifstream manifest(boardsPath);
+            string line{};
+            while (getline(manifest, line))
+            {
+                // trim trailing whitespace, which includes the '\r' of windows line endings
+                line.erase(line.find_last_not_of(" \t\r") + 1);
+                if (line.empty() || (line[0] == '#')) continue;
+
+                const fs::path board{ line };
+                boards.push_back(board.is_absolute() ? board : (manifestDirectory / board));
+            }
+        }
+
+        vector<BatchEntry> listed{};
+        map<string, string> boardOfOutput{};   // answer file --> board writing it
+        for (const auto& board : boards)
+        {
+            const auto output{ fs::path(outputDirectory) / (board.stem().string() + "_answers" + AnswerWriter::fileExtension(format)) };
+            const auto [existing, isNew] { boardOfOutput.emplace(output.string(), board.string()) };
+            if (!isNew)
+            {
+                cerr << "Error: Boards " << existing->second << " and " << board.string()
+                    << " would both write their answers to: " << output.string() << "\n";
+                return ErrorCode::DUPLICATE_OUTPUT;
+            }
+            listed.push_back({ board.string(), output.string() });
+        }
+
+        fs::create_directories(outputDirectory);
+        entries.insert(entries.end(), listed.begin(), listed.end());
+        return ErrorCode::SUCCESS;
+    }
+    catch (...)
+    {
+        cerr << "Unexpected error when collecting boards from: " << boardsPath << "\n";
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+}
+
+
+/// <summary>
+/// Adds a single board to the end of the batch.
+/// </summary>
+/// <param name="boardPath">location of the board file</param>
+/// <param name="outputPath">location to write the board's answers to</param>
+void BatchSolver::addBoard(const string& boardPath, const string& outputPath)
+{
+    m_entries.push_back({ boardPath, outputPath });
+}
+
+
+/// <summary>
+/// Solves every board in the batch, in order. The time and word count of every
+/// board, followed by the totals for the whole batch, are written to the log.
+/// 
+/// Returns SUCCESS if every board was solved, otherwise the error code of the last
+/// board that failed. Failed boards don't stop the batch.
+/// </summary>
+/// <param name="log">stream to write the timing report to</param>
+/// <returns>error code</returns>
+ErrorCode BatchSolver::solveAll(ostream& log)
+{
+    m_results.clear();
+    m_results.reserve(m_entries.size());
+
+    ErrorCode status{ ErrorCode::SUCCESS };
+    size_t failedBoards{ 0 };
+    size_t totalWords{ 0 };
+    double totalMilliseconds{ 0.0 };
+    double slowestMilliseconds{ 0.0 };
+
+    const auto flags{ log.flags() };
+    const auto precision{ log.precision() };
+    log << fixed << setprecision(3);
+    for (const auto& entry : m_entries)
+    {
+        const auto result{ solveBoard(entry) };
+        m_results.push_back(result);
+
+        totalMilliseconds += result.m_milliseconds;
+        slowestMilliseconds = max(slowestMilliseconds, result.m_milliseconds);
+
+        if (result.m_errorCode != ErrorCode::SUCCESS)
+        {
+            status = result.m_errorCode;
+            failedBoards++;
+            log << entry.m_boardPath << ": failed with error " << static_cast<int>(result.m_errorCode) << "\n";
+            continue;
+        }
+
+        totalWords += result.m_wordCount;
+        log << entry.m_boardPath << ": " << result.m_wordCount << " words in " << result.m_milliseconds << " ms\n";
+    }
+
+    const auto meanMilliseconds{ m_entries.empty() ? 0.0 : (totalMilliseconds / m_entries.size()) };
+    log << "Batch: " << m_entries.size() << " boards (" << failedBoards << " failed), " 
+        << totalWords << " words in " << totalMilliseconds << " ms, mean " << meanMilliseconds 
+        << " ms, slowest " << slowestMilliseconds << " ms\n";
+
+    log.flags(flags);
+    log.precision(precision);
+    return status;
+}
+
+
+/// <summary>
+/// Imports, solves and exports a single board. The board only lives for the
+/// duration of this call, so memory use doesn't grow with the size of the batch.
+/// </summary>
+/// <param name="entry">board to solve</param>
+/// <returns>result of the board</returns>
+BatchResult BatchSolver::solveBoard(const BatchEntry& entry)
+{
+    const auto start{ chrono::steady_clock::now() };
+    auto elapsed = [&start]() {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    BoggleBoard board{};
+    auto errorCode{ importBoard(entry.m_boardPath, board) };
+    if (errorCode != ErrorCode::SUCCESS) return { errorCode, 0, elapsed(), {} }; // early return
+
+    BoggleSolver solver(m_dictionary, m_pool, board, m_splitDepth, m_lengths, m_useBoardTrie, m_engine);
+    errorCode = solver.solveBoard();
+    if (errorCode != ErrorCode::SUCCESS) return { errorCode, 0, elapsed(), {} }; // early return, nothing was searched
+
+    m_pool->waitForCompletion();
+    errorCode = solver.exportAnswers(entry.m_outputPath, m_format);
+
+    // the answer count merges the answers, which brings the search statistics up to date
+    const auto wordCount{ solver.answerCount() };
+    return { errorCode, wordCount, elapsed(), solver.getSearchStats() };
+}
@@ -0,0 +1,82 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <cassert>
+
+#include "BoardGraph.h"
+#include "BoggleSolverHelper.h"
+
+
+/// <summary>
+/// Class constructor. Flattens the board letters into cells, precomputes the
+/// neighbour table for every cell using the direction checks in BoggleSolverHelper.h
+/// and indexes the cells by letter.
+/// </summary>
+/// <param name="board">board to build the graph from, rows may have different sizes</param>
+BoardGraph::BoardGraph(const BoggleBoard& board) :
+    m_letters(),
+    m_rowOffsets(),
+    m_neighbours(),
+    m_neighbourCounts(),
+    m_letterCells(),
+    m_letterStarts()
+{
+    // flatten the letters row by row, remembering where each row starts
+    m_rowOffsets.reserve(board.size());
+    for (const auto& row : board)
+    {
+        m_rowOffsets.push_back(m_letters.size());
+        m_letters.insert(m_letters.end(), row.begin(), row.end());
+    }
+
+    m_neighbours.resize(m_letters.size() * MAX_NEIGHBOURS);
+    m_neighbourCounts.resize(m_letters.size());
+
+    for (size_t row = 0; row < board.size(); row++)
+    {
+        for (size_t col = 0; col < board[row].size(); col++)
+        {
+            const auto cell{ cellIndex(row, col) };
+            auto slot{ &m_neighbours[cell * MAX_NEIGHBOURS] };
+            uint8_t count{ 0 };
+
+            auto addNeighbour = [&](size_t newRow, size_t newCol) {
+                slot[count++] = static_cast<uint32_t>(cellIndex(newRow, newCol));
+            };
+
+            //            !! ORDER OF CHECKS DEFINES THE SEARCH ORDER !!
+            if (checkNodeUp         (row, col, board)) addNeighbour(row - 1, col);
+            if (checkNodeUpRight    (row, col, board)) addNeighbour(row - 1, col + 1);
+            if (checkNodeRight      (row, col, board)) addNeighbour(row,     col + 1);
+            if (checkNodeDownRight  (row, col, board)) addNeighbour(row + 1, col + 1);
+            if (checkNodeDown       (row, col, board)) addNeighbour(row + 1, col);
+            if (checkNodeDownLeft   (row, col, board)) addNeighbour(row + 1, col - 1);
+            if (checkNodeUpLeft     (row, col, board)) addNeighbour(row - 1, col - 1);
+            if (checkNodeLeft       (col))             addNeighbour(row,     col - 1);
+
+            assert(count <= MAX_NEIGHBOURS);
+            m_neighbourCounts[cell] = count;
+        }
+    }
+
+    // counting sort of the cells by letter, which keeps every letter's cells in cell order
+    for (const auto letter : m_letters)
+    {
+        const auto offset{ static_cast<uint32_t>(letter - 'a') };
+        if (offset < ALPHABET_SIZE) m_letterStarts[offset + 1]++;
+    }
+    for (uint32_t offset = 0; offset < ALPHABET_SIZE; offset++)
+    {
+        m_letterStarts[offset + 1] += m_letterStarts[offset];
+    }
+
+    m_letterCells.resize(m_letterStarts[ALPHABET_SIZE]);
+    uint32_t next[ALPHABET_SIZE]{};
+    for (uint32_t cell = 0; cell < m_letters.size(); cell++)
+    {
+        const auto offset{ static_cast<uint32_t>(m_letters[cell] - 'a') };
+        if (offset < ALPHABET_SIZE) m_letterCells[m_letterStarts[offset] + next[offset]++] = cell;
+    }
+}
+
@@ -0,0 +1,223 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <cassert>
+
+#include "BoardTrie.h"
+
+
+/// <summary>
+/// Builds the trie of the dictionary words the board could spell (see the class
+/// description). The trie is replaced, whatever it held before.
+/// </summary>
+/// <param name="dictionary">frozen dictionary to cut down</param>
+/// <param name="graph">graph of the board</param>
+/// <param name="trie">trie to build</param>
+void BoardTrie::build(const Dictionary& dictionary, const BoardGraph& graph, CompiledTrie& trie)
+{
+    assert(dictionary.isFrozen());
+
+    auto letters{ readLetters(graph) };
+    vector<KeptNode> kept{};
+    keepBelow(dictionary.getCompiledTrie(), CompiledTrie::ROOT, letters.m_starters, letters, kept);
+    layOut(kept, trie);
+}
+
+
+/// <summary>
+/// Counts the letters of a board and the letters that follow each other on it.
+/// Anything but 'a'-'z' is left out, the dictionary has no such letters.
+/// </summary>
+/// <param name="graph">graph of the board</param>
+/// <returns>letters of the board</returns>
+BoardTrie::BoardLetters BoardTrie::readLetters(const BoardGraph& graph)
+{
+    BoardLetters letters{};
+    const auto offsetOf = [](char letter) { return static_cast<uint32_t>(letter - 'a'); };
+    const auto u{ offsetOf('u') };
+
+    for (size_t cell = 0; cell < graph.cellCount(); cell++)
+    {
+        const auto offset{ offsetOf(graph.letter(cell)) };
+        if (offset >= CompiledTrie::ALPHABET_SIZE) continue;
+
+        letters.m_counts[offset]++;
+        letters.m_starters |= (1u << offset);
+
+        // a 'q' cell spells "qu", the next cell follows the 'u'
+        auto last{ offset };
+        if (graph.letter(cell) == 'q')
+        {
+            letters.m_counts[u]++;
+            letters.m_followers[offset] |= (1u << u);
+            last = u;
+        }
+
+        for (const auto neighbour : graph.neighbours(cell))
+        {
+            const auto next{ offsetOf(graph.letter(neighbour)) };
+            if (next < CompiledTrie::ALPHABET_SIZE) letters.m_followers[last] |= (1u << next);
+        }
+    }
+
+    for (uint32_t offset = 0; offset < CompiledTrie::ALPHABET_SIZE; offset++)
+    {
+        if (letters.m_counts[offset] > 0) letters.m_available |= (1u << offset);
+    }
+    return letters;
+}
+
+
+/// <summary>
+/// Takes a letter off the board letters, see giveBack(...).
+/// </summary>
+/// <param name="count">count of the letter, at least 1</param>
+/// <param name="available">mask of the letters with a count left</param>
+/// <param name="offset">letter - 'a'</param>
+static void take(uint32_t& count, uint32_t& available, uint32_t offset)
+{
+    if (--count == 0) available &= ~(1u << offset);
+}
+
+
+/// <summary>
+/// Puts a letter taken with take(...) back.
+/// </summary>
+/// <param name="count">count of the letter</param>
+/// <param name="available">mask of the letters with a count left</param>
+/// <param name="offset">letter - 'a'</param>
+static void giveBack(uint32_t& count, uint32_t& available, uint32_t offset)
+{
+    count++;
+    available |= (1u << offset);
+}
+
+
+/// <summary>
+/// Walks the dictionary below a record, keeping every prefix that still leads to
+/// a word the board letters allow. Only children whose letter can follow the
+/// record and is still available are looked at. The recursion is only as deep as
+/// the longest word kept.
+/// </summary>
+/// <param name="source">compiled trie of the dictionary</param>
+/// <param name="node">record to walk below, with its whole label already taken</param>
+/// <param name="candidates">mask of the letters that can follow the record</param>
+/// <param name="letters">board letters, with the letters of the record's prefix already taken</param>
+/// <param name="kept">nodes kept so far, the record's node is appended if it is kept</param>
+/// <returns>index of the record's node in kept, NO_NODE if nothing below it is kept</returns>
+uint32_t BoardTrie::keepBelow(const CompiledTrie& source, uint32_t node, uint32_t candidates, BoardLetters& letters, vector<KeptNode>& kept)
+{
+    const auto index{ static_cast<uint32_t>(kept.size()) };
+    const auto record{ source.m_nodeData[node] };
+    const auto childLetters{ record.m_childMask & CompiledTrie::LETTER_MASK };
+    kept.push_back({ record.m_childMask & CompiledTrie::WORD_FLAG, CompiledTrie::NO_NODE, CompiledTrie::NO_NODE });
+
+    uint32_t lastChild{ CompiledTrie::NO_NODE };
+    for (auto wanted = childLetters & candidates & letters.m_available; wanted != 0; wanted &= (wanted - 1))
+    {
+        // lowest wanted letter, and its child's position among all the children (see findChild)
+        const auto letterBit{ wanted & (~wanted + 1) };
+        const auto offset{ countBits(letterBit - 1) };
+        const auto child{ record.m_firstChild + countBits(childLetters & (letterBit - 1)) };
+
+        const auto keptChild{ keepChild(source, child, offset, letters, kept) };
+        if (keptChild == CompiledTrie::NO_NODE) continue;
+
+        kept[index].m_childMask |= letterBit;
+        if (lastChild == CompiledTrie::NO_NODE) kept[index].m_firstChild = keptChild;
+        else kept[lastChild].m_nextSibling = keptChild;
+        lastChild = keptChild;
+    }
+
+    /* Not a word and nothing below it was kept, so it is the last node in kept.
+    The root always stays, even if the board can't spell anything. */
+    if ((kept[index].m_childMask == 0) && (index != CompiledTrie::ROOT))
+    {
+        kept.pop_back();
+        return CompiledTrie::NO_NODE;
+    }
+    return index;
+}
+
+
+/// <summary>
+/// Takes the letter of a child record and the letters of its label (radix layout),
+/// then walks below it. A kept label is unfolded into one kept node per letter, so
+/// the board trie never has labels.
+/// </summary>
+/// <param name="source">compiled trie of the dictionary</param>
+/// <param name="child">record the letter leads to</param>
+/// <param name="offset">letter leading to the record - 'a', already checked against the board letters</param>
+/// <param name="letters">board letters, given back as they were</param>
+/// <param name="kept">nodes kept so far</param>
+/// <returns>index of the node kept for the letter, NO_NODE if nothing below it is kept</returns>
+uint32_t BoardTrie::keepChild(const CompiledTrie& source, uint32_t child, uint32_t offset, BoardLetters& letters, vector<KeptNode>& kept)
+{
+    const auto labelLength{ source.labelLength(child) };
+    uint32_t taken[CompiledTrie::MAX_LABEL_LENGTH + 1];
+    uint32_t takenCount{ 0 };
+
+    take(letters.m_counts[offset], letters.m_available, offset);
+    taken[takenCount++] = offset;
+
+    // every letter of the label has to be on the board, right after the one before it
+    bool labelFits{ true };
+    for (uint32_t position = 0; position < labelLength; position++)
+    {
+        const auto next{ static_cast<uint32_t>(source.labelLetter(child, position) - 'a') };
+        if ((((letters.m_followers[taken[takenCount - 1]] & letters.m_available) >> next) & 1) == 0)
+        {
+            labelFits = false;
+            break;
+        }
+        take(letters.m_counts[next], letters.m_available, next);
+        taken[takenCount++] = next;
+    }
+
+    auto below{ labelFits ? keepBelow(source, child, letters.m_followers[taken[takenCount - 1]], letters, kept) : CompiledTrie::NO_NODE };
+
+    // the node kept for the record is the last label letter's, the letters above it lead down to it
+    for (uint32_t i = takenCount; i > 0; i--)
+    {
+        if ((below != CompiledTrie::NO_NODE) && (i > 1))
+        {
+            kept.push_back({ 1u << taken[i - 1], below, CompiledTrie::NO_NODE });
+            below = static_cast<uint32_t>(kept.size() - 1);
+        }
+        giveBack(letters.m_counts[taken[i - 1]], letters.m_available, taken[i - 1]);
+    }
+    return below;
+}
+
+
+/// <summary>
+/// Lays the kept nodes out breadth first, with the children of every node next to
+/// each other in letter order, the same way CompiledTrie::build(...) does.
+/// </summary>
+/// <param name="kept">kept nodes, kept[ROOT] is the root</param>
+/// <param name="trie">trie to fill</param>
+void BoardTrie::layOut(const vector<KeptNode>& kept, CompiledTrie& trie)
+{
+    vector<CompiledNode> nodes{};
+    vector<uint32_t> order{ CompiledTrie::ROOT };   // kept node of every record
+    nodes.reserve(kept.size());
+    order.reserve(kept.size());
+
+    for (size_t record = 0; record < order.size(); record++)
+    {
+        const auto& node{ kept[order[record]] };
+        nodes.push_back({ node.m_childMask, static_cast<uint32_t>(order.size()) });
+
+        for (auto child = node.m_firstChild; child != CompiledTrie::NO_NODE; child = kept[child].m_nextSibling)
+        {
+            order.push_back(child);
+        }
+    }
+
+    trie.m_nodes = move(nodes);
+    trie.m_labelStarts.clear(); // no chains are collapsed in this layout
+    trie.m_labels.clear();
+    trie.indexRecords();
+    trie.useOwnedStorage();
+}
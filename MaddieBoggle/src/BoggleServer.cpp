@@ -0,0 +1,412 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <thread>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "BoggleBoard.h"
+#include "BoggleServer.h"
+#include "BoggleSolver.h"
+
+
+/// <summary>
+/// A single board request from the moment it is read until it is answered.
+/// </summary>
+struct PendingBoard
+{
+    string m_id;                        // request id, echoed back in the response
+    BoggleBoard m_board;                // the solver keeps a reference, so this must not move
+    WordLengthRange m_lengths;          // lengths of the words the request asks for
+    unique_ptr<BoggleSolver> m_solver;  // nullptr when the request was rejected
+    string m_error;                     // reason the request was rejected, empty otherwise
+    chrono::steady_clock::time_point m_received;
+};
+
+
+/// <summary>
+/// Reads the optional word lengths that follow the id of a board request. Both
+/// are counts of letters, and a missing maximum means no maximum.
+/// </summary>
+/// <param name="tokens">rest of the request line</param>
+/// <param name="lengths">set to the lengths read, unchanged for a missing length</param>
+/// <returns>false if there is anything but one or two lengths, in order</returns>
+static bool readWordLengths(istringstream& tokens, WordLengthRange& lengths)
+{
+    vector<size_t> values{};
+    string token{};
+    while (tokens >> token)
+    {
+        if ((token.size() > 6) || (token.find_first_not_of("0123456789") != string::npos)) return false;
+        values.push_back(stoul(token));
+    }
+
+    if (values.size() > 2) return false;
+    if (values.size() > 0) lengths.m_min = values[0];
+    if (values.size() > 1) lengths.m_max = values[1];
+    return lengths.m_min <= lengths.m_max;
+}
+
+
+#ifndef _WIN32
+/// <summary>
+/// Minimal buffered stream buffer over a connected socket, so a socket client
+/// can be served by the same stream based code as stdin/stdout.
+/// </summary>
+class SocketStreamBuf : public streambuf
+{
+public:
+    SocketStreamBuf(int socket) : m_socket(socket), m_input(), m_output()
+    {
+        setg(m_input, m_input, m_input);
+        setp(m_output, m_output + sizeof(m_output));
+    }
+
+protected:
+    int_type underflow() override
+    {
+        ssize_t count{ 0 };
+        do
+        {
+            count = recv(m_socket, m_input, sizeof(m_input), 0);
+        } while ((count < 0) && (errno == EINTR));
+
+        if (count <= 0) return traits_type::eof(); // early return, closed or failed
+
+        setg(m_input, m_input, m_input + count);
+        return traits_type::to_int_type(m_input[0]);
+    }
+
+    int_type overflow(int_type value) override
+    {
+        if (sync() != 0) return traits_type::eof(); // early return
+
+        if (!traits_type::eq_int_type(value, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(value);
+            pbump(1);
+        }
+        return traits_type::not_eof(value);
+    }
+
+    int sync() override
+    {
+#ifdef MSG_NOSIGNAL
+        constexpr int flags{ MSG_NOSIGNAL }; // a client that hung up must not kill the server
+#else
+        constexpr int flags{ 0 };
+#endif
+        const char* next{ pbase() };
+        while (next < pptr())
+        {
+            const auto sent{ send(m_socket, next, static_cast<size_t>(pptr() - next), flags) };
+            if ((sent < 0) && (errno == EINTR)) continue;
+            if (sent <= 0) return -1; // early return, client is gone
+
+            next += sent;
+        }
+        setp(m_output, m_output + sizeof(m_output));
+        return 0;
+    }
+
+private:
+    int m_socket;
+    char m_input[4096];
+    char m_output[4096];
+};
+#endif
+
+
+/// <summary>
+/// Class constructor for the server.
+/// </summary>
+/// <param name="dictionary">shared_ptr to a const, frozen dictionary of valid words</param>
+/// <param name="pool">shared ptr to a thread pool</param>
+/// <param name="maxInFlight">number of boards solved at the same time before reading waits</param>
+BoggleServer::BoggleServer(shared_ptr<const Dictionary> dictionary, shared_ptr<ThreadPool> pool, size_t maxInFlight) :
+    m_dictionary(dictionary),
+    m_pool(pool),
+    m_maxInFlight(maxInFlight),
+    m_latencyMutex(),
+    m_latencies()
+{
+    assert(m_dictionary);
+    assert(m_pool);
+    assert(m_maxInFlight > 0);
+}
+
+
+/// <summary>
+/// Serves board requests read from the input stream until the stream ends or a
+/// "shutdown" request is read (see the class description for the protocol).
+/// 
+/// The calling thread reads requests and queues their boards on the thread pool,
+/// while a writer thread waits for the oldest board to be solved and writes its
+/// answers. Every board still in flight is answered before this returns.
+/// </summary>
+/// <param name="input">stream to read requests from</param>
+/// <param name="output">stream to write responses to</param>
+/// <returns>bool true if a shutdown was requested, false if the input ended</returns>
+bool BoggleServer::serve(istream& input, ostream& output)
+{
+    /* A tied input flushes the output before every read. The writer thread owns
+    the output, so the reading thread must never flush it. */
+    const auto tiedStream{ input.tie(nullptr) };
+
+    deque<unique_ptr<PendingBoard>> inFlight{};
+    mutex inFlightMutex{};
+    condition_variable boardQueued{};
+    condition_variable boardAnswered{};
+    bool readingDone{ false };
+
+    thread writer([&]() {
+        while (true)
+        {
+            unique_ptr<PendingBoard> pending{};
+            {
+                unique_lock<mutex> lock(inFlightMutex);
+                boardQueued.wait(lock, [&] { return !inFlight.empty() || readingDone; });
+                if (inFlight.empty()) return; // reading is done and every board is answered
+
+                pending = move(inFlight.front());
+            }
+
+            if (pending->m_solver)
+            {
+                pending->m_solver->waitForSolve();
+                output << "answers " << pending->m_id << " " << pending->m_solver->answerCount() << "\n";
+                pending->m_solver->writeAnswers(output);
+            }
+            else
+            {
+                output << "error " << pending->m_id << " " << pending->m_error << "\n";
+            }
+            output.flush();
+
+            const chrono::duration<double, milli> latency{ chrono::steady_clock::now() - pending->m_received };
+            {
+                lock_guard<mutex> lock(m_latencyMutex);
+                m_latencies.push_back(latency.count());
+            }
+
+            // only removed once answered, so the queue size is the number of boards in flight
+            {
+                lock_guard<mutex> lock(inFlightMutex);
+                inFlight.pop_front();
+            }
+            boardAnswered.notify_one();
+        }
+    });
+
+    // trailing whitespace (including the '\r' of windows line endings) is ignored
+    auto readLine = [&input](string& line) {
+        if (!getline(input, line)) return false;
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        return true;
+    };
+
+    bool shutdownRequested{ false };
+    string line{};
+    while (readLine(line))
+    {
+        if (line.empty()) continue;
+
+        istringstream tokens(line);
+        string command{};
+        string id{};
+        tokens >> command >> id;
+
+        if (command == "shutdown")
+        {
+            shutdownRequested = true;
+            break;
+        }
+
+        auto pending{ make_unique<PendingBoard>() };
+        pending->m_id = id.empty() ? "-" : id;
+        if ((command != "board") || id.empty())
+        {
+            pending->m_error = "unknown request: " + line;
+        }
+        else
+        {
+            // the rows are read either way, so they aren't taken for requests
+            if (!readWordLengths(tokens, pending->m_lengths)) pending->m_error = "invalid word lengths: " + line;
+
+            bool terminated{ false };
+            while (readLine(line))
+            {
+                if (line == "end")
+                {
+                    terminated = true;
+                    break;
+                }
+                appendBoardRow(line, pending->m_board);
+            }
+            if (!terminated && pending->m_error.empty()) pending->m_error = "board is missing its end line";
+        }
+        pending->m_received = chrono::steady_clock::now(); // waiting for room below counts towards the latency
+
+        // wait for room before starting the search, so at most m_maxInFlight boards are being solved
+        {
+            unique_lock<mutex> lock(inFlightMutex);
+            boardAnswered.wait(lock, [&] { return inFlight.size() < m_maxInFlight; });
+        }
+
+        /* Only this thread adds boards, so the room can't be taken while the
+        search is started without the lock, which leaves the writer free. */
+        if (pending->m_error.empty())
+        {
+            pending->m_solver = make_unique<BoggleSolver>(m_dictionary, m_pool, pending->m_board, BoggleSolver::MAX_SPLIT_DEPTH, pending->m_lengths);
+            if (pending->m_solver->solveBoard() != ErrorCode::SUCCESS)
+            {
+                pending->m_solver.reset();
+                pending->m_error = "board could not be solved";
+            }
+        }
+
+        {
+            lock_guard<mutex> lock(inFlightMutex);
+            inFlight.push_back(move(pending));
+        }
+        boardQueued.notify_one();
+    }
+
+    {
+        lock_guard<mutex> lock(inFlightMutex);
+        readingDone = true;
+    }
+    boardQueued.notify_one();
+    writer.join();
+
+    input.tie(tiedStream);
+    return shutdownRequested;
+}
+
+
+/// <summary>
+/// Listens on a local (Unix domain) socket and serves one client connection at a
+/// time, until a client sends a "shutdown" request. Any existing file at the socket
+/// path is replaced, and the socket file is removed again when the server stops.
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, the server was shut down by a client
+/// 2 --> the socket could not be created, or sockets are not supported on this platform
+/// </summary>
+/// <param name="socketPath">file system path of the socket to listen on</param>
+/// <returns>error code</returns>
+ErrorCode BoggleServer::serveSocket(const string& socketPath)
+{
+#ifdef _WIN32
+    cerr << "Socket server mode is not supported on this platform: " << socketPath << "\n";
+    return ErrorCode::UNKNOWN_FILE_ERR;
+#else
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        cerr << "Socket path is too long: " << socketPath << "\n";
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+    socketPath.copy(address.sun_path, socketPath.size());
+
+    const int listener{ socket(AF_UNIX, SOCK_STREAM, 0) };
+    if (listener < 0)
+    {
+        cerr << "Unable to create socket: " << socketPath << "\n";
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+
+    unlink(socketPath.c_str());
+    if ((bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) 
+        || (listen(listener, SOMAXCONN) != 0))
+    {
+        cerr << "Unable to listen on socket: " << socketPath << "\n";
+        close(listener);
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+
+    ErrorCode errorCode{ ErrorCode::SUCCESS };
+    bool shutdownRequested{ false };
+    while (!shutdownRequested)
+    {
+        const int client{ accept(listener, nullptr, nullptr) };
+        if (client < 0)
+        {
+            if (errno == EINTR) continue;
+
+            cerr << "Unable to accept a connection on socket: " << socketPath << "\n";
+            errorCode = ErrorCode::UNKNOWN_FILE_ERR;
+            break;
+        }
+
+        SocketStreamBuf buffer(client);
+        istream input(&buffer);
+        ostream output(&buffer);
+        shutdownRequested = serve(input, output);
+        output.flush();
+        close(client);
+    }
+
+    close(listener);
+    unlink(socketPath.c_str());
+    return errorCode;
+#endif
+}
+
+
+/// <summary>
+/// Computes the latency percentiles of every board answered so far. Uses the
+/// nearest rank method, so every reported value is an actual measured latency.
+/// </summary>
+/// <returns>latency report, all zero if no board was answered</returns>
+LatencyReport BoggleServer::getLatencyReport() const
+{
+    vector<double> latencies{};
+    {
+        lock_guard<mutex> lock(m_latencyMutex);
+        latencies = m_latencies;
+    }
+    if (latencies.empty()) return { 0, 0.0, 0.0, 0.0 }; // early return
+
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double fraction) {
+        const auto rank{ static_cast<size_t>(ceil(fraction * latencies.size())) };
+        return latencies[max<size_t>(rank, 1) - 1];
+    };
+
+    return { latencies.size(), percentile(0.50), percentile(0.99), latencies.back() };
+}
+
+
+/// <summary>
+/// Writes the latency report to the provided stream, used when the server shuts down.
+/// </summary>
+/// <param name="log">stream to write the report to</param>
+void BoggleServer::reportLatency(ostream& log) const
+{
+    const auto report{ getLatencyReport() };
+    const auto flags{ log.flags() };
+    const auto precision{ log.precision() };
+    log << fixed << setprecision(3) << "Served " << report.m_boardCount << " boards, p50: " 
+        << report.m_p50 << " ms, p99: " << report.m_p99 << " ms, max: " << report.m_max << " ms\n";
+
+    log.flags(flags);
+    log.precision(precision);
+}
@@ -2,15 +2,11 @@
 // Place Holder Copyright Header
 //
 
+#include <algorithm>
 #include <cassert>
-#include <fstream>
-
-#ifdef _DEBUG
 #include <iostream>
-#endif
 
 #include "BoggleSolver.h"
-#include "BoggleSolverHelper.h"
 
 
 /// <summary>
@@ -19,153 +15,651 @@
 /// <param name="dictionary">shared_ptr to a const dictionary of valid words</param>
 /// <param name="pool">shared ptr to a thread pool</param>
 /// <param name="board">const reference to a board to traverse when looking for words</param>
-BoggleSolver::BoggleSolver(shared_ptr<const Dictionary> dictionary, shared_ptr<ThreadPool> pool, const BoggleBoard& board) :
+/// <param name="splitDepth">optional longest path a search task is split off at, 1 to only run one task per node</param>
+/// <param name="lengths">optional lengths of the words to find, every length by default</param>
+/// <param name="useBoardTrie">optional, true to search a BoardTrie of the dictionary built for this board</param>
+/// <param name="engine">optional engine to solve the board with, picked by chooseEngine(...) by default</param>
+BoggleSolver::BoggleSolver(shared_ptr<const Dictionary> dictionary, shared_ptr<ThreadPool> pool, const BoggleBoard& board, size_t splitDepth,
+    WordLengthRange lengths, bool useBoardTrie, SearchEngine engine) :
     m_board(board),
+    m_graph(board),
     m_dictionary(dictionary),
     m_pool(pool),
+    m_splitDepth(min(max(splitDepth, size_t{ 1 }), MAX_SPLIT_DEPTH)),
+    m_lengths(lengths),
+    m_limitLengths((lengths.m_min > 0) || (lengths.m_max != SIZE_MAX)),
+    m_boardTrie(),
+    m_searchTrie(&dictionary->getCompiledTrie()),
+    m_engine(engine),
     m_answersMutex(),
-    m_answers()
+    m_answers(),
+    m_workerAnswers(),
+    m_outsideAnswersMutex(),
+    m_foundWords(),
+    m_wordsFound(0),
+    m_uniqueWords(0),
+    m_searchStats(),
+    m_lockAcquisitions(0),
+    m_contendedLocks(0),
+    m_splitTasks(0),
+    m_pendingMutex(),
+    m_solved(),
+    m_pendingTasks(0)
 {
     assert(m_dictionary);
     assert(m_pool);
+
+    m_workerAnswers.resize(m_pool->threadCount() + 1);
+
+    /* The compiled trie of a dictionary that isn't frozen has no words, which keeps
+    everything below safe, but the board can't be solved with it. */
+    if (!m_dictionary->isFrozen())
+    {
+        cerr << "Error: The dictionary has to be frozen before a board can be solved!\n";
+        useBoardTrie = false;
+    }
+
+    if (useBoardTrie)
+    {
+        BoardTrie::build(*m_dictionary, m_graph, m_boardTrie);
+        m_searchTrie = &m_boardTrie;
+    }
+    if (m_engine == SearchEngine::AUTO) m_engine = chooseEngine(m_graph.cellCount(), m_searchTrie->wordCount());
+
+    const size_t bitmapWords{ (size_t{ m_searchTrie->wordCount() } + 63) / 64 };
+    m_foundWords = make_unique<atomic<uint64_t>[]>(bitmapWords);
+    for (size_t i = 0; i < bitmapWords; i++) m_foundWords[i].store(0, memory_order_relaxed);
+}
+
+
+/// <summary>
+/// Picks the engine that should solve a board fastest (see the class description).
+/// The dictionary engine's work grows with the number of words times the cells each
+/// word starts from, the board engine's a bit faster than the board (every start cell
+/// task clears a visited bitmask the size of the board). Measured on generated
+/// puzzles, the dictionary engine is faster below about DICTIONARY_ENGINE_SCALE
+/// times the square root of the cell count words:
+///
+///   30 x 30 board   --> up to 960 words
+///   200 x 200 board --> up to 6400 words
+/// </summary>
+/// <param name="cellCount">number of cells on the board</param>
+/// <param name="wordCount">number of dictionary words</param>
+/// <returns>BOARD or DICTIONARY</returns>
+SearchEngine BoggleSolver::chooseEngine(size_t cellCount, size_t wordCount)
+{
+    const auto words{ static_cast<uint64_t>(wordCount) };
+    const bool fewWords{ words * words < DICTIONARY_ENGINE_SCALE * DICTIONARY_ENGINE_SCALE * cellCount };
+    return fewWords ? SearchEngine::DICTIONARY : SearchEngine::BOARD;
 }
 
 
 /// <summary>
-/// Adds a task to the thread pool for every node on the boggle board.
+/// Adds a task to the thread pool for every node on the boggle board, or with the
+/// dictionary engine, for every slice of the dictionary words.
+///
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 7 --> the dictionary isn't frozen, nothing is searched
 /// </summary>
-void BoggleSolver::solveBoard()
+/// <returns>error code</returns>
+ErrorCode BoggleSolver::solveBoard()
 {
-    size_t rowIndex{ 0 };
-    size_t colIndex{ 0 };
-    for (const auto& row : m_board)
+    if (!m_dictionary->isFrozen()) return ErrorCode::DICTIONARY_NOT_FROZEN; // early return, see the constructor
+
+    if (m_engine == SearchEngine::DICTIONARY)
     {
-        colIndex = 0;
-        for (const auto& col : row)
-        {
-            m_pool->queueTask([this, rowIndex, colIndex]() {
-                this->findWordsAtIndex(rowIndex, colIndex);
-            });
-            colIndex++;
-        }
-        rowIndex++;
+        queueWordSearches();
+        return ErrorCode::SUCCESS; // early return
+    }
+
+    {
+        lock_guard<mutex> lock(m_pendingMutex);
+        m_pendingTasks += m_graph.cellCount();
     }
+
+    for (size_t cell = 0; cell < m_graph.cellCount(); cell++)
+    {
+        queueSearch({ { static_cast<uint32_t>(cell) }, 1, true });
+    }
+    return ErrorCode::SUCCESS;
 }
 
 
 /// <summary>
-/// Outputs all the boggle board answers to a file at the provided location.
+/// Queues a task searching from the end of the provided path. The task must
+/// already be counted in m_pendingTasks.
+/// </summary>
+/// <param name="path">path of the search task</param>
+void BoggleSolver::queueSearch(const SearchPath& path)
+{
+    m_pool->queueTask([this, path]() {
+        this->findWordsFromPath(path);
+        this->finishTask();
+    });
+}
+
+
+/// <summary>
+/// Counts a task queued by this solver as done, waking waitForSolve() after the last one.
+/// </summary>
+void BoggleSolver::finishTask()
+{
+    lock_guard<mutex> lock(m_pendingMutex);
+    if (--m_pendingTasks == 0) m_solved.notify_all();
+}
+
+
+/// <summary>
+/// Dictionary engine, spreads the dictionary words over WORD_TASKS_PER_THREAD tasks
+/// per pool thread. Word ids are sorted, so every task gets a run of neighbouring words.
+/// </summary>
+void BoggleSolver::queueWordSearches()
+{
+    const auto wordCount{ m_searchTrie->wordCount() };
+    if (wordCount == 0) return; // early return, nothing to look for
+
+    const uint32_t taskCount{ static_cast<uint32_t>(min<size_t>(wordCount, m_pool->threadCount() * WORD_TASKS_PER_THREAD)) };
+    const uint32_t wordsPerTask{ (wordCount + taskCount - 1) / taskCount };
+    {
+        lock_guard<mutex> lock(m_pendingMutex);
+        m_pendingTasks += (wordCount + wordsPerTask - 1) / wordsPerTask;
+    }
+
+    for (uint32_t first = 0; first < wordCount; first += wordsPerTask)
+    {
+        const auto end{ min(first + wordsPerTask, wordCount) };
+        m_pool->queueTask([this, first, end]() {
+            this->findWordsInRange(first, end);
+            this->finishTask();
+        });
+    }
+}
+
+
+/// <summary>
+/// Hands the search through a neighbour of the current path to a new task. The
+/// running task still counts as pending, so the solve can't be seen as done
+/// before the new task is queued.
+/// </summary>
+/// <param name="path">path of the running search, ending at the current node</param>
+/// <param name="neighbour">cell index of the neighbour the new task starts from</param>
+void BoggleSolver::splitSearch(const SearchPath& path, uint32_t neighbour)
+{
+    auto splitPath{ path };
+    splitPath.m_cells[splitPath.m_length++] = neighbour;
+
+    {
+        lock_guard<mutex> lock(m_pendingMutex);
+        m_pendingTasks++;
+    }
+    m_splitTasks++;
+    queueSearch(splitPath);
+}
+
+
+/// <summary>
+/// Waits until every task queued by solveBoard() has finished. Unlike
+/// ThreadPool::waitForCompletion(), tasks queued by other solvers sharing
+/// the pool are not waited on.
+/// </summary>
+void BoggleSolver::waitForSolve()
+{
+    unique_lock<mutex> lock(m_pendingMutex);
+    m_solved.wait(lock, [this] { return m_pendingTasks == 0; });
+}
+
+
+/// <summary>
+/// Outputs all the boggle board answers to a file at the provided location, or to
+/// stdout for "-", in the provided format (see AnswerWriter).
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 2 --> unable to open or write the output file
 /// </summary>
 /// <param name="filepath">output file destination for all the answers</param>
-void BoggleSolver::exportAnswers(const string& filepath)
+/// <param name="format">format to write the answers in</param>
+/// <returns>error code</returns>
+ErrorCode BoggleSolver::exportAnswers(const string& filepath, AnswerFormat format)
 {
-    ofstream output;
-    output.open(filepath);
+    AnswerWriter writer(format);
+    auto errorCode{ writer.open(filepath) };
+    if (errorCode != ErrorCode::SUCCESS) return errorCode;
 
-    if (output.is_open())
+    errorCode = writeAnswers(writer);
+    const auto closeCode{ writer.close() };
+    if (errorCode == ErrorCode::SUCCESS) errorCode = closeCode;
+
+    if (errorCode != ErrorCode::SUCCESS)
     {
-        lock_guard<mutex> lock(m_answersMutex); // just in case
-        for (const auto& ans : m_answers)
-        {
-            output << ans << endl;
-        }
-        output.close();
+        cerr << "Error: Could not write the answers at path: " << filepath << "\n";
     }
-    else
+    return errorCode;
+}
+
+
+/// <summary>
+/// Writes all the boggle board answers with the provided writer, which has to be
+/// open already. Word ids are always the dictionary's, even with a board trie.
+/// </summary>
+/// <param name="writer">open writer to write the answers with</param>
+/// <returns>error code of AnswerWriter::write(...)</returns>
+ErrorCode BoggleSolver::writeAnswers(AnswerWriter& writer)
+{
+    mergeAnswers();
+
+    const auto lock{ lockAnswers() };
+    return writer.write(m_answers, m_dictionary->getCompiledTrie());
+}
+
+
+/// <summary>
+/// Writes all the boggle board answers to the provided stream, one per line.
+/// </summary>
+/// <param name="output">stream to write the answers to</param>
+void BoggleSolver::writeAnswers(ostream& output)
+{
+    mergeAnswers();
+
+    const auto lock{ lockAnswers() };
+    for (const auto& ans : m_answers)
     {
-        cerr << "Error: Could not open file for writing at path: " << filepath << "\n";
+        output << ans << '\n';
     }
 }
 
 
+/// <summary>
+/// Number of unique words found on the board so far.
+/// </summary>
+/// <returns>number of answers</returns>
+size_t BoggleSolver::answerCount()
+{
+    mergeAnswers();
+
+    const auto lock{ lockAnswers() };
+    return m_answers.size();
+}
+
+
+/// <summary>
+/// Statistics of the answer collection. The search itself never locks, so the
+/// lock count only grows with the number of times the answers are read. The word
+/// counts are only up to date once the answers have been read.
+/// </summary>
+/// <returns>answer statistics</returns>
+AnswerStats BoggleSolver::getAnswerStats() const
+{
+    return { m_wordsFound, m_uniqueWords, m_lockAcquisitions.load(), m_contendedLocks.load() };
+}
+
+
+/// <summary>
+/// Statistics of the board search, summed over every worker. Like the word counts
+/// of getAnswerStats(), they are only up to date once the answers have been read.
+/// </summary>
+/// <returns>search statistics</returns>
+SearchStats BoggleSolver::getSearchStats() const
+{
+    return m_searchStats;
+}
+
+
+/// <summary>
+/// Turns the word ids found by every worker into strings and adds them to the
+/// answer set. Ids are numbered in sorted word order and the bitmap guarantees
+/// each id was only recorded once, so sorting the ids sorts the words, and every
+/// string is built and inserted exactly once, in order.
+/// 
+/// Must only be called once the search has finished (see waitForSolve()), since
+/// the worker answers are not locked.
+/// </summary>
+void BoggleSolver::mergeAnswers()
+{
+    const auto lock{ lockAnswers() };
+
+    vector<uint32_t> wordIds{};
+    for (auto& answers : m_workerAnswers)
+    {
+        wordIds.insert(wordIds.end(), answers.m_wordIds.begin(), answers.m_wordIds.end());
+        m_wordsFound += answers.m_wordsFound;
+        m_searchStats.m_nodesExpanded += answers.m_search.m_nodesExpanded;
+        m_searchStats.m_dictionaryLookups += answers.m_search.m_dictionaryLookups;
+        m_searchStats.m_prunedPaths += answers.m_search.m_prunedPaths;
+        answers.m_wordIds.clear();
+        answers.m_wordsFound = 0;
+        answers.m_search = {};
+    }
+    m_uniqueWords += wordIds.size();
+
+    sort(wordIds.begin(), wordIds.end());
+    for (const auto wordId : wordIds)
+    {
+        m_answers.insert(m_answers.end(), m_searchTrie->wordAt(wordId)); // sorted input, the hint makes every insert constant time
+    }
+}
+
+
+/// <summary>
+/// Takes the answer set mutex, counting every acquisition and every time the
+/// caller had to wait for another thread.
+/// </summary>
+/// <returns>lock on the answer set mutex</returns>
+unique_lock<mutex> BoggleSolver::lockAnswers()
+{
+    unique_lock<mutex> lock(m_answersMutex, try_to_lock);
+    if (!lock.owns_lock())
+    {
+        m_contendedLocks++;
+        lock.lock();
+    }
+    m_lockAcquisitions++;
+    return lock;
+}
+
+
+/// <summary>
+/// Picks the m_workerAnswers entry the calling thread writes its answers to. Workers
+/// of this solver's pool each own one and need no lock. Any other caller (tests
+/// calling the search directly, a worker of another pool) shares the extra last
+/// entry, and only while holding the returned lock.
+/// </summary>
+/// <param name="worker">set to the index of the entry to use</param>
+/// <returns>lock on m_outsideAnswersMutex for callers outside the pool, otherwise an empty lock</returns>
+unique_lock<mutex> BoggleSolver::claimWorkerAnswers(size_t& worker)
+{
+    worker = m_pool->workerIndex();
+    if (worker != ThreadPool::NOT_A_WORKER) return {}; // early return, a worker of the pool
+
+    worker = m_workerAnswers.size() - 1;
+    return unique_lock<mutex>(m_outsideAnswersMutex);
+}
+
+
 /// <summary>
 /// This method is the main execution point that threads will call in order to solve
-/// a portion of the boggle board. The first call to this method takes a specific
-/// character index in the boggle board. This kicks off a recursive depth-first-search alg
-/// that keeps traversing all possible nodes. The following search rules are implemented:
-/// - node traversal is acyclic (no loop-backs, ie no touching visited nodes)
-/// - if an adjacent node doesn't form a word prefix, there is no need to travel to
-///     to it since it could not possibly form a word
+/// a portion of the boggle board. The call takes a specific character index in the 
+/// boggle board and kicks off a recursive depth-first-search alg (see findWordsFromNode) 
+/// that keeps traversing all possible nodes.
 /// 
 /// This method only finds all the possible words given a single starting node on 
 /// the board. It will need to be run once for the total number of character nodes
-/// in the boggle board.
-/// 
-/// Threads running this method will maintain their own volatile data (current word and
-/// visited nodes). As such, those fields are marked as "thread_local". The only
-/// shared data is the answer set, which is mutex protected.
+/// in the boggle board. It never splits the search into other tasks.
 /// </summary>
 /// <param name="row">row index of a character node on the boggle board</param>
 /// <param name="col"column index of a character node on the boggle board></param>
 void BoggleSolver::findWordsAtIndex(size_t row, size_t col)
 {
-    /* Each thread running this method will have its own instance
-    of these thread_locals. This allows these variables to be considered
-    static for recursive calls, without hitting any memory collisions. */
-    thread_local string m_currentWord;      
-    thread_local BoardNodes m_visitedNodes; 
+    findWordsFromPath({ { static_cast<uint32_t>(m_graph.cellIndex(row, col)) }, 1, false });
+}
+
+
+/// <summary>
+/// Finds all the words that start with the provided path. Every cell of the path
+/// but the last is replayed (cursor advanced, cell marked as visited) and the
+/// recursive search (see findWordsFromNode) starts from the last one. Words ending
+/// before the last cell are not checked, they belong to the task that split
+/// this one off.
+/// 
+/// Each call owns its own dictionary cursor, so the recursion never has to re-walk
+/// the dictionary trie from the root.
+/// </summary>
+/// <param name="path">path to search from, the start node alone for a whole start node</param>
+void BoggleSolver::findWordsFromPath(SearchPath path)
+{
+    assert((path.m_length > 0) && (path.m_length <= MAX_SPLIT_DEPTH));
+
+    /* The visited bitmask is kept per thread and only re-sized when a board
+    with more cells than before is searched, so starting a new search costs
+    no allocations once a thread has warmed up. */
+    thread_local VisitedCells m_visitedCells;
+    m_visitedCells.reset(m_graph.cellCount());
+
+    size_t worker{};
+    const auto outsideLock{ claimWorkerAnswers(worker) };
+
+    DictionaryCursor cursor(*m_searchTrie);
+    const auto searchCell{ path.m_cells[--path.m_length] };
+    for (size_t i = 0; i < path.m_length; i++)
+    {
+        // the task that split this one off already walked the path, so it exists
+        const auto letter{ m_graph.letter(path.m_cells[i]) };
+        bool advanced{ cursor.advance(letter) };
+        if (letter == 'q') advanced = advanced && cursor.advance('u'); // see Q_CONDITION in findWordsFromNode
+        assert(advanced);
+        m_visitedCells.set(path.m_cells[i]);
+    }
 
-    bool qCondition { false };              // Flag used to identify if a the Q_CONDITION is active.
-    auto currentChar{ m_board[row][col] };  // char at the current node on the Boggle board
+    findWordsFromNode(searchCell, cursor, m_visitedCells, m_workerAnswers[worker], path);
+}
 
-    m_currentWord.push_back(currentChar);   // Add this character to the current word path.
+
+/// <summary>
+/// Recursive depth-first-search from a single node on the board. The following search 
+/// rules are implemented:
+/// - node traversal is acyclic (no loop-backs, ie no touching visited nodes)
+/// - if an adjacent node doesn't form a word prefix, there is no need to travel to
+///     to it since it could not possibly form a word
+/// 
+/// The dictionary cursor always points to the prefix formed by the path walked so far.
+/// Each recursive call advances it by this node's letter(s) and steps it back before
+/// returning, so checking a prefix or a word is a single trie step instead of a full
+/// search from the root.
+/// 
+/// Adjacent nodes come from the board graph's precomputed neighbour table and visited
+/// nodes are tracked in a bitmask, so a step of the search never allocates.
+/// 
+/// Threads running this method will maintain their own volatile data (visited nodes
+/// and found words). The only shared data is the found word bitmap, which is atomic.
+/// The current word never has to be built, the cursor's word id identifies it.
+/// 
+/// While the path is shorter than m_splitDepth and the pool has idle workers, the
+/// neighbours are handed to new tasks instead of being searched here.
+/// </summary>
+/// <param name="cell">board graph cell index of a character node on the boggle board</param>
+/// <param name="cursor">dictionary cursor pointing at the prefix walked before this node</param>
+/// <param name="visitedCells">bitmask of the cells already in the current path</param>
+/// <param name="answers">answers of the worker running the search</param>
+/// <param name="path">path walked before this node</param>
+void BoggleSolver::findWordsFromNode(size_t cell, DictionaryCursor& cursor, VisitedCells& visitedCells, WorkerAnswers& answers, SearchPath& path)
+{
+    auto currentChar{ m_graph.letter(cell) };  // char at the current node on the Boggle board
+
+    // If the current word plus this node's char is not a valid dictionary path, there is nothing to find.
+    answers.m_search.m_dictionaryLookups++;
+    if (!cursor.advance(currentChar))
+    {
+        answers.m_search.m_prunedPaths++;
+        return; // early return
+    }
 
     /* Q_CONDITION: 'q' on the board is interpreted as 'qu' as a convenience since 
-    they often go together. When this occurs, the qActive flag is set, and both
-    'q' and 'u' are added to the current word. Anytime a char is removed when the
-    qCondition is active, an extra char needs to be removed to account for the extra
-    'u' that was pushed onto the word. */
-    if (currentChar == 'q')
-    {
-        m_currentWord.push_back('u');
-        qCondition = true;
-    }
-
-    // If the current word (which includes the chars in this iteration) is a valid dictionary path
-    if (m_dictionary->searchDictionary(m_currentWord, SearchType::PATH))
-    {
-        // We are visting this node, add it to the set.
-        m_visitedNodes.insert({ row, col });
-
-        // Check all possible 8 directions around the current node for another valid node.
-        BoardNodes validNodes{};
-        checkNodeUp         (row, col, m_board, validNodes, m_visitedNodes);
-        checkNodeUpRight    (row, col, m_board, validNodes, m_visitedNodes);
-        checkNodeRight      (row, col, m_board, validNodes, m_visitedNodes);
-        checkNodeDownRight  (row, col, m_board, validNodes, m_visitedNodes);
-        checkNodeDown       (row, col, m_board, validNodes, m_visitedNodes);
-        checkNodeDownLeft   (row, col, m_board, validNodes, m_visitedNodes);
-        checkNodeUpLeft     (row, col, m_board, validNodes, m_visitedNodes);
-        checkNodeLeft       (row, col, validNodes, m_visitedNodes);
-
-        // Go through all the valid nodes (if any) and recurse.
-        for (const auto& node : validNodes)
+    they often go together. When this occurs, both 'q' and 'u' are added to the 
+    current prefix, so the cursor needs to step over the extra 'u' as well. Anytime
+    the cursor steps back from a 'q' node, it needs to step back twice. */
+    const bool qCondition{ currentChar == 'q' };
+    if (qCondition)
+    {
+        answers.m_search.m_dictionaryLookups++;
+        if (!cursor.advance('u'))
+        {
+            answers.m_search.m_prunedPaths++;
+            cursor.stepBack(); // undo the 'q', there is no "qu" path
+            return; // early return
+        }
+    }
+
+    /* LENGTH_LIMITS: with a word length range, the path only goes on if the
+    words below the prefix aren't all too long or all too short. */
+    if (m_limitLengths)
+    {
+        const auto letters{ cursor.depth() };
+        const bool tooLong{ letters + cursor.shortestRemaining() > m_lengths.m_max };
+        const bool tooShort{ (letters < m_lengths.m_min) && (cursor.longestRemaining() < m_lengths.m_min - letters) };
+        if (tooLong || tooShort)
         {
-            findWordsAtIndex(node.first, node.second); // !! RECURSIVE CALL !!
+            answers.m_search.m_prunedPaths++;
+            cursor.stepBack();
+            if (qCondition) cursor.stepBack();
+            return; // early return
         }
+    }
+    answers.m_search.m_nodesExpanded++;
+
+    // We are visting this node, mark it in the path.
+    visitedCells.set(cell);
+    if (path.m_length < MAX_SPLIT_DEPTH) path.m_cells[path.m_length] = static_cast<uint32_t>(cell);
+    path.m_length++;
+
+    // Go through all the adjacent nodes that are not already in the path and recurse.
+    for (const auto neighbour : m_graph.neighbours(cell))
+    {
+        if (visitedCells.test(neighbour)) continue;
 
-        /* When we are done looking beyond the current node to any active nodes,
-        check to see if this current word is a valid word in the dictionary. If
-        it is, add it to the set of answers. */
-        if (m_dictionary->searchDictionary(m_currentWord, SearchType::WORD))
+        // still shallow enough to split, and there is someone to split with
+        if (path.m_canSplit && (path.m_length < m_splitDepth) && (m_pool->idleWorkers() > 0))
         {
-            lock_guard lock(m_answersMutex);
-            m_answers.insert(m_currentWord);
+            splitSearch(path, neighbour);
         }
+        else
+        {
+            findWordsFromNode(neighbour, cursor, visitedCells, answers, path); // !! RECURSIVE CALL !!
+        }
+    }
 
-        /* Erase this recuse call's character node from the visited nodes set since we are 
-        done with this specific word path. */
-        m_visitedNodes.erase({ row, col }); 
+    /* When we are done looking beyond the current node to any active nodes,
+    check to see if this current word is a valid word in the dictionary. If
+    it is, mark it as found. The prefix is never longer than m_lengths.m_max
+    here (see LENGTH_LIMITS). */
+    if (cursor.isWord() && (cursor.depth() >= m_lengths.m_min))
+    {
+        recordWord(cursor.wordId(), answers);
     }
 
-    /* About to exit recurse call, remove this nodes char from the current word since we are
+    /* Unmark this recuse call's character node from the path since we are 
     done with this specific word path. */
-    m_currentWord.pop_back();
+    visitedCells.clear(cell);
+    path.m_length--;
 
-    /* When the Q_CONDITION (see above) is active, an extra char needs 
-    to be removed from the current word.*/
+    /* About to exit recurse call, step the cursor back since we are done 
+    with this specific word path. */
+    cursor.stepBack();
+
+    /* When the Q_CONDITION (see above) is active, the cursor also 
+    needs to step back over the extra 'u'. */
     if (qCondition)
     {
-        m_currentWord.pop_back(); // Removes the 'q' because the extra 'u' was already removed.
+        cursor.stepBack();
+    }
+}
+
+
+/// <summary>
+/// Records a found word. Only the thread that flips the word's bit in the found
+/// word bitmap records its id, every later find of the same word stops at the bit test.
+/// </summary>
+/// <param name="wordId">id of the word in m_searchTrie</param>
+/// <param name="answers">answers of the worker that found the word</param>
+void BoggleSolver::recordWord(uint32_t wordId, WorkerAnswers& answers)
+{
+    answers.m_wordsFound++;
+
+    auto& foundBits{ m_foundWords[wordId >> 6] };
+    const uint64_t wordBit{ uint64_t{ 1 } << (wordId & 63) };
+    if (((foundBits.load(memory_order_relaxed) & wordBit) == 0)
+        && ((foundBits.fetch_or(wordBit, memory_order_relaxed) & wordBit) == 0))
+    {
+        answers.m_wordIds.push_back(wordId);
+    }
+}
+
+
+/// <summary>
+/// Tells if a board letter spells the word at a position. A 'q' cell spells "qu"
+/// (see Q_CONDITION in findWordsFromNode), so it needs both letters.
+/// </summary>
+/// <param name="letter">letter of the board cell</param>
+/// <param name="word">word being looked for</param>
+/// <param name="position">position in the word the cell would spell, less than its size</param>
+/// <returns>true if the cell spells the word at the position</returns>
+static bool cellSpells(char letter, const string& word, size_t position)
+{
+    if (word[position] != letter) return false;
+    return (letter != 'q') || ((position + 1 < word.size()) && (word[position + 1] == 'u'));
+}
+
+
+/// <summary>
+/// Dictionary engine task, looks for the words with ids from firstWordId up to
+/// endWordId on the board. A word is only looked for from the cells holding its
+/// first letter, and the search for it stops at the first path that spells it.
+/// Words of lengths not wanted are skipped without a look at the board.
+/// </summary>
+/// <param name="firstWordId">id of the first word to look for</param>
+/// <param name="endWordId">id after the last word to look for</param>
+void BoggleSolver::findWordsInRange(uint32_t firstWordId, uint32_t endWordId)
+{
+    thread_local VisitedCells m_visitedCells;   // see findWordsFromPath
+    m_visitedCells.reset(m_graph.cellCount());
+
+    size_t worker{};
+    const auto outsideLock{ claimWorkerAnswers(worker) };
+    auto& answers{ m_workerAnswers[worker] };
+
+    for (auto wordId = firstWordId; wordId < endWordId; wordId++)
+    {
+        const auto word{ m_searchTrie->wordAt(wordId) };
+        if ((word.size() < m_lengths.m_min) || (word.size() > m_lengths.m_max)) continue;
+
+        answers.m_search.m_dictionaryLookups++;
+        if (!cellSpells(word[0], word, 0)) continue; // a 'q' without a 'u' after it, no cell spells it
+
+        for (const auto cell : m_graph.cellsWithLetter(word[0]))
+        {
+            if (spellsFrom(cell, word, 0, m_visitedCells, answers.m_search))
+            {
+                recordWord(wordId, answers);
+                break;
+            }
+        }
+    }
+}
+
+
+/// <summary>
+/// Recursive depth-first-search for a single word. The cell already spells the
+/// word at the position, the search goes on to the unvisited neighbours that
+/// spell the rest of it. Every cell marked as visited is cleared before returning.
+/// </summary>
+/// <param name="cell">board graph cell index, spelling the word at the position</param>
+/// <param name="word">word being looked for</param>
+/// <param name="position">position in the word the cell spells</param>
+/// <param name="visitedCells">bitmask of the cells already in the current path</param>
+/// <param name="search">search statistics of the worker</param>
+/// <returns>true if the word is spelled from the cell on</returns>
+bool BoggleSolver::spellsFrom(size_t cell, const string& word, size_t position, VisitedCells& visitedCells, SearchStats& search) const
+{
+    search.m_nodesExpanded++;
+    const auto next{ position + ((m_graph.letter(cell) == 'q') ? 2 : 1) };
+    if (next == word.size()) return true; // early return, whole word spelled
+
+    visitedCells.set(cell);
+    bool spelled{ false };
+    for (const auto neighbour : m_graph.neighbours(cell))
+    {
+        if (visitedCells.test(neighbour)) continue;
+        if (!cellSpells(m_graph.letter(neighbour), word, next))
+        {
+            search.m_prunedPaths++;
+            continue;
+        }
+        if (spellsFrom(neighbour, word, next, visitedCells, search)) // !! RECURSIVE CALL !!
+        {
+            spelled = true;
+            break;
+        }
     }
+    visitedCells.clear(cell);
+    return spelled;
 }
@@ -0,0 +1,122 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <algorithm>
+
+#include "ChildArena.h"
+
+
+/// <summary>
+/// Class constructor. No memory is allocated until the first allocation.
+/// </summary>
+ChildArena::ChildArena() :
+    m_mutex(),
+    m_blocks(),
+    m_current(nullptr)
+{
+    // intentionally blank
+}
+
+
+/// <summary>
+/// Allocates memory from the current block, adding a new block when it is full.
+/// </summary>
+/// <param name="bytes">number of bytes needed</param>
+/// <returns>memory aligned to ALIGNMENT, valid until release()</returns>
+void* ChildArena::allocate(size_t bytes)
+{
+    bytes = (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    while (true)
+    {
+        auto block{ m_current.load(memory_order_acquire) };
+        if (block != nullptr)
+        {
+            const auto offset{ block->m_used.fetch_add(bytes, memory_order_relaxed) };
+            if (bytes <= block->m_size - min(offset, block->m_size))
+            {
+                return block->m_data.get() + offset;
+            }
+        }
+        addBlock(block, bytes);
+    }
+}
+
+
+/// <summary>
+/// Gives every block back to the heap. Everything allocated from the arena is
+/// invalid afterwards, but the arena can be allocated from again.
+/// </summary>
+void ChildArena::release()
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_current.store(nullptr, memory_order_release);
+    vector<unique_ptr<Block>>().swap(m_blocks);
+}
+
+
+/// <summary>
+/// Number of blocks allocated from the heap.
+/// </summary>
+/// <returns>block count</returns>
+size_t ChildArena::blockCount() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_blocks.size();
+}
+
+
+/// <summary>
+/// Number of bytes allocated from the heap for blocks.
+/// </summary>
+/// <returns>total size of every block in bytes</returns>
+size_t ChildArena::bytesReserved() const
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    size_t bytes{ 0 };
+    for (const auto& block : m_blocks) bytes += block->m_size;
+    return bytes;
+}
+
+
+/// <summary>
+/// Number of bytes handed out, including the storage grown child arrays left
+/// behind. The unused end of a full block is counted as well.
+/// </summary>
+/// <returns>used bytes of every block</returns>
+size_t ChildArena::bytesUsed() const
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    size_t bytes{ 0 };
+    for (const auto& block : m_blocks)
+    {
+        const auto isCurrent{ block.get() == m_current.load(memory_order_relaxed) };
+        bytes += isCurrent ? min(block->m_used.load(memory_order_relaxed), block->m_size) : block->m_size;
+    }
+    return bytes;
+}
+
+
+/// <summary>
+/// Adds a new block and makes it the current one, unless another thread already
+/// replaced the full block in the meantime.
+/// </summary>
+/// <param name="full">current block that ran out of space, nullptr before the first block</param>
+/// <param name="bytes">size of the allocation that didn't fit</param>
+void ChildArena::addBlock(const Block* full, size_t bytes)
+{
+    lock_guard<mutex> lock(m_mutex);
+    if (m_current.load(memory_order_relaxed) != full) return; // early return, already replaced
+
+    const auto size{ max(BLOCK_BYTES, bytes) };
+    auto block{ make_unique<Block>() };
+    block->m_data.reset(new char[size]);
+    block->m_size = size;
+    block->m_used.store(0, memory_order_relaxed);
+
+    m_blocks.push_back(move(block));
+    m_current.store(m_blocks.back().get(), memory_order_release);
+}
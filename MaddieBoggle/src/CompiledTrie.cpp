@@ -0,0 +1,350 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <algorithm>
+#include <cassert>
+#include <queue>
+
+#include "CompiledTrie.h"
+
+
+/// <summary>
+/// Class constructor. The compiled trie is empty until build(...) is called.
+/// </summary>
+CompiledTrie::CompiledTrie() :
+    m_nodes(),
+    m_labelStarts(),
+    m_labels(),
+    m_wordOffsets(),
+    m_nodeData(nullptr),
+    m_labelStartData(nullptr),
+    m_labelData(nullptr),
+    m_wordOffsetData(nullptr),
+    m_remainingDepthData(nullptr),
+    m_nodeCount(0),
+    m_labelCount(0),
+    m_wordCount(0),
+    m_image()
+{
+    // intentionally blank
+}
+
+
+/// <summary>
+/// Move constructor. Moving a vector hands over its buffer, so the lookup views
+/// stay valid and only need to be cleared on the moved from trie.
+/// </summary>
+/// <param name="other">trie to take the records from, left empty</param>
+CompiledTrie::CompiledTrie(CompiledTrie&& other) noexcept :
+    CompiledTrie()
+{
+    *this = move(other);
+}
+
+
+/// <summary>
+/// Move assignment. See the move constructor.
+/// </summary>
+/// <param name="other">trie to take the records from, left empty</param>
+/// <returns>this trie</returns>
+CompiledTrie& CompiledTrie::operator=(CompiledTrie&& other) noexcept
+{
+    if (this == &other) return *this; // early return
+
+    m_nodes = move(other.m_nodes);
+    m_labelStarts = move(other.m_labelStarts);
+    m_labels = move(other.m_labels);
+    m_wordOffsets = move(other.m_wordOffsets);
+    m_remainingDepths = move(other.m_remainingDepths);
+    m_nodeData = other.m_nodeData;
+    m_labelStartData = other.m_labelStartData;
+    m_labelData = other.m_labelData;
+    m_wordOffsetData = other.m_wordOffsetData;
+    m_remainingDepthData = other.m_remainingDepthData;
+    m_nodeCount = other.m_nodeCount;
+    m_labelCount = other.m_labelCount;
+    m_wordCount = other.m_wordCount;
+    m_image = move(other.m_image);
+
+    other.m_nodeData = nullptr;
+    other.m_labelStartData = nullptr;
+    other.m_labelData = nullptr;
+    other.m_wordOffsetData = nullptr;
+    other.m_remainingDepthData = nullptr;
+    other.m_nodeCount = 0;
+    other.m_labelCount = 0;
+    other.m_wordCount = 0;
+    return *this;
+}
+
+
+/// <summary>
+/// Checks if a node is a link in a chain that the radix layout can collapse: it
+/// does not end a word and it only has a single child letter 'a'-'z'.
+/// </summary>
+/// <param name="node">node to check</param>
+/// <param name="letter">set to the letter of the single child if the node is a chain link</param>
+/// <returns>the single child if the node is a chain link, otherwise nullptr</returns>
+static const LetterNode* findChainChild(const LetterNode* node, char& letter)
+{
+    if (node->m_isWordValid) return nullptr;
+
+    const LetterNode* chainChild{ nullptr };
+    for (size_t i = 0; i < node->childCount(); i++)
+    {
+        const auto childLetter{ node->childLetter(i) };
+        if ((childLetter < 'a') || (childLetter > 'z')) continue; // not compiled anyway
+        if (chainChild != nullptr) return nullptr; // more than one child
+
+        chainChild = node->childNode(i);
+        letter = childLetter;
+    }
+    return chainChild;
+}
+
+
+/// <summary>
+/// Compiles the LetterNode trie under the provided root into the flat layout.
+/// Nodes are visited breadth first, so every node's children are appended to
+/// the array right next to each other. Any previously compiled nodes are replaced.
+/// 
+/// When compressChains is set, the radix layout is built: chains of nodes that
+/// don't end a word and only have one child are folded into the edge label of the
+/// record at the top of the chain.
+/// </summary>
+/// <param name="root">root node of the LetterNode trie to compile</param>
+/// <param name="compressChains">true to build the radix layout, false for a plain trie</param>
+void CompiledTrie::build(const LetterNode* root, bool compressChains)
+{
+    assert(root);
+
+    m_image.reset();
+    m_nodes.clear();
+    m_labelStarts.clear();
+    m_labels.clear();
+
+    m_nodes.push_back({ 0, 0 });
+    if (compressChains) m_labelStarts.push_back(0); // the root never has a label
+
+    /* pairs of source nodes and the index of the record they compile into. With
+    chains compressed, the source node is the bottom of the chain. */
+    queue<pair<const LetterNode*, uint32_t>> pending{};
+    pending.push({ root, ROOT });
+
+    while (!pending.empty())
+    {
+        const auto [node, index] { pending.front() };
+        pending.pop();
+
+        uint32_t mask{ node->m_isWordValid ? WORD_FLAG : 0 };
+        const auto firstChild{ static_cast<uint32_t>(m_nodes.size()) };
+
+        /* The child letters are already sorted, so the children get
+        appended in the same order the popcount lookup expects. */
+        for (size_t i = 0; i < node->childCount(); i++)
+        {
+            const auto offset{ static_cast<uint32_t>(node->childLetter(i) - 'a') };
+            if (offset >= ALPHABET_SIZE) continue; // can't be on a board, skip it
+
+            mask |= (1u << offset);
+            const auto childIndex{ static_cast<uint32_t>(m_nodes.size()) };
+            m_nodes.push_back({ 0, 0 });
+
+            const LetterNode* chainEnd{ node->childNode(i) };
+            if (compressChains)
+            {
+                m_labelStarts.push_back(static_cast<uint32_t>(m_labels.size()));
+
+                uint32_t labelLength{ 0 };
+                char chainLetter{};
+                while (labelLength < MAX_LABEL_LENGTH)
+                {
+                    const auto next{ findChainChild(chainEnd, chainLetter) };
+                    if (next == nullptr) break;
+
+                    m_labels.push_back(chainLetter);
+                    chainEnd = next;
+                    labelLength++;
+                }
+
+                // the label length is kept in the record while the child waits in the queue
+                m_nodes[childIndex].m_childMask = labelLength << LABEL_SHIFT;
+            }
+
+            pending.push({ chainEnd, childIndex });
+        }
+
+        // set after the children are appended since push_back can move the records
+        const auto labelBits{ m_nodes[index].m_childMask };
+        m_nodes[index] = { mask | labelBits, firstChild };
+    }
+
+    m_nodes.shrink_to_fit();
+    m_labelStarts.shrink_to_fit();
+    m_labels.shrink_to_fit();
+
+    indexRecords();
+    useOwnedStorage();
+}
+
+
+/// <summary>
+/// A trie with nothing but a root record, so it holds no words. It stands in for
+/// the compiled trie of a dictionary that isn't frozen yet, which has no records
+/// at all and can't be walked.
+/// </summary>
+/// <returns>the shared trie without any words</returns>
+const CompiledTrie& CompiledTrie::noWords()
+{
+    static const CompiledTrie empty{ [] {
+        CompiledTrie trie{};
+        trie.m_nodes.push_back({ 0, 0 });
+        trie.indexRecords();
+        trie.useOwnedStorage();
+        return trie;
+    }() };
+    return empty;
+}
+
+
+/// <summary>
+/// Points the lookup views at the trie's own vectors and drops any mapped image.
+/// Must be called whenever the vectors are (re)filled.
+/// </summary>
+void CompiledTrie::useOwnedStorage()
+{
+    m_image.reset();
+
+    m_nodeData = m_nodes.data();
+    m_labelStartData = m_labelStarts.data();
+    m_labelData = m_labels.data();
+    m_wordOffsetData = m_wordOffsets.data();
+    m_remainingDepthData = m_remainingDepths.data();
+    m_nodeCount = m_nodes.size();
+    m_labelCount = m_labels.size();
+}
+
+
+/// <summary>
+/// Fills in the word offset and the remaining depths of every record and the total
+/// word count from the records in m_nodes (see CompiledTrie.h). Must be called
+/// whenever the records are (re)built.
+/// </summary>
+void CompiledTrie::indexRecords()
+{
+    m_wordOffsets.assign(m_nodes.size(), 0);
+    m_wordOffsets.shrink_to_fit();
+    m_remainingDepths.assign(m_nodes.size(), { static_cast<uint8_t>(MAX_REMAINING_DEPTH), 0 });
+    m_remainingDepths.shrink_to_fit();
+
+    // records can be shared (DAWG layout), so every record is only counted once
+    vector<uint32_t> counts(m_nodes.size(), NO_NODE);
+    m_wordCount = m_nodes.empty() ? 0 : indexRecordsBelow(ROOT, counts);
+}
+
+
+/// <summary>
+/// Counts the words that end at or below a record, setting the word offset of every
+/// child on the way, and works out the record's remaining depths from its children's.
+/// The recursion is only as deep as the longest word.
+/// </summary>
+/// <param name="node">index of the record to count the words of</param>
+/// <param name="counts">already counted records, NO_NODE for records not counted yet</param>
+/// <returns>number of words that end at or below the record</returns>
+uint32_t CompiledTrie::indexRecordsBelow(uint32_t node, vector<uint32_t>& counts)
+{
+    if (counts[node] != NO_NODE) return counts[node]; // early return, shared and already counted
+
+    const auto record{ m_nodes[node] };
+    const auto childCount{ countBits(record.m_childMask & LETTER_MASK) };
+    const bool endsWord{ (record.m_childMask & WORD_FLAG) != 0 };
+
+    uint32_t shortest{ endsWord ? 0 : MAX_REMAINING_DEPTH };
+    uint32_t longest{ 0 };
+    uint32_t wordsBelowSiblings{ 0 };
+    for (uint32_t i = 0; i < childCount; i++)
+    {
+        const auto child{ record.m_firstChild + i };
+        m_wordOffsets[child] = wordsBelowSiblings;
+        wordsBelowSiblings += indexRecordsBelow(child, counts);
+
+        // the letter selecting the child, then its label, then whatever is below it
+        const auto childLetters{ 1 + ((m_nodes[child].m_childMask >> LABEL_SHIFT) & MAX_LABEL_LENGTH) };
+        shortest = min(shortest, childLetters + m_remainingDepths[child].m_shortest);
+        longest = max(longest, childLetters + m_remainingDepths[child].m_longest);
+    }
+
+    m_remainingDepths[node] = { static_cast<uint8_t>(min(shortest, MAX_REMAINING_DEPTH)), static_cast<uint8_t>(min(longest, MAX_REMAINING_DEPTH)) };
+    counts[node] = wordsBelowSiblings + (endsWord ? 1 : 0);
+    return counts[node];
+}
+
+
+/// <summary>
+/// Rebuilds the word with the provided id by walking down from the root, always
+/// taking the child whose words contain the id.
+/// </summary>
+/// <param name="wordId">id of the word, must be less than wordCount()</param>
+/// <returns>the word</returns>
+string CompiledTrie::wordAt(uint32_t wordId) const
+{
+    assert(wordId < m_wordCount);
+
+    string word{};
+    uint32_t node{ ROOT };
+    uint32_t remaining{ wordId };   // words left to skip below the current record
+    while (true)
+    {
+        for (uint32_t position = 0; position < labelLength(node); position++)
+        {
+            word.push_back(labelLetter(node, position));
+        }
+
+        // a word ending here comes before every longer word below it
+        if (isWord(node))
+        {
+            if (remaining == 0) return word;
+            remaining--;
+        }
+
+        /* The offsets of the children only grow (every record has at least one word
+        below it), so the child to take is the last one that doesn't skip too many. */
+        const auto& record{ m_nodeData[node] };
+        auto child{ record.m_firstChild };
+        uint32_t chosenChild{ NO_NODE };
+        char chosenLetter{};
+        for (uint32_t offset = 0; offset < ALPHABET_SIZE; offset++)
+        {
+            if ((record.m_childMask & (1u << offset)) == 0) continue;
+            if (m_wordOffsetData[child] > remaining) break;
+
+            chosenChild = child;
+            chosenLetter = static_cast<char>('a' + offset);
+            child++;
+        }
+        assert(chosenChild != NO_NODE);
+
+        remaining -= m_wordOffsetData[chosenChild];
+        word.push_back(chosenLetter);
+        node = chosenChild;
+    }
+}
+
+
+/// <summary>
+/// Number of bytes used by the compiled records, their word offsets and remaining
+/// depths and, in the radix layout, the labels.
+/// For a mapped image this is the size of the image, none of which is on the heap.
+/// </summary>
+/// <returns>memory usage in bytes</returns>
+size_t CompiledTrie::memoryUsage() const
+{
+    if (m_image) return m_image->size();
+
+    return (m_nodes.capacity() * sizeof(CompiledNode)) 
+        + (m_labelStarts.capacity() * sizeof(uint32_t)) 
+        + m_labels.capacity() 
+        + (m_wordOffsets.capacity() * sizeof(uint32_t))
+        + (m_remainingDepths.capacity() * sizeof(RemainingDepth));
+}
@@ -0,0 +1,234 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <algorithm>
+#include <cassert>
+#include <queue>
+
+#include "DawgBuilder.h"
+
+
+/// <summary>
+/// Class constructor. Creates the root state, which is never minimized.
+/// </summary>
+DawgBuilder::DawgBuilder() :
+    m_states(),
+    m_freeStates(),
+    m_register(0, StateHash{ &m_states }, StateEqual{ &m_states }),
+    m_uncheckedPath(),
+    m_previousWord(),
+    m_nodesCreated(0)
+{
+    m_uncheckedPath.push_back(createState()); // root
+}
+
+
+/// <summary>
+/// Inserts the next word into the graph. Words must be inserted in sorted order,
+/// duplicates of the previous word are ignored. Words containing anything other
+/// than the letters 'a'-'z' can't be on a boggle board and are skipped.
+/// 
+/// The follow error codes can be returned from here:
+/// 0 - success
+/// 5 - word comes before the previously inserted word
+/// </summary>
+/// <param name="word">String word to add to the graph.</param>
+/// <returns>enum class error code indicating success status</returns>
+ErrorCode DawgBuilder::insertWord(const string& word)
+{
+    return insertWord(word.data(), word.size());
+}
+
+
+/// <summary>
+/// Same as insertWord(word), for a word that isn't a string of its own, like the
+/// words an import finds in the mapped dictionary file (see WordScanner).
+/// </summary>
+/// <param name="word">first letter of the word</param>
+/// <param name="length">letters in the word</param>
+/// <returns>enum class error code indicating success status</returns>
+ErrorCode DawgBuilder::insertWord(const char* word, size_t length)
+{
+    assert(length > 0);
+
+    const auto wordEnd{ word + length };
+    const auto isLetter = [](char letter) { return (letter >= 'a') && (letter <= 'z'); };
+    if (!all_of(word, wordEnd, isLetter)) return ErrorCode::SUCCESS;
+
+    const auto order{ m_previousWord.compare(0, string::npos, word, length) };
+    if (order > 0) return ErrorCode::UNSORTED_INPUT;
+    if (order == 0) return ErrorCode::SUCCESS; // duplicate
+
+    /* Everything in the previous word past the shared prefix is final, so it
+    can be minimized before the new suffix is added. */
+    const auto prefixEnd{ mismatch(word, wordEnd, m_previousWord.begin(), m_previousWord.end()).first };
+    const auto prefixSize{ static_cast<size_t>(prefixEnd - word) };
+    minimize(prefixSize);
+
+    auto state{ m_uncheckedPath.back() };
+    for (auto it = prefixEnd; it != wordEnd; ++it)
+    {
+        const auto child{ createState() }; // may move m_states, so index after
+        m_states[state].m_edges.emplace_back(*it, child);
+        m_uncheckedPath.push_back(child);
+        state = child;
+    }
+
+    m_states[state].m_isWordValid = true;
+    m_previousWord.assign(word, length);
+    return ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Minimizes the rest of the graph and compiles it into the provided trie,
+/// replacing anything that was in it. The builder should not be used afterwards.
+/// 
+/// Every state with children gets one contiguous block of CompiledNode records,
+/// one per child in letter order. States that were merged during minimization are
+/// reached from several parents, but their block of children only exists once.
+/// </summary>
+/// <param name="trie">compiled trie to write the graph into</param>
+void DawgBuilder::finish(CompiledTrie& trie)
+{
+    minimize(0);
+
+    vector<CompiledNode> nodes{};
+    vector<uint32_t> blockStart(m_states.size(), 0);
+    vector<bool> queued(m_states.size(), false);
+    vector<uint32_t> order{};
+
+    // breadth first so the top levels of the graph stay close together
+    nodes.push_back({ 0, 0 }); // root record
+    queue<uint32_t> pending{};
+    pending.push(ROOT_STATE);
+    queued[ROOT_STATE] = true;
+
+    while (!pending.empty())
+    {
+        const auto state{ pending.front() };
+        pending.pop();
+        order.push_back(state);
+
+        const auto& edges{ m_states[state].m_edges };
+        blockStart[state] = static_cast<uint32_t>(nodes.size());
+        nodes.resize(nodes.size() + edges.size());
+
+        for (const auto& [letter, target] : edges)
+        {
+            if (!queued[target])
+            {
+                queued[target] = true;
+                pending.push(target);
+            }
+        }
+    }
+
+    // records can only be written once every block has a position
+    const auto recordOf = [&](uint32_t state) {
+        uint32_t mask{ m_states[state].m_isWordValid ? CompiledTrie::WORD_FLAG : 0 };
+        for (const auto& edge : m_states[state].m_edges)
+        {
+            mask |= (1u << (edge.first - 'a'));
+        }
+        return CompiledNode{ mask, blockStart[state] };
+    };
+
+    nodes[CompiledTrie::ROOT] = recordOf(ROOT_STATE);
+    for (const auto state : order)
+    {
+        const auto& edges{ m_states[state].m_edges };
+        for (size_t i = 0; i < edges.size(); i++)
+        {
+            nodes[blockStart[state] + i] = recordOf(edges[i].second);
+        }
+    }
+
+    nodes.shrink_to_fit();
+    trie.m_nodes = move(nodes);
+    trie.m_labelStarts.clear(); // no chains are collapsed in this layout
+    trie.m_labels.clear();
+    trie.indexRecords();
+    trie.useOwnedStorage();
+}
+
+
+/// <summary>
+/// Gets a new empty state, reusing the id of a merged state if there is one.
+/// </summary>
+/// <returns>id of the new state</returns>
+uint32_t DawgBuilder::createState()
+{
+    m_nodesCreated++;
+
+    if (!m_freeStates.empty())
+    {
+        const auto state{ m_freeStates.back() };
+        m_freeStates.pop_back();
+        return state;
+    }
+
+    m_states.push_back({ false, {} });
+    return static_cast<uint32_t>(m_states.size() - 1);
+}
+
+
+/// <summary>
+/// Walks the unchecked path of the previous word from the deepest state back up
+/// to the provided depth. Each state is either merged into an identical state from
+/// the register (its parent is pointed at the registered state and its id is
+/// recycled) or becomes the registered copy itself.
+/// </summary>
+/// <param name="downTo">number of letters of the unchecked path to keep unminimized</param>
+void DawgBuilder::minimize(size_t downTo)
+{
+    while (m_uncheckedPath.size() > downTo + 1)
+    {
+        const auto child{ m_uncheckedPath.back() };
+        m_uncheckedPath.pop_back();
+        const auto parent{ m_uncheckedPath.back() };
+
+        const auto registered{ m_register.find(child) };
+        if (registered != m_register.end())
+        {
+            /* The child is always the last edge of its parent, since it was
+            the last one added by the sorted input. */
+            m_states[parent].m_edges.back().second = *registered;
+
+            m_states[child] = { false, {} };
+            m_freeStates.push_back(child);
+        }
+        else
+        {
+            m_register.insert(child);
+        }
+    }
+}
+
+
+/// <summary>
+/// Hashes the content of a state: its end of word flag and its edges.
+/// </summary>
+size_t DawgBuilder::StateHash::operator()(uint32_t state) const
+{
+    const auto& content{ (*m_states)[state] };
+    size_t hash{ content.m_isWordValid ? 1u : 0u };
+    for (const auto& [letter, target] : content.m_edges)
+    {
+        hash = (hash * 31) + static_cast<size_t>(letter);
+        hash = (hash * 1000003) ^ target;
+    }
+    return hash;
+}
+
+
+/// <summary>
+/// Compares the content of two states: their end of word flags and their edges.
+/// </summary>
+bool DawgBuilder::StateEqual::operator()(uint32_t lhs, uint32_t rhs) const
+{
+    const auto& left{ (*m_states)[lhs] };
+    const auto& right{ (*m_states)[rhs] };
+    return (left.m_isWordValid == right.m_isWordValid) && (left.m_edges == right.m_edges);
+}
@@ -2,22 +2,31 @@
 // Place Holder Copyright Header
 //
 
-#include <fstream>
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <vector>
 
+#include "DawgBuilder.h"
 #include "Dictionary.h"
+#include "DictionaryImage.h"
 #include "ErrorCodes.h"
+#include "MappedFile.h"
+#include "WordScanner.h"
 
 
 /// <summary>
 /// Class constructor. Creates the pool where all dictionary nodes will be allocated
 /// from. The root node of the dictionary is the first allocated node from the pool.
-/// <param name="word">Number of nodes to be allocated for in the node pool.</param>
+/// The pool grows as words are inserted, up to the optional node limit.
+/// <param name="nodeLimit">Optional most nodes the trie may use, unlimited by default.</param>
 /// </summary>
-Dictionary::Dictionary(size_t poolSize) :
-    m_pool(poolSize),
-	m_wordCount(0)
+Dictionary::Dictionary(size_t nodeLimit) :
+    m_childArena(make_unique<ChildArena>()),
+    m_pool(nodeLimit, m_childArena.get()),
+    m_compiled(),
+	m_wordCount(0),
+    m_minimizationReport{ 0, 0 }
 {
     m_root = m_pool.allocate(); // create root of the trie
 }
@@ -32,35 +41,58 @@ Dictionary::Dictionary(size_t poolSize) :
 /// The follow error codes can be returned from here:
 /// 0 - success
 /// 3 - out of pool memory, dictionary too big
+/// 4 - dictionary is frozen and can't be changed
 /// </summary>
 /// <param name="word">String word to add to the dictionary trie data structure.</param>
 /// <returns>enum class error code indicating success status</returns>
 ErrorCode Dictionary::insertWord(const string& word)
 {
+    return insertWord(word.data(), word.size());
+}
+
+
+/// <summary>
+/// Same as insertWord(word), for a word that isn't a string of its own, like the
+/// words an import finds in the mapped dictionary file (see WordScanner).
+/// </summary>
+/// <param name="word">first letter of the word</param>
+/// <param name="length">letters in the word</param>
+/// <returns>enum class error code indicating success status</returns>
+ErrorCode Dictionary::insertWord(const char* word, size_t length)
+{
+    assert(length > 0);
+
+    if (isFrozen()) return ErrorCode::DICTIONARY_FROZEN;
     assert(m_root);
-    assert(word.size() > 0);
 
-    /* Return early if word is a duplicate OR word is too small. */
-    if (searchDictionary(word, SearchType::WORD) || (word.size() < m_minWordSize)) return ErrorCode::SUCCESS;
+    /* Return early if word is too small. */
+    if (length < m_minWordSize) return ErrorCode::SUCCESS;
 
     auto currentNode{ m_root };
-    for (const auto& letter : word)
+    for (size_t i = 0; i < length; i++)
     {
+        const auto letter{ word[i] };
+
         /* If letter could not be found, then a node for it needs to be created.
         If there is no more allocated space for a new node, end early and return
         with error code. */
-        if (currentNode->findChild(letter) == nullptr)
+        auto child{ currentNode->findChild(letter) };
+        if (child == nullptr)
         {
-            auto child{ m_pool.allocate() };
+            child = m_pool.allocate();
             if (child == nullptr) return ErrorCode::OUT_OF_POOL_SPACE; 
 
             currentNode->insertChild(letter, child);
         }
 
         // Move into the matching node to check for the next letter.
-        currentNode = currentNode->findChild(letter);
+        currentNode = child;
     }
 
+    /* A duplicate walks an existing path and ends on a node that is already
+    a word, so it is detected here without searching the trie first. */
+    if (currentNode->m_isWordValid) return ErrorCode::SUCCESS;
+
     // End of word insertion, set current node's word valid flag as true.
     currentNode->m_isWordValid = true;
 
@@ -80,9 +112,21 @@ ErrorCode Dictionary::insertWord(const string& word)
 /// <returns>bool true if word exists, otherwise false</returns>
 bool Dictionary::searchDictionary(const string& word, SearchType searchType) const
 {
-    assert(m_root);
     assert(word.size() > 0);
 
+    /* A frozen dictionary only has the compiled trie left, the cursor walks it
+    the same way the trie walk below does. */
+    if (isFrozen())
+    {
+        DictionaryCursor cursor(*this);
+        for (const auto& letter : word)
+        {
+            if (!cursor.advance(letter)) return false; // early return
+        }
+        return (searchType == SearchType::PATH) || cursor.isWord();
+    }
+
+    assert(m_root);
     auto currentNode{ m_root };
     for (const auto& letter : word)
     {
@@ -111,7 +155,90 @@ bool Dictionary::searchDictionary(const string& word, SearchType searchType) con
 
 
 /// <summary>
-/// Imports the dictionary from the provided filepath into the word trie.
+/// Compiles the trie into its flat read-only form (see CompiledTrie.h) and gives
+/// the LetterNode pool and its child arena back to the heap. After this call, words can no longer be
+/// inserted, but all searches (and cursors) use the compiled trie.
+/// 
+/// The follow error codes can be returned from here:
+/// 0 - success
+/// 4 - dictionary was already frozen
+/// </summary>
+/// <param name="layout">layout to compile the trie into, plain trie by default</param>
+/// <returns>enum class error code indicating success status</returns>
+ErrorCode Dictionary::freeze(DictionaryLayout layout)
+{
+    if (isFrozen()) return ErrorCode::DICTIONARY_FROZEN;
+    assert(m_root);
+
+    m_compiled.build(m_root, layout == DictionaryLayout::RADIX);
+
+    m_root = nullptr;
+    m_pool.release();
+    m_childArena->release();
+
+#ifdef _DEBUG
+    cout << "Compiled dictionary nodes: " << m_compiled.nodeCount() 
+        << " (" << m_compiled.memoryUsage() << " bytes)\n";
+#endif
+    return ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Saves the frozen dictionary to a binary image (see DictionaryImage.h). The
+/// dictionary must be frozen.
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 2 --> the image could not be written
+/// </summary>
+/// <param name="imagePath">location of the image file, replaced if it exists</param>
+/// <param name="sourceFingerprint">fingerprint of the text dictionary this was imported from</param>
+/// <returns>error code</returns>
+ErrorCode Dictionary::saveImage(const string& imagePath, uint64_t sourceFingerprint) const
+{
+    assert(isFrozen());
+    return DictionaryImage::write(m_compiled, imagePath, sourceFingerprint);
+}
+
+
+/// <summary>
+/// Loads a frozen dictionary straight from a binary image. The image is mapped
+/// into memory and searched in place, so nothing is parsed or allocated per node.
+/// The LetterNode pool is never used and is released.
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 1 --> unable to open image file
+/// 2 --> image file opened but could not be mapped
+/// 4 --> dictionary is already frozen
+/// 6 --> image is stale or corrupted, the text dictionary should be imported instead
+/// </summary>
+/// <param name="imagePath">location of the image file</param>
+/// <param name="sourceFingerprint">fingerprint of the text dictionary the image must be built from</param>
+/// <returns>error code</returns>
+ErrorCode Dictionary::loadImage(const string& imagePath, uint64_t sourceFingerprint)
+{
+    if (isFrozen()) return ErrorCode::DICTIONARY_FROZEN;
+
+    const auto errorCode{ DictionaryImage::read(m_compiled, imagePath, sourceFingerprint) };
+    if (errorCode != ErrorCode::SUCCESS) return errorCode;
+
+    m_root = nullptr;
+    m_pool.release();
+    m_childArena->release();
+
+#ifdef _DEBUG
+    cout << "Mapped dictionary nodes: " << m_compiled.nodeCount() 
+        << " (" << m_compiled.memoryUsage() << " bytes)\n";
+#endif
+    return ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Imports the dictionary from the provided filepath into the word trie. The file
+/// is mapped and every word is inserted straight from the mapping.
 /// 
 /// The following error codes can be returned:
 /// 0 --> success, no error
@@ -126,22 +253,24 @@ ErrorCode Dictionary::importDictionary(const string& filepath)
 {
     try
     {
-        ifstream file(filepath);
-        if (!file)
+        MappedFile file{};
+        const auto openCode{ file.open(filepath) };
+        if (openCode != ErrorCode::SUCCESS)
         {
             cerr << "Error finding file at path: " << filepath << ".\n";
-            return ErrorCode::FILE_NOT_FOUND;
+            return openCode;
         }
+        reservePool(file.size());
 
-        string word{};
+        WordScanner scanner(file.data(), file.size());
+        WordView word{};
         ErrorCode errorCode;
-        while (file >> word) // Import words line-by-line
+        while (scanner.next(word)) // Import words one by one
         {
-            errorCode = insertWord(word);
+            errorCode = insertWord(word.m_data, word.m_length);
             if (errorCode != ErrorCode::SUCCESS) { return errorCode; }
         }
 
-        file.close();
 #ifdef _DEBUG
         cout << "Imported word count: " << m_wordCount << "\n";
 #endif
@@ -153,3 +282,309 @@ ErrorCode Dictionary::importDictionary(const string& filepath)
         return ErrorCode::UNKNOWN_FILE_ERR;
     }
 }
+
+
+/// <summary>
+/// Words of a parallel import that share their first two letters, and everything
+/// the task inserting them needs. See importDictionary(filepath, pool).
+/// </summary>
+struct PrefixGroup
+{
+    vector<WordView> m_words;       // into the mapped file, sorted once the group is counted
+    LetterNode* m_prefixNode;       // node of the two letter prefix, the words are inserted below it
+    size_t m_nodeCount;             // nodes needed below the prefix node, at most
+    vector<LetterNode*> m_region;   // nodes reserved for the group, unused ones go back to the pool
+    size_t m_newWords;              // words that were not in the dictionary yet
+};
+
+
+/// <summary>
+/// Sorts the words of a group and counts the nodes its words need below the prefix
+/// node. Once sorted, a word only needs nodes for the letters it doesn't share with
+/// the word before it, which is exactly how many the trie would create for it.
+/// </summary>
+/// <param name="group">group to sort and count</param>
+static void countPrefixGroup(PrefixGroup& group)
+{
+    sort(group.m_words.begin(), group.m_words.end());
+
+    constexpr size_t prefixLength{ 2 };
+    group.m_nodeCount = 0;
+    const WordView* previous{ nullptr };
+    for (const auto& word : group.m_words)
+    {
+        size_t shared{ prefixLength };
+        if (previous != nullptr)
+        {
+            const auto limit{ min(previous->m_length, word.m_length) };
+            while ((shared < limit) && (previous->m_data[shared] == word.m_data[shared])) shared++;
+        }
+        group.m_nodeCount += word.m_length - shared;
+        previous = &word;
+    }
+}
+
+
+/// <summary>
+/// Inserts the sorted words of a group below its prefix node, taking new nodes from
+/// the group's own region. Same steps as Dictionary::insertWord, minus the pool.
+/// </summary>
+/// <param name="group">counted group with its prefix node and region set</param>
+static void insertPrefixGroup(PrefixGroup& group)
+{
+    group.m_newWords = 0;
+    for (const auto& word : group.m_words)
+    {
+        auto currentNode{ group.m_prefixNode };
+        for (size_t i = 2; i < word.m_length; i++)
+        {
+            auto child{ currentNode->findChild(word.m_data[i]) };
+            if (child == nullptr)
+            {
+                assert(!group.m_region.empty()); // the region was sized by countPrefixGroup
+                child = group.m_region.back();
+                group.m_region.pop_back();
+
+                currentNode->insertChild(word.m_data[i], child);
+            }
+            currentNode = child;
+        }
+
+        if (!currentNode->m_isWordValid)
+        {
+            currentNode->m_isWordValid = true;
+            group.m_newWords++;
+        }
+    }
+}
+
+
+/// <summary>
+/// Imports the dictionary from the provided filepath into the word trie, inserting
+/// the words on the provided thread pool. The trie is the same one importDictionary(filepath)
+/// builds, so the two can be used interchangeably.
+/// 
+/// The file is mapped and its words are split into groups by their first two letters
+/// (words are at least m_minWordSize long, so they always have two). The groups only
+/// point into the mapping, which stays open until the words are inserted. Then, in
+/// three steps:
+/// - every group is sorted and counted on the pool (see countPrefixGroup)
+/// - the prefix nodes are created under m_root and every group gets a region of the
+///   node pool big enough for it, here on the calling thread
+/// - every group is inserted below its prefix node on the pool (see insertPrefixGroup)
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 1 --> unable to open file
+/// 2 --> unprecendented error saved by a try-catch block, error is not identified, 
+///     so the callee should exit gracefully
+/// 3 --> out of allocatable nodes in the pool
+/// 4 --> dictionary is frozen and can't be changed
+/// </summary>
+/// <param name="filepath">location of the dictionary file to import</param>
+/// <param name="pool">thread pool to insert the words on</param>
+/// <returns>error code</returns>
+ErrorCode Dictionary::importDictionary(const string& filepath, ThreadPool& pool)
+{
+    static_assert(m_minWordSize >= 2, "words are grouped by their first two letters");
+    if (isFrozen()) return ErrorCode::DICTIONARY_FROZEN;
+
+    try
+    {
+        MappedFile file{};
+        const auto openCode{ file.open(filepath) };
+        if (openCode != ErrorCode::SUCCESS)
+        {
+            cerr << "Error finding file at path: " << filepath << ".\n";
+            return openCode;
+        }
+        reservePool(file.size());
+
+        // one slot per pair of first letters, every word only has 'a'-'z'
+        constexpr size_t letters{ 'z' - 'a' + 1 };
+        vector<vector<WordView>> wordsByPrefix(letters * letters);
+        WordScanner scanner(file.data(), file.size());
+        WordView word{};
+        while (scanner.next(word)) // Import words one by one
+        {
+            if (word.m_length < m_minWordSize) continue;
+
+            const auto slot{ static_cast<size_t>(word.m_data[0] - 'a') * letters + static_cast<size_t>(word.m_data[1] - 'a') };
+            wordsByPrefix[slot].push_back(word);
+        }
+
+        vector<PrefixGroup> groups{};
+        for (auto& words : wordsByPrefix)
+        {
+            if (!words.empty()) groups.push_back({ move(words), nullptr, 0, {}, 0 });
+        }
+        wordsByPrefix.clear();
+
+        for (auto& group : groups)
+        {
+            pool.queueTask([&group]() { countPrefixGroup(group); });
+        }
+        pool.waitForCompletion();
+
+        /* Only this thread touches the pool and the top two levels of the trie,
+        the tasks below only ever write to nodes of their own group. */
+        for (auto& group : groups)
+        {
+            auto currentNode{ m_root };
+            for (size_t i = 0; i < 2; i++)
+            {
+                const auto letter{ group.m_words.front().m_data[i] };
+                auto child{ currentNode->findChild(letter) };
+                if (child == nullptr)
+                {
+                    child = m_pool.allocate();
+                    if (child == nullptr) return ErrorCode::OUT_OF_POOL_SPACE;
+
+                    currentNode->insertChild(letter, child);
+                }
+                currentNode = child;
+            }
+            group.m_prefixNode = currentNode;
+
+            if (!m_pool.allocateRegion(group.m_nodeCount, group.m_region)) return ErrorCode::OUT_OF_POOL_SPACE;
+        }
+
+        for (auto& group : groups)
+        {
+            pool.queueTask([&group]() { insertPrefixGroup(group); });
+        }
+        pool.waitForCompletion();
+
+        // nodes that already existed before the import leave part of a region unused
+        for (auto& group : groups)
+        {
+            for (const auto node : group.m_region) m_pool.deallocate(node);
+            m_wordCount += group.m_newWords;
+        }
+
+#ifdef _DEBUG
+        cout << "Imported word count: " << m_wordCount << "\n";
+#endif
+        return ErrorCode::SUCCESS;
+    }
+    catch (...)
+    {
+        cerr << "Unexpected error when importing dictionary file!\n";
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+}
+
+
+/// <summary>
+/// Grows the node pool up front to the size the dictionary file is expected to
+/// need (see LetterNodePool::estimateNodeCount), so an import doesn't add chunks
+/// one at a time.
+/// </summary>
+/// <param name="fileSize">size of the dictionary file in bytes</param>
+void Dictionary::reservePool(size_t fileSize)
+{
+    m_pool.reserve(LetterNodePool::estimateNodeCount(fileSize));
+}
+
+
+/// <summary>
+/// Imports the dictionary from the provided filepath straight into a minimized,
+/// frozen graph where words share common suffixes as well as prefixes (see
+/// DawgBuilder.h). The LetterNode pool is never used and is released.
+/// 
+/// The file is mapped and the words are sorted in place, as views into the mapping,
+/// so the file does not need to be sorted.
+/// The node counts before and after minimization can be read afterwards with
+/// getMinimizationReport().
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 1 --> unable to open file
+/// 2 --> unprecendented error saved by a try-catch block, error is not identified, 
+///     so the callee should exit gracefully
+/// 4 --> dictionary is already frozen
+/// </summary>
+/// <param name="filepath">location of the dictionary file to import</param>
+/// <returns>error code</returns>
+ErrorCode Dictionary::importMinimizedDictionary(const string& filepath)
+{
+    if (isFrozen()) return ErrorCode::DICTIONARY_FROZEN;
+
+    try
+    {
+        MappedFile file{};
+        const auto openCode{ file.open(filepath) };
+        if (openCode != ErrorCode::SUCCESS)
+        {
+            cerr << "Error finding file at path: " << filepath << ".\n";
+            return openCode;
+        }
+
+        vector<WordView> words{};
+        WordScanner scanner(file.data(), file.size());
+        WordView word{};
+        while (scanner.next(word)) // Import words one by one
+        {
+            if (word.m_length >= m_minWordSize) words.push_back(word);
+        }
+
+        // incremental minimization needs sorted input
+        sort(words.begin(), words.end());
+
+        DawgBuilder builder{};
+        for (const auto& sortedWord : words)
+        {
+            const auto errorCode{ builder.insertWord(sortedWord.m_data, sortedWord.m_length) };
+            if (errorCode != ErrorCode::SUCCESS) { return errorCode; }
+        }
+        builder.finish(m_compiled);
+
+        m_root = nullptr;
+        m_pool.release();
+        m_childArena->release();
+
+        m_minimizationReport = { builder.nodesBeforeMinimization(), builder.nodesAfterMinimization() };
+#ifdef _DEBUG
+        cout << "Minimized dictionary nodes: " << m_minimizationReport.m_nodesBefore 
+            << " --> " << m_minimizationReport.m_nodesAfter << "\n";
+#endif
+        return ErrorCode::SUCCESS;
+    }
+    catch (...)
+    {
+        cerr << "Unexpected error when importing dictionary file!\n";
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+}
+
+
+/// <summary>
+/// Cursor constructor. The cursor starts at the root of the provided dictionary,
+/// which represents an empty prefix. Only a frozen dictionary can be walked, the
+/// cursor of one that isn't frozen yet finds no words at all.
+/// </summary>
+/// <param name="dictionary">frozen dictionary to walk, must outlive the cursor</param>
+DictionaryCursor::DictionaryCursor(const Dictionary& dictionary) :
+    m_trie(dictionary.getCompiledTrie()),
+    m_path()
+{
+    m_path.reserve(m_reservedDepth); // avoids re-allocations for typical word lengths
+    m_path.push_back({ CompiledTrie::ROOT, 0, 0 });
+}
+
+
+/// <summary>
+/// Cursor constructor for a compiled trie that isn't part of a dictionary, like a
+/// BoardTrie. The cursor starts at the root of the trie.
+/// </summary>
+/// <param name="trie">compiled trie to walk, must not be empty and must outlive the cursor</param>
+DictionaryCursor::DictionaryCursor(const CompiledTrie& trie) :
+    m_trie(trie),
+    m_path()
+{
+    assert(!trie.isEmpty());
+
+    m_path.reserve(m_reservedDepth);
+    m_path.push_back({ CompiledTrie::ROOT, 0, 0 });
+}
+
@@ -0,0 +1,219 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "DictionaryImage.h"
+#include "MappedFile.h"
+
+
+static_assert(sizeof(CompiledNode) == 8, "image records must be 8 bytes");
+
+
+/// <summary>
+/// 64 bit FNV-1a hash. Used for both the source fingerprint and the payload
+/// checksum. It is not cryptographic, it only needs to notice changed files.
+/// </summary>
+/// <param name="data">bytes to hash</param>
+/// <param name="size">number of bytes to hash</param>
+/// <param name="seed">starting value, lets several blocks be chained together</param>
+/// <returns>hash of the bytes</returns>
+uint64_t DictionaryImage::checksum(const char* data, size_t size, uint64_t seed)
+{
+    constexpr uint64_t FNV_PRIME{ 0x100000001b3 };
+
+    uint64_t hash{ seed };
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+
+/// <summary>
+/// Computes the fingerprint of a text dictionary, which is stored in the image
+/// header to tell if the image is still up to date. The file is mapped rather
+/// than read, and hashing it is far cheaper than parsing it into a trie.
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 1 --> unable to open file
+/// 2 --> file opened but could not be mapped
+/// </summary>
+/// <param name="filepath">location of the text dictionary</param>
+/// <param name="fingerprint">set to the fingerprint of the file</param>
+/// <returns>error code</returns>
+ErrorCode DictionaryImage::fingerprintFile(const string& filepath, uint64_t& fingerprint)
+{
+    constexpr uint64_t FNV_OFFSET_BASIS{ 0xcbf29ce484222325 };
+
+    MappedFile file{};
+    const auto errorCode{ file.open(filepath) };
+    if (errorCode != ErrorCode::SUCCESS)
+    {
+        cerr << "Error finding file at path: " << filepath << ".\n";
+        return errorCode;
+    }
+
+    // the size is mixed in first so an empty file still gets a distinct fingerprint
+    const uint64_t size{ file.size() };
+    fingerprint = checksum(reinterpret_cast<const char*>(&size), sizeof(size), FNV_OFFSET_BASIS);
+    fingerprint = checksum(file.data(), file.size(), fingerprint);
+    return ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Writes the compiled trie to an image file. The image is written to a temporary
+/// file first and then renamed over imagePath, so a process loading the image at
+/// the same time never sees a half written file.
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 2 --> the image could not be written
+/// </summary>
+/// <param name="trie">compiled trie to write, must not be empty</param>
+/// <param name="imagePath">location of the image file, replaced if it exists</param>
+/// <param name="sourceFingerprint">fingerprint of the text dictionary the trie was built from</param>
+/// <returns>error code</returns>
+ErrorCode DictionaryImage::write(const CompiledTrie& trie, const string& imagePath, uint64_t sourceFingerprint)
+{
+    assert(!trie.isEmpty());
+
+    const auto nodeBytes{ trie.m_nodeCount * sizeof(CompiledNode) };
+    const auto wordOffsetBytes{ trie.m_nodeCount * sizeof(uint32_t) };
+    const auto labelStartCount{ (trie.m_labelCount > 0) ? trie.m_nodeCount : 0 };
+    const auto labelStartBytes{ labelStartCount * sizeof(uint32_t) };
+    const auto remainingDepthBytes{ trie.m_nodeCount * sizeof(RemainingDepth) };
+
+    Header header{};
+    memcpy(header.m_magic, MAGIC, sizeof(MAGIC));
+    header.m_version = VERSION;
+    header.m_byteOrder = BYTE_ORDER_MARK;
+    header.m_sourceFingerprint = sourceFingerprint;
+    header.m_nodeCount = static_cast<uint32_t>(trie.m_nodeCount);
+    header.m_labelStartCount = static_cast<uint32_t>(labelStartCount);
+    header.m_labelCount = static_cast<uint32_t>(trie.m_labelCount);
+    header.m_wordCount = trie.m_wordCount;
+
+    auto& hash{ header.m_payloadChecksum };
+    hash = checksum(reinterpret_cast<const char*>(trie.m_nodeData), nodeBytes, sourceFingerprint);
+    hash = checksum(reinterpret_cast<const char*>(trie.m_wordOffsetData), wordOffsetBytes, hash);
+    hash = checksum(reinterpret_cast<const char*>(trie.m_labelStartData), labelStartBytes, hash);
+    hash = checksum(trie.m_labelData, trie.m_labelCount, hash);
+    hash = checksum(reinterpret_cast<const char*>(trie.m_remainingDepthData), remainingDepthBytes, hash);
+
+    const string tempPath{ imagePath + ".tmp" };
+    {
+        ofstream file(tempPath, ios::binary | ios::trunc);
+        if (!file) return ErrorCode::UNKNOWN_FILE_ERR;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(trie.m_nodeData), nodeBytes);
+        file.write(reinterpret_cast<const char*>(trie.m_wordOffsetData), wordOffsetBytes);
+        file.write(reinterpret_cast<const char*>(trie.m_labelStartData), labelStartBytes);
+        file.write(trie.m_labelData, trie.m_labelCount);
+        file.write(reinterpret_cast<const char*>(trie.m_remainingDepthData), remainingDepthBytes);
+        if (!file)
+        {
+            file.close();
+            remove(tempPath.c_str());
+            return ErrorCode::UNKNOWN_FILE_ERR;
+        }
+    }
+
+    /* rename(...) replaces an existing file in one step on POSIX, Windows refuses
+    to rename over an existing file so the old image is removed first there. */
+    if (rename(tempPath.c_str(), imagePath.c_str()) != 0)
+    {
+        remove(imagePath.c_str());
+        if (rename(tempPath.c_str(), imagePath.c_str()) != 0)
+        {
+            remove(tempPath.c_str());
+            return ErrorCode::UNKNOWN_FILE_ERR;
+        }
+    }
+    return ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Maps an image file and points the trie at the records inside it. Any records
+/// the trie already had are replaced. The image is only accepted if it was written
+/// by this version, on a machine with the same byte order, from a text dictionary
+/// with the same fingerprint, and its checksum matches. Otherwise the trie is left
+/// unchanged.
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 1 --> unable to open image file
+/// 2 --> image file opened but could not be mapped
+/// 6 --> image is stale, from another version or corrupted, it should be rebuilt
+/// </summary>
+/// <param name="trie">compiled trie to load the image into</param>
+/// <param name="imagePath">location of the image file</param>
+/// <param name="sourceFingerprint">fingerprint of the text dictionary the image must be built from</param>
+/// <returns>error code</returns>
+ErrorCode DictionaryImage::read(CompiledTrie& trie, const string& imagePath, uint64_t sourceFingerprint)
+{
+    auto image{ make_unique<MappedFile>() };
+    const auto errorCode{ image->open(imagePath) };
+    if (errorCode != ErrorCode::SUCCESS) return errorCode;
+
+    if (image->size() < sizeof(Header)) return ErrorCode::IMAGE_INVALID;
+
+    Header header{};
+    memcpy(&header, image->data(), sizeof(header));
+
+    if ((memcmp(header.m_magic, MAGIC, sizeof(MAGIC)) != 0) 
+        || (header.m_version != VERSION) 
+        || (header.m_byteOrder != BYTE_ORDER_MARK) 
+        || (header.m_sourceFingerprint != sourceFingerprint))
+    {
+        return ErrorCode::IMAGE_INVALID;
+    }
+
+    const size_t nodeBytes{ size_t{ header.m_nodeCount } * sizeof(CompiledNode) };
+    const size_t wordOffsetBytes{ size_t{ header.m_nodeCount } * sizeof(uint32_t) };
+    const size_t labelStartBytes{ size_t{ header.m_labelStartCount } * sizeof(uint32_t) };
+    const size_t remainingDepthBytes{ size_t{ header.m_nodeCount } * sizeof(RemainingDepth) };
+    const bool countsValid{ (header.m_nodeCount > 0) 
+        && ((header.m_labelStartCount == 0) || (header.m_labelStartCount == header.m_nodeCount)) 
+        && ((header.m_labelStartCount > 0) || (header.m_labelCount == 0)) };
+
+    if (!countsValid || (image->size() != sizeof(Header) + nodeBytes + wordOffsetBytes + labelStartBytes + header.m_labelCount + remainingDepthBytes))
+    {
+        return ErrorCode::IMAGE_INVALID;
+    }
+
+    const auto payload{ image->data() + sizeof(Header) };
+    if (checksum(payload, image->size() - sizeof(Header), sourceFingerprint) != header.m_payloadChecksum)
+    {
+        return ErrorCode::IMAGE_INVALID;
+    }
+
+    // the image is valid, drop the old records and read from the mapping from now on
+    trie.m_nodes = {};
+    trie.m_labelStarts = {};
+    trie.m_labels = {};
+    trie.m_wordOffsets = {};
+    trie.m_remainingDepths = {};
+
+    trie.m_nodeData = reinterpret_cast<const CompiledNode*>(payload);
+    trie.m_wordOffsetData = reinterpret_cast<const uint32_t*>(payload + nodeBytes);
+    trie.m_labelStartData = reinterpret_cast<const uint32_t*>(payload + nodeBytes + wordOffsetBytes);
+    trie.m_labelData = payload + nodeBytes + wordOffsetBytes + labelStartBytes;
+    trie.m_remainingDepthData = reinterpret_cast<const RemainingDepth*>(payload + nodeBytes + wordOffsetBytes + labelStartBytes + header.m_labelCount);
+    trie.m_nodeCount = header.m_nodeCount;
+    trie.m_labelCount = header.m_labelCount;
+    trie.m_wordCount = header.m_wordCount;
+    trie.m_image = move(image);
+    return ErrorCode::SUCCESS;
+}
@@ -2,8 +2,17 @@
 // Place Holder Copyright Header
 //
 
-#include <algorithm>
+#include <cstring>
 
+/* SSE2 is part of every x64 target. The letter compares are signed, like char
+is by default, so platforms with an unsigned char take the scalar loop. */
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))) \
+    && !defined(__CHAR_UNSIGNED__) && !defined(_CHAR_UNSIGNED)
+#define LETTER_NODE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "CompiledTrie.h"   // countBits(...)
 #include "LetterNode.h"
 
 
@@ -11,62 +20,198 @@
 /// Class constructor
 /// </summary>
 LetterNode::LetterNode() :
-	m_childLetters(),
-	m_isWordValid(false)
+	LetterNode(nullptr)
 {
 	// intentionally blank
 }
 
 
 /// <summary>
-/// Searches a node's m_childLetters vector for the provided char. If the 
+/// Class constructor for a node whose children are stored in an arena.
+/// </summary>
+/// <param name="arena">arena the child block is allocated from, nullptr for the heap</param>
+LetterNode::LetterNode(ChildArena* arena) :
+	m_children(nullptr),
+	m_arena(arena),
+	m_childCount(0),
+	m_childCapacity(0),
+	m_isWordValid(false)
+{
+    // intentionally blank
+}
+
+
+/// <summary>
+/// Class destructor. Gives a heap child block back, arena blocks go with the arena.
+/// </summary>
+LetterNode::~LetterNode()
+{
+    releaseChildren();
+}
+
+
+/// <summary>
+/// Move constructor. The child block is handed over as it is.
+/// </summary>
+/// <param name="other">node to take the children from, left without any</param>
+LetterNode::LetterNode(LetterNode&& other) noexcept :
+    LetterNode(other.m_arena)
+{
+    *this = move(other);
+}
+
+
+/// <summary>
+/// Move assignment. See the move constructor.
+/// </summary>
+/// <param name="other">node to take the children from, left without any</param>
+/// <returns>this node</returns>
+LetterNode& LetterNode::operator=(LetterNode&& other) noexcept
+{
+    if (this == &other) return *this; // early return
+
+    releaseChildren();
+    m_children = other.m_children;
+    m_arena = other.m_arena;
+    m_childCount = other.m_childCount;
+    m_childCapacity = other.m_childCapacity;
+    m_isWordValid = other.m_isWordValid;
+
+    other.m_children = nullptr;
+    other.m_childCount = 0;
+    other.m_childCapacity = 0;
+    return *this;
+}
+
+
+/// <summary>
+/// Searches a node's child letters for the provided char. If the 
 /// char was found, return the LetterNode*; otherwise, return nullptr.
 /// </summary>
 /// <param name="letter">Char letter that is being searched for</param>
 /// <returns>pointer to the node where the char exists, nullptr if it doesn't</returns>
-LetterNode* LetterNode::findChild(char letter)
+LetterNode* LetterNode::findChild(char letter) const
 {
-    /* Same lower bound binary search used in the insertChild(...) function below. */
-    auto it{ lower_bound(m_childLetters.begin(), m_childLetters.end(), letter,
-        [](const auto& pair, char value) { return pair.first < value; }) };
+    /* Same lower bound search used in the insertChild(...) function below. */
+    const auto position{ childPosition(letter) };
 
     //               !! ORDER OF CONDITIONAL CHECKS MATTERS !!
     //                (for the same reason as insertChild(...)
-    return ((it != m_childLetters.end() && it->first == letter) ? it->second : nullptr);
+    return ((position != m_childCount && childLetter(position) == letter) ? m_children[position] : nullptr);
 }
 
 
 /// <summary>
-/// Inserts the provided char and LetterNode* into the vector of children while
-/// keeping it sorted in ascending order of chars. Duplicate chars (and the node) 
-/// will not be added to the vector.
+/// Inserts the provided char and LetterNode* into the children while keeping
+/// them sorted in ascending order of chars. Duplicate chars (and the node) 
+/// will not be added.
 /// </summary>
 /// <param name="letter">char letter we want to insert</param>
-/// <param name="child">the LetterNode* that accompanies the char in a pair</param>
+/// <param name="child">the LetterNode* that goes with the char</param>
 void LetterNode::insertChild(char letter, LetterNode* child)
 {
-    /* Use lower bound to run a binary search on the sorted vector. Vector remains
-    sorted by override the implicit std::less{} with a lambda that is compatible
-    with this vector of pairs.
-
-    The iterator will point to the position where the letter can be inserted while
-    preserving the sorted order.*/
-    auto it{ lower_bound(m_childLetters.begin(), m_childLetters.end(), letter,
-        [](const auto& pair, char value) { return pair.first < value; }) };
+    /* The position is where the letter can be inserted while preserving the
+    sorted order (see childPosition(...)). */
+    const auto position{ childPosition(letter) };
 
     /*                !! ORDER OF CONDITIONAL CHECKS MATTERS !!
 
-    it == m_childLetters.end() : if the char we are searching for would be the highest
-        value char in the vector and isn't already present, then the iterator will
-        point to the end of the vector.
+    position == m_childCount : if the char we are searching for would be the
+        highest value char and isn't already present, then the position is
+        past the last child.
 
         -OR-
 
-    it->first != letter : if the iterator that was returned doesn't already point to
-        a pair that includes the char - this prevents duplicate chars from being added.*/
-    if (it == m_childLetters.end() || it->first != letter)
+    childLetter(position) != letter : if the position doesn't already hold the
+        char - this prevents duplicate chars from being added.*/
+    if (position == m_childCount || childLetter(position) != letter)
     {
-        m_childLetters.insert(it, { letter, child });
+        if (m_childCount == m_childCapacity) growChildren();
+
+        // shift the children after the position up by one, pointers and letters alike
+        auto letters{ reinterpret_cast<char*>(m_children + m_childCapacity) };
+        const auto after{ m_childCount - position };
+        memmove(m_children + position + 1, m_children + position, after * sizeof(LetterNode*));
+        memmove(letters + position + 1, letters + position, after);
+
+        m_children[position] = child;
+        letters[position] = letter;
+        m_childCount++;
     }
 }
 
+
+/// <summary>
+/// Lower bound of a letter in the sorted child letters: the number of child
+/// letters that come before it. With SSE2 and at least 16 children, 16 letters
+/// are compared to it at once. They are sorted, so the letters before it are the
+/// low bits of the mask and their count is its position. The last block is
+/// loaded from the end of the letters, overlapping the one before it, so no
+/// letter is ever compared one at a time. Fewer children than that (every node
+/// below the first levels) are scanned one at a time, which is just as fast on
+/// a handful of contiguous bytes.
+/// </summary>
+/// <param name="letter">letter to look for</param>
+/// <returns>position of the letter, or where it would be inserted</returns>
+size_t LetterNode::childPosition(char letter) const
+{
+    const auto letters{ childLetters() };
+    const size_t count{ m_childCount };
+
+#ifdef LETTER_NODE_SSE2
+    if (count >= 16)
+    {
+        const auto wanted{ _mm_set1_epi8(letter) };
+        const auto lettersBefore = [&](size_t first) {
+            const auto block{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(letters + first)) };
+            return countBits(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(block, wanted))));
+        };
+
+        size_t first{ 0 };
+        for (; first + 16 < count; first += 16)
+        {
+            const auto before{ lettersBefore(first) };
+            if (before < 16) return first + before; // early return, the letter is in this block
+        }
+        return count - 16 + lettersBefore(count - 16);
+    }
+#endif
+
+    size_t position{ 0 };
+    while ((position < count) && (letters[position] < letter)) position++;
+    return position;
+}
+
+
+/// <summary>
+/// Moves the children to a block twice the size (a single child to start with).
+/// A heap block is freed, an arena block is left behind in the arena.
+/// </summary>
+void LetterNode::growChildren()
+{
+    const size_t capacity{ (m_childCapacity == 0) ? size_t{ 1 } : size_t{ m_childCapacity } * 2 };
+    ArenaAllocator<LetterNode*> allocator(m_arena);
+    auto children{ allocator.allocate(capacity + (capacity + sizeof(LetterNode*) - 1) / sizeof(LetterNode*)) };
+
+    if (m_childCount > 0)
+    {
+        memcpy(children, m_children, m_childCount * sizeof(LetterNode*));
+        memcpy(children + capacity, childLetters(), m_childCount);
+    }
+
+    releaseChildren();
+    m_children = children;
+    m_childCapacity = static_cast<uint16_t>(capacity);
+}
+
+
+/// <summary>
+/// Gives the child block back (see ArenaAllocator), without touching the count.
+/// </summary>
+void LetterNode::releaseChildren()
+{
+    if (m_children == nullptr) return; // early return, nothing to give back
+
+    ArenaAllocator<LetterNode*>(m_arena).deallocate(m_children, 0);
+    m_children = nullptr;
+}
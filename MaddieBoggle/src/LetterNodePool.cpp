@@ -2,50 +2,142 @@
 // Place Holder Copyright Header
 //
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 #include "LetterNodePool.h"
 
 
 /// <summary>
-/// Class constructor. Provided size must be greater than 0.
+/// Class constructor. No memory is allocated until the first node is.
 /// </summary>
-/// <param name="poolSize">number of node objects to reserve on the heap</param>
-LetterNodePool::LetterNodePool(size_t poolSize)
+/// <param name="nodeLimit">optional most nodes the pool may ever create, unlimited by default</param>
+/// <param name="childArena">optional arena for the children of every node, must outlive the pool</param>
+LetterNodePool::LetterNodePool(size_t nodeLimit, ChildArena* childArena) :
+    m_chunks(),
+    m_chunkSizes(),
+    m_capacity(0),
+    m_nodesCreated(0),
+    m_currentChunk(0),
+    m_currentChunkStart(0),
+    m_freeNodes(),
+    m_nodeLimit(nodeLimit),
+    m_childArena(childArena)
 {
-    assert(poolSize > 0);
-    m_pool.reserve(poolSize); // ensures the pool vector doesn't dynamically resize
+    assert(nodeLimit > 0);
+}
 
-    for (size_t i = 0; i < poolSize; ++i)
-    {
-        /* create a node object on the pool and get its reference, then
-        take the newly created reference and add its address to the available
-        nodes list */
-        LetterNode& node{ m_pool.emplace_back() };
-        m_freeNodes.push_back(&node);
-    }
+
+/// <summary>
+/// Class destructor. Gives every chunk back to the heap.
+/// </summary>
+LetterNodePool::~LetterNodePool()
+{
+    release();
 }
 
 
 /// <summary>
-/// Allocates a node by returning the next available address of one.
-/// If there are no more allocatable nodes, return nullptr. Callee is
+/// Move constructor. The chunks are handed over as they are, so every node keeps
+/// its address.
+/// </summary>
+/// <param name="other">pool to take the chunks from, left empty</param>
+LetterNodePool::LetterNodePool(LetterNodePool&& other) noexcept :
+    LetterNodePool(other.m_nodeLimit, other.m_childArena)
+{
+    *this = move(other);
+}
+
+
+/// <summary>
+/// Move assignment. See the move constructor.
+/// </summary>
+/// <param name="other">pool to take the chunks from, left empty</param>
+/// <returns>this pool</returns>
+LetterNodePool& LetterNodePool::operator=(LetterNodePool&& other) noexcept
+{
+    if (this == &other) return *this; // early return
+
+    release();
+    m_chunks = move(other.m_chunks);
+    m_chunkSizes = move(other.m_chunkSizes);
+    m_capacity = other.m_capacity;
+    m_nodesCreated = other.m_nodesCreated;
+    m_currentChunk = other.m_currentChunk;
+    m_currentChunkStart = other.m_currentChunkStart;
+    m_freeNodes = move(other.m_freeNodes);
+    m_nodeLimit = other.m_nodeLimit;
+    m_childArena = other.m_childArena;
+
+    other.m_chunks.clear();
+    other.m_chunkSizes.clear();
+    other.m_capacity = 0;
+    other.m_nodesCreated = 0;
+    other.m_currentChunk = 0;
+    other.m_currentChunkStart = 0;
+    other.m_freeNodes.clear();
+    return *this;
+}
+
+
+/// <summary>
+/// Allocates a node, reusing a deallocated one if there is any.
+/// If the node limit is reached, return nullptr. Callee is
 /// responsible for handling.
-/// Allocated node is removed from the free pool.
 /// </summary>
 /// <returns>Pointer to available node, otherwise nullptr</returns>
 LetterNode* LetterNodePool::allocate()
 {
-    if (m_freeNodes.empty())
+    if (!m_freeNodes.empty())
+    {
+        auto node{ m_freeNodes.back() };    // get a free node address
+        m_freeNodes.pop_back();             // remove acquired node address from the free nodes
+        return node;
+    }
+
+    if (m_nodesCreated >= m_nodeLimit)
     {
         cerr << "Out of allocation space! Dictionary too large.\n";
         return nullptr;
     }
 
-    auto node{ m_freeNodes.back() };    // get a free node address
-    m_freeNodes.pop_back();             // remove acquired node address from the free nodes
-    return node;
+    return createNode();
+}
+
+
+/// <summary>
+/// Allocates a whole region of nodes at once, so they can be handed out by a thread
+/// that doesn't own the pool (see Dictionary::importDictionary). Either every node
+/// is allocated or none is.
+/// </summary>
+/// <param name="count">number of nodes to allocate</param>
+/// <param name="region">receives the allocated node addresses, replacing its content</param>
+/// <returns>true if the nodes were allocated, false if they would go over the node limit</returns>
+bool LetterNodePool::allocateRegion(size_t count, vector<LetterNode*>& region)
+{
+    const auto reused{ min(count, m_freeNodes.size()) };
+    const auto created{ count - reused };
+    if (created > m_nodeLimit - m_nodesCreated)
+    {
+        cerr << "Out of allocation space! Dictionary too large.\n";
+        return false;
+    }
+
+    const auto first{ m_freeNodes.end() - static_cast<ptrdiff_t>(reused) };
+    region.assign(first, m_freeNodes.end());
+    m_freeNodes.erase(first, m_freeNodes.end());
+
+    for (size_t i = 0; i < created; i++)
+    {
+        region.push_back(createNode());
+    }
+    return true;
 }
 
 
@@ -57,3 +149,131 @@ void LetterNodePool::deallocate(LetterNode* node)
 {
     m_freeNodes.push_back(node);
 }
+
+
+/// <summary>
+/// Allocates the chunks for the provided number of nodes ahead of time, so the
+/// pool doesn't grow one chunk at a time while a dictionary is imported. Less than
+/// a huge page of missing nodes gets one chunk of exactly that size, more gets
+/// huge pages. Never goes over the node limit, and never shrinks the pool.
+/// </summary>
+/// <param name="nodeCount">number of nodes expected to be created in total</param>
+void LetterNodePool::reserve(size_t nodeCount)
+{
+    const auto target{ min(nodeCount, m_nodeLimit) };
+    if (capacity() >= target) return; // early return, already reserved
+
+    if (target - capacity() < CHUNK_SIZE)
+    {
+        addChunk(target - capacity());
+        return;
+    }
+
+    while (capacity() < target)
+    {
+        addChunk(CHUNK_SIZE);
+    }
+}
+
+
+/// <summary>
+/// Gives all the chunks (and every node in them) back to the heap. Any previously
+/// allocated nodes are invalid afterwards. The pool can still be used, and grows
+/// again from nothing.
+/// </summary>
+void LetterNodePool::release()
+{
+    auto nodesLeft{ m_nodesCreated };
+    for (size_t i = 0; i < m_chunks.size(); i++)
+    {
+        const auto created{ min(nodesLeft, m_chunkSizes[i]) };
+        for (size_t j = 0; j < created; j++)
+        {
+            m_chunks[i][j].~LetterNode();
+        }
+        nodesLeft -= created;
+
+        if (m_chunkSizes[i] == CHUNK_SIZE) ::operator delete(m_chunks[i], align_val_t{ CHUNK_BYTES });
+        else ::operator delete(m_chunks[i]);
+    }
+
+    vector<LetterNode*>().swap(m_chunks);
+    vector<size_t>().swap(m_chunkSizes);
+    vector<LetterNode*>().swap(m_freeNodes);
+    m_capacity = 0;
+    m_nodesCreated = 0;
+    m_currentChunk = 0;
+    m_currentChunkStart = 0;
+}
+
+
+/// <summary>
+/// Rough number of trie nodes a text dictionary of the provided size needs. Word
+/// lists share most of their prefixes, and measured ones come out at 0.4 to 0.47
+/// nodes per byte, so half a node per byte covers them without going far over.
+/// </summary>
+/// <param name="fileBytes">size of the dictionary file in bytes</param>
+/// <returns>expected node count, including the root</returns>
+size_t LetterNodePool::estimateNodeCount(size_t fileBytes)
+{
+    return (fileBytes / 2) + 1;
+}
+
+
+/// <summary>
+/// Constructs the next node in the chunks, adding a chunk if the last one is full.
+/// Every new chunk is as large as the pool so far, from FIRST_CHUNK_SIZE up to
+/// a huge page, and never holds more nodes than the limit leaves.
+/// The caller has checked the node limit.
+/// </summary>
+/// <returns>the new node</returns>
+LetterNode* LetterNodePool::createNode()
+{
+    assert(m_nodesCreated < m_nodeLimit);
+    if (m_nodesCreated == capacity())
+    {
+        const auto growth{ min(max(capacity(), FIRST_CHUNK_SIZE), CHUNK_SIZE) };
+        addChunk(min(growth, m_nodeLimit - m_nodesCreated));
+    }
+
+    // move on once the current chunk is full, reserved chunks can be waiting after it
+    while (m_nodesCreated - m_currentChunkStart == m_chunkSizes[m_currentChunk])
+    {
+        m_currentChunkStart += m_chunkSizes[m_currentChunk];
+        m_currentChunk++;
+    }
+
+    auto memory{ &m_chunks[m_currentChunk][m_nodesCreated - m_currentChunkStart] };
+    m_nodesCreated++;
+    return new (memory) LetterNode(m_childArena);
+}
+
+
+/// <summary>
+/// Allocates one more chunk. A chunk of CHUNK_SIZE nodes is aligned to its size so
+/// it can sit in a single huge page, and on Linux, transparent huge pages are asked
+/// for explicitly, since they are often only used for memory that opts in. Smaller
+/// chunks come from the heap as they are. The nodes are not constructed yet.
+/// </summary>
+/// <param name="nodeCount">number of nodes in the chunk, at most CHUNK_SIZE</param>
+void LetterNodePool::addChunk(size_t nodeCount)
+{
+    assert((nodeCount > 0) && (nodeCount <= CHUNK_SIZE));
+
+    void* memory{ nullptr };
+    if (nodeCount == CHUNK_SIZE)
+    {
+        memory = ::operator new(CHUNK_BYTES, align_val_t{ CHUNK_BYTES });
+#ifdef __linux__
+        madvise(memory, CHUNK_BYTES, MADV_HUGEPAGE); // only a hint, failure is harmless
+#endif
+    }
+    else
+    {
+        memory = ::operator new(nodeCount * sizeof(LetterNode));
+    }
+
+    m_chunks.push_back(static_cast<LetterNode*>(memory));
+    m_chunkSizes.push_back(nodeCount);
+    m_capacity += nodeCount;
+}
@@ -0,0 +1,210 @@
+//
+// Place Holder Copyright Header
+//
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+
+/// <summary>
+/// Reads everything left in an open file into the buffer, for files that can't be
+/// mapped. Reads until the end of the file, since the size isn't known up front.
+/// </summary>
+/// <param name="file">open file to read from</param>
+/// <param name="buffer">receives the content of the file</param>
+/// <returns>true if the whole file was read, false on a read error</returns>
+#ifdef _WIN32
+static bool readWholeFile(HANDLE file, vector<char>& buffer)
+#else
+static bool readWholeFile(int file, vector<char>& buffer)
+#endif
+{
+    constexpr size_t READ_SIZE{ 64 * 1024 };
+
+    buffer.clear();
+    while (true)
+    {
+        const auto used{ buffer.size() };
+        buffer.resize(used + READ_SIZE);
+
+#ifdef _WIN32
+        DWORD bytesRead{ 0 };
+        const bool success{ ReadFile(file, buffer.data() + used, static_cast<DWORD>(READ_SIZE), &bytesRead, nullptr) != FALSE };
+        if (!success && (GetLastError() == ERROR_BROKEN_PIPE)) bytesRead = 0; // the writing end of a pipe was closed
+        else if (!success)
+        {
+            buffer.clear();
+            return false;
+        }
+#else
+        const auto bytesRead{ ::read(file, buffer.data() + used, READ_SIZE) };
+        if ((bytesRead < 0) && (errno == EINTR))
+        {
+            buffer.resize(used);
+            continue;
+        }
+        if (bytesRead < 0)
+        {
+            buffer.clear();
+            return false;
+        }
+#endif
+
+        buffer.resize(used + static_cast<size_t>(bytesRead));
+        if (bytesRead == 0) return true;
+    }
+}
+
+
+/// <summary>
+/// Class constructor. Nothing is mapped until open(...) is called.
+/// </summary>
+MappedFile::MappedFile() :
+    m_data(nullptr),
+    m_size(0),
+    m_buffer()
+#ifdef _WIN32
+    , m_file(INVALID_HANDLE_VALUE),
+    m_mapping(nullptr)
+#endif
+{
+    // intentionally blank
+}
+
+
+/// <summary>
+/// Class destructor. Releases the mapping, if any.
+/// </summary>
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+/// <summary>
+/// Maps the provided file read-only into memory. Any file that was previously
+/// mapped by this object is released first. An empty file is opened successfully
+/// but maps nothing, so data() stays nullptr.
+///
+/// Only regular files are mapped. Anything else (a pipe, a FIFO, a terminal), and
+/// a regular file that reports a size of 0 but can still have content (like the
+/// files in /proc), is read into a buffer instead.
+/// 
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 1 --> unable to open file
+/// 2 --> file opened but could not be mapped or read
+/// </summary>
+/// <param name="filepath">location of the file to map</param>
+/// <returns>error code</returns>
+ErrorCode MappedFile::open(const string& filepath)
+{
+    close();
+
+#ifdef _WIN32
+    m_file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, 
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) return ErrorCode::FILE_NOT_FOUND;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(m_file, &fileSize))
+    {
+        close();
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+    if ((GetFileType(m_file) != FILE_TYPE_DISK) || (fileSize.QuadPart == 0))
+    {
+        const bool readCompletely{ readWholeFile(m_file, m_buffer) };
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+        if (!readCompletely) return ErrorCode::UNKNOWN_FILE_ERR;
+
+        m_data = m_buffer.empty() ? nullptr : m_buffer.data();
+        m_size = m_buffer.size();
+        return ErrorCode::SUCCESS;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr)
+    {
+        close();
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+
+    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        close();
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int file{ ::open(filepath.c_str(), O_RDONLY) };
+    if (file < 0) return ErrorCode::FILE_NOT_FOUND;
+
+    struct stat fileStat{};
+    if (fstat(file, &fileStat) != 0)
+    {
+        ::close(file);
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+
+    if (!S_ISREG(fileStat.st_mode) || (fileStat.st_size == 0))
+    {
+        const bool readCompletely{ readWholeFile(file, m_buffer) };
+        ::close(file);
+        if (!readCompletely) return ErrorCode::UNKNOWN_FILE_ERR;
+
+        m_data = m_buffer.empty() ? nullptr : m_buffer.data();
+        m_size = m_buffer.size();
+        return ErrorCode::SUCCESS;
+    }
+
+    void* mapped{ mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0) };
+    if (mapped == MAP_FAILED)
+    {
+        ::close(file);
+        return ErrorCode::UNKNOWN_FILE_ERR;
+    }
+    m_data = static_cast<const char*>(mapped);
+    m_size = static_cast<size_t>(fileStat.st_size);
+
+    ::close(file); // the mapping keeps its own reference to the file
+#endif
+
+    return ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Releases the mapping (or the buffer). Pointers previously returned by data() are
+/// no longer valid.
+/// </summary>
+void MappedFile::close()
+{
+    const bool mapped{ (m_data != nullptr) && m_buffer.empty() };
+    vector<char>().swap(m_buffer);
+
+#ifdef _WIN32
+    if (mapped) UnmapViewOfFile(m_data);
+    if (m_mapping != nullptr) CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file = INVALID_HANDLE_VALUE;
+#else
+    if (mapped) munmap(const_cast<char*>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
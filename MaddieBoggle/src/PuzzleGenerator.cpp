@@ -0,0 +1,233 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <fstream>
+#include <numeric>
+#include <set>
+
+#include "PuzzleGenerator.h"
+
+
+// the 16 dice of classic Boggle, six faces each
+static const vector<const char*> s_classicDice{
+    "AAEEGN", "ABBJOO", "ACHOPS", "AFFKPS", "AOOTTW", "CIMOTU", "DEILRX", "DELRVY",
+    "DISTTY", "EEGHNW", "EEINSU", "EHRTVW", "EIOSST", "ELRTTY", "HIMNUQ", "HLNNRZ" };
+
+// the 25 dice of Big Boggle, six faces each
+static const vector<const char*> s_bigDice{
+    "AAAFRS", "AAEEEE", "AAFIRS", "ADENNN", "AEEEEM", "AEEGMU", "AEGMNN", "AFIRSY",
+    "BJKQXZ", "CCENST", "CEIILT", "CEILPT", "CEIPST", "DDHNOT", "DHHLOR", "DHLNOR",
+    "DHLNOR", "EIIITT", "EMOTTT", "ENSSSU", "FIPRSY", "GORRVW", "IPRRRY", "NOOTUW", "OOOTTU" };
+
+// relative frequency of 'a'-'z' in English text, in tenths of a percent
+static const double s_letterWeights[26]{
+    82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24,
+    67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1 };
+
+
+/// <summary>
+/// Class constructor.
+/// </summary>
+/// <param name="seed">seed of the random engine, the same seed makes the same puzzles</param>
+PuzzleGenerator::PuzzleGenerator(uint32_t seed) :
+    m_random(seed),
+    m_bag()
+{
+    // intentionally blank
+}
+
+
+/// <summary>
+/// Generates a rectangular board rolled with Boggle dice.
+/// </summary>
+/// <param name="rows">number of rows</param>
+/// <param name="columns">number of letters in every row</param>
+/// <returns>generated board</returns>
+BoggleBoard PuzzleGenerator::generateBoard(size_t rows, size_t columns)
+{
+    BoggleBoard board(rows, vector<char>(columns));
+    fillBoard(board);
+    return board;
+}
+
+
+/// <summary>
+/// Generates a board whose rows have different lengths, like the ones importBoard
+/// accepts. Every row length is drawn between the provided bounds.
+/// </summary>
+/// <param name="rows">number of rows</param>
+/// <param name="minColumns">fewest letters in a row, at least 1</param>
+/// <param name="maxColumns">most letters in a row, at least minColumns</param>
+/// <returns>generated board</returns>
+BoggleBoard PuzzleGenerator::generateRaggedBoard(size_t rows, size_t minColumns, size_t maxColumns)
+{
+    assert((minColumns > 0) && (minColumns <= maxColumns));
+
+    BoggleBoard board(rows);
+    for (auto& row : board)
+    {
+        row.resize(minColumns + pick(maxColumns - minColumns + 1));
+    }
+    fillBoard(board);
+    return board;
+}
+
+
+/// <summary>
+/// Generates a dictionary of distinct random words.
+/// </summary>
+/// <param name="wordCount">number of words to generate</param>
+/// <param name="lengthWeights">relative weight of every word length, indexed by the length</param>
+/// <returns>sorted words, fewer than wordCount if the lengths don't allow that many distinct words</returns>
+vector<string> PuzzleGenerator::generateWords(size_t wordCount, const vector<double>& lengthWeights)
+{
+    const auto totalLengthWeight{ accumulate(lengthWeights.begin(), lengthWeights.end(), 0.0) };
+    const auto totalLetterWeight{ accumulate(begin(s_letterWeights), end(s_letterWeights), 0.0) };
+    const vector<double> letterWeights(begin(s_letterWeights), end(s_letterWeights));
+    assert(totalLengthWeight > 0.0);
+
+    set<string> words{};
+    const auto maxAttempts{ wordCount * 10 }; // only reached when there aren't enough distinct words
+    for (size_t attempt = 0; (attempt < maxAttempts) && (words.size() < wordCount); attempt++)
+    {
+        string word(pickWeighted(lengthWeights, totalLengthWeight), ' ');
+        for (auto& letter : word)
+        {
+            letter = static_cast<char>('a' + pickWeighted(letterWeights, totalLetterWeight));
+        }
+        if (!word.empty()) words.insert(move(word));
+    }
+    return vector<string>(words.begin(), words.end());
+}
+
+
+/// <summary>
+/// Lengths of the words in a typical English word list: mostly 5 to 9 letters,
+/// tailing off towards 15. Nothing shorter than 3 letters, which the dictionary
+/// would skip anyway.
+/// </summary>
+/// <returns>weights indexed by word length</returns>
+vector<double> PuzzleGenerator::defaultLengthWeights()
+{
+    return { 0, 0, 0, 4, 9, 13, 15, 15, 14, 11, 8, 5, 3, 2, 1, 0.5 };
+}
+
+
+/// <summary>
+/// Writes a board in the format importBoard reads: one row per line, upper case
+/// letters separated by spaces.
+///
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 1 --> unable to open the file for writing
+/// </summary>
+/// <param name="board">board to write</param>
+/// <param name="filepath">location of the board file, replaced if it exists</param>
+/// <returns>error code</returns>
+ErrorCode PuzzleGenerator::writeBoard(const BoggleBoard& board, const string& filepath)
+{
+    ofstream file(filepath);
+    if (!file) return ErrorCode::FILE_NOT_FOUND;
+
+    for (const auto& row : board)
+    {
+        for (size_t i = 0; i < row.size(); i++)
+        {
+            file << ((i == 0) ? "" : " ") << static_cast<char>(toupper(row[i]));
+        }
+        file << "\n";
+    }
+    return ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Writes a dictionary file, one word per line.
+///
+/// The following error codes can be returned:
+/// 0 --> success, no error
+/// 1 --> unable to open the file for writing
+/// </summary>
+/// <param name="words">words to write</param>
+/// <param name="filepath">location of the dictionary file, replaced if it exists</param>
+/// <returns>error code</returns>
+ErrorCode PuzzleGenerator::writeWords(const vector<string>& words, const string& filepath)
+{
+    ofstream file(filepath);
+    if (!file) return ErrorCode::FILE_NOT_FOUND;
+
+    for (const auto& word : words) file << word << "\n";
+    return ErrorCode::SUCCESS;
+}
+
+
+/// <summary>
+/// Picks a number below count. The modulo bias is far too small to matter for
+/// counts this small.
+/// </summary>
+/// <param name="count">number of choices, at least 1</param>
+/// <returns>number from 0 to count - 1</returns>
+size_t PuzzleGenerator::pick(size_t count)
+{
+    assert(count > 0);
+    return static_cast<size_t>(m_random() % count);
+}
+
+
+/// <summary>
+/// Picks an index with a probability proportional to its weight.
+/// </summary>
+/// <param name="weights">relative weights, not all 0</param>
+/// <param name="totalWeight">sum of the weights</param>
+/// <returns>index into weights</returns>
+size_t PuzzleGenerator::pickWeighted(const vector<double>& weights, double totalWeight)
+{
+    auto remaining{ totalWeight * (static_cast<double>(m_random()) / (static_cast<double>(mt19937::max()) + 1.0)) };
+    for (size_t i = 0; i < weights.size(); i++)
+    {
+        if (remaining < weights[i]) return i;
+        remaining -= weights[i];
+    }
+
+    // rounding can leave a sliver past the last weight, which belongs to the last non-zero one
+    size_t last{ weights.size() - 1 };
+    while ((last > 0) && (weights[last] <= 0.0)) last--;
+    return last;
+}
+
+
+/// <summary>
+/// Rolls a letter for every cell of a board that already has its shape (see the
+/// class description). Every board starts with a full bag.
+/// </summary>
+/// <param name="board">board to fill, row lengths already set</param>
+void PuzzleGenerator::fillBoard(BoggleBoard& board)
+{
+    size_t cells{ 0 };
+    for (const auto& row : board) cells += row.size();
+    const auto& dice{ (cells <= CLASSIC_CELLS) ? s_classicDice : s_bigDice };
+
+    m_bag.clear();
+    for (auto& row : board)
+    {
+        for (auto& letter : row)
+        {
+            if (m_bag.empty())
+            {
+                // shaken with a Fisher-Yates shuffle, std::shuffle differs between platforms
+                m_bag = dice;
+                for (size_t i = m_bag.size() - 1; i > 0; i--)
+                {
+                    swap(m_bag[i], m_bag[pick(i + 1)]);
+                }
+            }
+
+            letter = static_cast<char>(tolower(m_bag.back()[pick(6)]));
+            m_bag.pop_back();
+        }
+    }
+}
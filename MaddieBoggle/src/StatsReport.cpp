@@ -0,0 +1,177 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <iomanip>
+
+#include "StatsReport.h"
+
+
+/// <summary>
+/// Class constructor.
+/// </summary>
+StatsReport::StatsReport() :
+    m_phases(),
+    m_counters(),
+    m_workers(),
+    m_currentPhase(),
+    m_phaseStart()
+{
+    // intentionally blank
+}
+
+
+/// <summary>
+/// Starts timing a phase, ending the current one first.
+/// </summary>
+/// <param name="name">name of the phase</param>
+void StatsReport::startPhase(const string& name)
+{
+    endPhase();
+    m_currentPhase = name;
+    m_phaseStart = chrono::steady_clock::now();
+}
+
+
+/// <summary>
+/// Ends the current phase and records its time. Does nothing if no phase is
+/// being timed.
+/// </summary>
+void StatsReport::endPhase()
+{
+    if (m_currentPhase.empty()) return; // early return, nothing to end
+
+    const auto milliseconds{ chrono::duration<double, milli>(chrono::steady_clock::now() - m_phaseStart).count() };
+    m_phases.push_back({ m_currentPhase, milliseconds });
+    m_currentPhase.clear();
+}
+
+
+/// <summary>
+/// Adds a named counter to the report.
+/// </summary>
+/// <param name="name">name of the counter</param>
+/// <param name="value">value of the counter</param>
+void StatsReport::addCounter(const string& name, uint64_t value)
+{
+    m_counters.push_back({ name, value });
+}
+
+
+/// <summary>
+/// Sets the thread pool worker stats of the report, see ThreadPool::getWorkerStats().
+/// </summary>
+/// <param name="workers">one entry per worker</param>
+void StatsReport::setWorkers(const vector<WorkerStats>& workers)
+{
+    m_workers = workers;
+}
+
+
+/// <summary>
+/// Writes the ended phases, the counters and the worker stats. A phase still
+/// being timed is left out.
+/// </summary>
+/// <param name="output">stream to write the report to</param>
+/// <param name="format">format of the report</param>
+void StatsReport::write(ostream& output, StatsFormat format) const
+{
+    const auto flags{ output.flags() };
+    const auto precision{ output.precision() };
+    output << fixed << setprecision(3);
+
+    switch (format)
+    {
+    case StatsFormat::TEXT:     writeText(output); break;
+    case StatsFormat::JSON:     writeJson(output); break;
+    }
+
+    output.flags(flags);
+    output.precision(precision);
+}
+
+
+/// <summary>
+/// Mean time the tasks of a worker spent queued before the worker took them.
+/// The total adds up every task queued at once, so it mostly grows with the
+/// number of tasks, the mean is the one to compare.
+/// </summary>
+/// <param name="worker">stats of the worker</param>
+/// <returns>mean queue wait in milliseconds, 0 if the worker ran no task</returns>
+static double meanQueueWait(const WorkerStats& worker)
+{
+    if (worker.m_tasksRun == 0) return 0.0;
+    return worker.m_queueWaitMilliseconds / static_cast<double>(worker.m_tasksRun);
+}
+
+
+/// <summary>
+/// Writes the report as three tables: phases with their total, counters, and
+/// one line per worker with its mean queue wait.
+/// </summary>
+/// <param name="output">stream to write to</param>
+void StatsReport::writeText(ostream& output) const
+{
+    double totalMilliseconds{ 0.0 };
+    output << left << setw(28) << "phase" << right << setw(14) << "ms" << "\n";
+    for (const auto& phase : m_phases)
+    {
+        output << left << setw(28) << phase.first << right << setw(14) << phase.second << "\n";
+        totalMilliseconds += phase.second;
+    }
+    output << left << setw(28) << "total" << right << setw(14) << totalMilliseconds << "\n";
+
+    if (!m_counters.empty())
+    {
+        output << "\n" << left << setw(28) << "counter" << right << setw(14) << "value" << "\n";
+        for (const auto& counter : m_counters)
+        {
+            output << left << setw(28) << counter.first << right << setw(14) << counter.second << "\n";
+        }
+    }
+
+    if (!m_workers.empty())
+    {
+        output << "\n" << left << setw(8) << "worker" << right << setw(10) << "tasks"
+            << setw(14) << "busy ms" << setw(16) << "mean wait ms" << "\n";
+        for (size_t i = 0; i < m_workers.size(); i++)
+        {
+            const auto& worker{ m_workers[i] };
+            output << left << setw(8) << i << right << setw(10) << worker.m_tasksRun
+                << setw(14) << worker.m_busyMilliseconds << setw(16) << meanQueueWait(worker) << "\n";
+        }
+    }
+}
+
+
+/// <summary>
+/// Writes the report as a JSON object with the phases and counters as objects
+/// keyed by name, and the workers as an array in worker index order. Workers
+/// have both their total and their mean queue wait.
+/// </summary>
+/// <param name="output">stream to write to</param>
+void StatsReport::writeJson(ostream& output) const
+{
+    output << "{\n  \"phases_ms\": {";
+    for (size_t i = 0; i < m_phases.size(); i++)
+    {
+        output << ((i == 0) ? " " : ", ") << "\"" << m_phases[i].first << "\": " << m_phases[i].second;
+    }
+
+    output << " },\n  \"counters\": {";
+    for (size_t i = 0; i < m_counters.size(); i++)
+    {
+        output << ((i == 0) ? " " : ", ") << "\"" << m_counters[i].first << "\": " << m_counters[i].second;
+    }
+
+    output << " },\n  \"workers\": [";
+    for (size_t i = 0; i < m_workers.size(); i++)
+    {
+        const auto& worker{ m_workers[i] };
+        output << ((i == 0) ? "\n" : ",\n")
+            << "    { \"tasks\": " << worker.m_tasksRun << ", \"busy_ms\": " << worker.m_busyMilliseconds
+            << ", \"queue_wait_ms\": " << worker.m_queueWaitMilliseconds
+            << ", \"mean_queue_wait_ms\": " << meanQueueWait(worker) << " }";
+    }
+    output << (m_workers.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
@@ -15,33 +15,65 @@
 using namespace std;
 
 
+// index of the worker running on this thread, see workerIndex()
+static thread_local size_t s_workerIndex{ ThreadPool::NOT_A_WORKER };
+
+// pool the worker running on this thread belongs to, nullptr outside of any pool
+static thread_local const ThreadPool* s_workerPool{ nullptr };
+
+
 /// <summary>
 /// Class constructor that initializes the thread pool. The size of the pool
 /// is based on the provided thread count argument. This argument is optional.
 /// If no arg is provided, it will default to the "hardware optimal" quantity
-/// as defined by thread::hardware_concurrency.
+/// as defined by thread::hardware_concurrency. The count is not capped, see
+/// ThreadTuner to find the best one for a dictionary and board.
 /// </summary>
 /// <param name="threadCount">optional param that specifies number of threads to create in the pool</param>
-ThreadPool::ThreadPool(size_t threadCount) :
+/// <param name="scheduling">optional param that specifies how tasks are handed to the threads</param>
+ThreadPool::ThreadPool(size_t threadCount, TaskScheduling scheduling) :
+    m_scheduling(scheduling),
     m_pool(),
     m_tasks(),
+    m_workerTasks(),
+    m_workerCounters(),
+    m_collectStats(false),
+    m_queuedTasks(0),
+    m_sleepingWorkers(0),
+    m_nextWorker(0),
+    m_stolenTasks(0),
     m_queueMutex(),
     m_taskPresent(),
     m_complete(),
     m_stop(false),
-    m_activeTasks()
+    m_activeTasks(0)
 {
-    assert(threadCount > 0);
-    threadCount = min(threadCount, static_cast<size_t>(thread::hardware_concurrency()));
+    // hardware_concurrency() is 0 when the core count is unknown
+    threadCount = max(threadCount, size_t{ 1 });
 
     #ifdef _DEBUG
         cout << "Thread pool size: " << threadCount << " threads.\n";
     #endif
 
-    for (auto i = 0; i < threadCount; i++)
+    // the deques must all exist before any worker starts stealing from them
+    if (m_scheduling == TaskScheduling::WORK_STEALING)
+    {
+        m_workerTasks = make_unique<WorkerTasks[]>(threadCount);
+    }
+
+    m_workerCounters = make_unique<WorkerCounters[]>(threadCount);
+    for (size_t i = 0; i < threadCount; i++)
     {
-        m_pool.emplace_back([this](){
-            this->workerThread();
+        m_workerCounters[i].m_tasksRun.store(0);
+        m_workerCounters[i].m_busyNanoseconds.store(0);
+        m_workerCounters[i].m_queueWaitNanoseconds.store(0);
+    }
+
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        m_pool.emplace_back([this, i](){
+            if (m_scheduling == TaskScheduling::WORK_STEALING) this->stealingWorkerThread(i);
+            else this->workerThread(i);
         });
     }
 }
@@ -73,19 +105,51 @@ ThreadPool::~ThreadPool()
 /// Adds the provided task to the queue for the next available thread
 /// to take and execute. Once the task is moved to the queue, a notification
 /// is sent out to a single thread waiting on the condition_variable m_cv.
+/// 
+/// In the work stealing mode, the task goes to the back of the calling worker's
+/// own deque when called from one of this pool's tasks, otherwise the deques
+/// take turns. Sleeping workers are only notified if there are any.
 /// </summary>
 /// <param name="task">Lambda/function to execute</param>
 void ThreadPool::queueTask(function<void()> task)
 {
     ++m_activeTasks; // new task will be available
 
+    QueuedTask queued{ move(task), {} };
+    if (m_collectStats.load(memory_order_relaxed)) queued.m_queuedAt = chrono::steady_clock::now();
+
+    if (m_scheduling == TaskScheduling::SHARED_QUEUE)
     {
-        lock_guard<mutex> lock(m_queueMutex);
-        m_tasks.push(move(task));
+        {
+            lock_guard<mutex> lock(m_queueMutex);
+            m_tasks.push(move(queued));
+            ++m_queuedTasks;
+        }
+
+        // notify a single thread that a task is ready to be processed
+        m_taskPresent.notify_one();
+        return;
+    }
+
+    const size_t target{ (s_workerPool == this) ? s_workerIndex : (m_nextWorker++ % threadCount()) };
+    {
+        auto& worker{ m_workerTasks[target] };
+        lock_guard<mutex> lock(worker.m_mutex);
+
+        // counted before a thief can see (and uncount) it, so the count never drops below 0
+        ++m_queuedTasks;
+        worker.m_tasks.push_back(move(queued));
     }
 
-    // notify a single thread that a task is ready to be processed
-    m_taskPresent.notify_one();
+    /* A worker going to sleep counts itself as sleeping before it checks for
+    queued tasks, and the task is counted before this checks for sleepers, so at
+    least one of the two always sees the other. Taking m_queueMutex makes sure
+    a worker that saw no task is already waiting when it is notified. */
+    if (m_sleepingWorkers.load() > 0)
+    {
+        { lock_guard<mutex> lock(m_queueMutex); }
+        m_taskPresent.notify_one();
+    }
 }
 
 
@@ -99,22 +163,70 @@ void ThreadPool::waitForCompletion()
 }
 
 
+/// <summary>
+/// Number of workers waiting for a task that no queued task is going to keep busy.
+/// Only a hint, the workers can pick up a task right after this returns.
+/// </summary>
+/// <returns>number of idle workers</returns>
+size_t ThreadPool::idleWorkers() const
+{
+    const auto sleeping{ m_sleepingWorkers.load() };
+    const auto queued{ m_queuedTasks.load() };
+    return (sleeping > queued) ? (sleeping - queued) : 0;
+}
+
+
+/// <summary>
+/// Stats of every worker, collected while setCollectStats(true) was in effect.
+/// Tasks still running are not included yet.
+/// </summary>
+/// <returns>one entry per worker, in worker index order</returns>
+vector<WorkerStats> ThreadPool::getWorkerStats() const
+{
+    vector<WorkerStats> stats{};
+    for (size_t i = 0; i < threadCount(); i++)
+    {
+        const auto& counters{ m_workerCounters[i] };
+        stats.push_back({ static_cast<size_t>(counters.m_tasksRun.load()),
+            static_cast<double>(counters.m_busyNanoseconds.load()) / 1e6,
+            static_cast<double>(counters.m_queueWaitNanoseconds.load()) / 1e6 });
+    }
+    return stats;
+}
+
+
+/// <summary>
+/// Index of the calling thread in this thread pool, from 0 to threadCount() - 1.
+/// </summary>
+/// <returns>worker index, NOT_A_WORKER if the caller is not a worker thread of this pool</returns>
+size_t ThreadPool::workerIndex() const
+{
+    return (s_workerPool == this) ? s_workerIndex : NOT_A_WORKER;
+}
+
+
 /// <summary>
 /// Generic worker thread that is available in the overall thread pool. 
 /// Waits until the mutex lock is acquired and there is an active task (or stop
 /// request) to process.
 /// </summary>
-void ThreadPool::workerThread()
+/// <param name="index">index of this worker in the pool</param>
+void ThreadPool::workerThread(size_t index)
 {
+    s_workerIndex = index;
+    s_workerPool = this;
+
     while (true)
     {
-        function<void()> task;
+        QueuedTask task;
 
         // scoping block for mutex locks
         {
             // attempt/wait for access to the tasks queue
             unique_lock<mutex> lock(m_queueMutex);
+            ++m_sleepingWorkers;
             m_taskPresent.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+            --m_sleepingWorkers;
 
             // if signalled to stop and tasks are empty, close this worker
             if(m_stop && m_tasks.empty()) return;
@@ -122,10 +234,129 @@ void ThreadPool::workerThread()
             // acquire the next task and remove it from the queue
             task = move(m_tasks.front());
             m_tasks.pop();
+            --m_queuedTasks;
         }
 
-        task();
+        runTask(index, task);
+    }
+}
+
 
-        if (--m_activeTasks == 0) m_complete.notify_one();
+/// <summary>
+/// Worker thread of the work stealing mode. Runs tasks from its own deque and,
+/// once that is empty, steals from the other workers. Only goes to sleep when
+/// no deque has a task left.
+/// </summary>
+/// <param name="index">index of this worker in the pool, also the index of its deque</param>
+void ThreadPool::stealingWorkerThread(size_t index)
+{
+    s_workerIndex = index;
+    s_workerPool = this;
+
+    while (true)
+    {
+        QueuedTask task;
+
+        if (takeTask(index, task))
+        {
+            runTask(index, task);
+            continue;
+        }
+
+        // nothing left to take, wait for a new task (or stop request)
+        unique_lock<mutex> lock(m_queueMutex);
+        ++m_sleepingWorkers;
+        m_taskPresent.wait(lock, [this] { return m_stop || (m_queuedTasks.load() > 0); });
+        --m_sleepingWorkers;
+
+        // if signalled to stop and tasks are empty, close this worker
+        if (m_stop && (m_queuedTasks.load() == 0)) return;
+    }
+}
+
+
+/// <summary>
+/// Takes the next task for a worker of the work stealing mode: the newest task of
+/// its own deque, otherwise the oldest task of the first other deque that has one.
+/// </summary>
+/// <param name="index">index of the worker looking for a task</param>
+/// <param name="task">set to the task taken</param>
+/// <returns>true if a task was taken, false if every deque was empty</returns>
+bool ThreadPool::takeTask(size_t index, QueuedTask& task)
+{
+    if (m_queuedTasks.load() == 0) return false; // early return, don't lock every deque for nothing
+
+    {
+        auto& own{ m_workerTasks[index] };
+        lock_guard<mutex> lock(own.m_mutex);
+        if (!own.m_tasks.empty())
+        {
+            task = move(own.m_tasks.back());
+            own.m_tasks.pop_back();
+            --m_queuedTasks;
+            return true;
+        }
+    }
+
+    // start with the next worker so the thieves spread out over the deques
+    for (size_t i = 1; i < threadCount(); i++)
+    {
+        auto& victim{ m_workerTasks[(index + i) % threadCount()] };
+        lock_guard<mutex> lock(victim.m_mutex);
+        if (!victim.m_tasks.empty())
+        {
+            task = move(victim.m_tasks.front());
+            victim.m_tasks.pop_front();
+            --m_queuedTasks;
+            ++m_stolenTasks;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/// <summary>
+/// Runs a task taken by a worker and marks it as finished. While stats are
+/// collected, the time the task was queued and the time it ran are added to the
+/// worker's counters. Tasks queued before stats were turned on only count as busy.
+/// </summary>
+/// <param name="index">index of the worker running the task</param>
+/// <param name="task">task to run</param>
+void ThreadPool::runTask(size_t index, QueuedTask& task)
+{
+    if (!m_collectStats.load(memory_order_relaxed))
+    {
+        task.m_task();
+        finishTask();
+        return;
+    }
+
+    const auto start{ chrono::steady_clock::now() };
+    task.m_task();
+    const auto end{ chrono::steady_clock::now() };
+
+    auto& counters{ m_workerCounters[index] };
+    counters.m_tasksRun.fetch_add(1, memory_order_relaxed);
+    counters.m_busyNanoseconds.fetch_add(static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(end - start).count()), memory_order_relaxed);
+    if (task.m_queuedAt != chrono::steady_clock::time_point{})
+    {
+        counters.m_queueWaitNanoseconds.fetch_add(static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(start - task.m_queuedAt).count()), memory_order_relaxed);
+    }
+    finishTask();
+}
+
+
+/// <summary>
+/// Marks a task as finished and wakes up waitForCompletion() callers when it was
+/// the last active one. The mutex is taken before notifying so a caller that just
+/// saw an active task can't miss the notification.
+/// </summary>
+void ThreadPool::finishTask()
+{
+    if (--m_activeTasks == 0)
+    {
+        { lock_guard<mutex> lock(m_queueMutex); }
+        m_complete.notify_all();
     }
 }
@@ -0,0 +1,133 @@
+//
+// Place Holder Copyright Header
+//
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iomanip>
+
+#include "ThreadTuner.h"
+
+
+/// <summary>
+/// Class constructor for the thread tuner. Nothing is measured until tune() is called.
+/// </summary>
+/// <param name="dictionary">shared_ptr to a const, frozen dictionary of valid words</param>
+/// <param name="board">board to solve for the calibration, ideally the size of the boards to come</param>
+/// <param name="scheduling">scheduling of the thread pools</param>
+/// <param name="lengths">optional lengths of the words to find, every length by default</param>
+/// <param name="useBoardTrie">optional, true to search a BoardTrie of the dictionary built for the board</param>
+/// <param name="engine">optional engine to solve the board with, see BoggleSolver</param>
+/// <param name="maxThreads">optional highest thread count to try</param>
+/// <param name="runs">optional number of timed solves per combination</param>
+ThreadTuner::ThreadTuner(shared_ptr<const Dictionary> dictionary, const BoggleBoard& board, TaskScheduling scheduling,
+    WordLengthRange lengths, bool useBoardTrie, SearchEngine engine, size_t maxThreads, size_t runs) :
+    m_dictionary(dictionary),
+    m_board(board),
+    m_scheduling(scheduling),
+    m_lengths(lengths),
+    m_useBoardTrie(useBoardTrie),
+    m_engine(engine),
+    m_maxThreads(max(maxThreads, size_t{ 1 })),    // hardware_concurrency() is 0 when unknown
+    m_runs(max(runs, size_t{ 1 })),
+    m_results(),
+    m_best({ 1, BoggleSolver::MAX_SPLIT_DEPTH, 0.0 })
+{
+    assert(m_dictionary);
+}
+
+
+/// <summary>
+/// Thread counts tried by the tuner: the powers of two below maxThreads, then
+/// maxThreads itself.
+/// </summary>
+/// <param name="maxThreads">highest thread count to try</param>
+/// <returns>thread counts, smallest first</returns>
+vector<size_t> ThreadTuner::threadCandidates(size_t maxThreads)
+{
+    vector<size_t> candidates{};
+    for (size_t threads = 1; threads < maxThreads; threads *= 2)
+    {
+        candidates.push_back(threads);
+    }
+    candidates.push_back(max(maxThreads, size_t{ 1 }));
+    return candidates;
+}
+
+
+/// <summary>
+/// Solves the calibration board with every combination of thread count and split
+/// depth, and picks the combination with the fastest solve. On a tie, the first one
+/// measured wins, which is the one with fewer threads.
+/// </summary>
+/// <returns>fastest combination</returns>
+TuningResult ThreadTuner::tune()
+{
+    m_results.clear();
+
+    for (const auto threadCount : threadCandidates(m_maxThreads))
+    {
+        auto pool{ make_shared<ThreadPool>(threadCount, m_scheduling) };
+        timeSolve(pool, BoggleSolver::MAX_SPLIT_DEPTH); // warm up the threads, not measured
+
+        for (size_t splitDepth = 1; splitDepth <= BoggleSolver::MAX_SPLIT_DEPTH; splitDepth++)
+        {
+            double fastest{ timeSolve(pool, splitDepth) };
+            for (size_t run = 1; run < m_runs; run++)
+            {
+                fastest = min(fastest, timeSolve(pool, splitDepth));
+            }
+            m_results.push_back({ threadCount, splitDepth, fastest });
+        }
+    }
+
+    m_best = *min_element(m_results.begin(), m_results.end(), [](const TuningResult& lhs, const TuningResult& rhs) {
+        return lhs.m_milliseconds < rhs.m_milliseconds;
+    });
+    return m_best;
+}
+
+
+/// <summary>
+/// Writes the time of every combination measured by tune(), followed by the one
+/// that was picked.
+/// </summary>
+/// <param name="log">stream to write the report to</param>
+void ThreadTuner::report(ostream& log) const
+{
+    const auto flags{ log.flags() };
+    const auto precision{ log.precision() };
+    log << fixed << setprecision(3);
+
+    for (const auto& result : m_results)
+    {
+        log << "Tuning: " << result.m_threadCount << " threads, split depth " << result.m_splitDepth
+            << ": " << result.m_milliseconds << " ms\n";
+    }
+    log << "Tuned: " << m_best.m_threadCount << " threads, split depth " << m_best.m_splitDepth
+        << " (" << m_best.m_milliseconds << " ms per solve)\n";
+
+    log.flags(flags);
+    log.precision(precision);
+}
+
+
+/// <summary>
+/// Solves the calibration board once, including building the board trie (if any)
+/// and merging the answers.
+/// </summary>
+/// <param name="pool">pool to solve the board with</param>
+/// <param name="splitDepth">split depth of the solver</param>
+/// <returns>wall time of the solve in milliseconds</returns>
+double ThreadTuner::timeSolve(shared_ptr<ThreadPool> pool, size_t splitDepth) const
+{
+    const auto start{ chrono::steady_clock::now() };
+
+    BoggleSolver solver(m_dictionary, pool, m_board, splitDepth, m_lengths, m_useBoardTrie, m_engine);
+    solver.solveBoard();
+    solver.waitForSolve();
+    solver.answerCount(); // the answers are merged on first read, which is part of the solve
+
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,136 @@
+//
+// Place Holder Copyright Header
+//
+
+/* SSE2 is part of every x64 target. The byte compares below only look at ranges
+inside 0-127, so they hold whether char is signed or not. */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define WORD_SCANNER_SSE2
+#include <emmintrin.h>
+#endif
+
+#include <cstdint>
+
+#include "CompiledTrie.h"   // countBits(...)
+#include "WordScanner.h"
+
+
+/// <summary>
+/// Whitespace as reading a string from a stream sees it in the "C" locale.
+/// </summary>
+/// <param name="letter">byte to check</param>
+/// <returns>true for ' ', '\t', '\n', '\v', '\f' and '\r'</returns>
+static bool isSpace(char letter)
+{
+    return (letter == ' ') || ((letter >= '\t') && (letter <= '\r'));
+}
+
+
+/// <summary>
+/// Class constructor.
+/// </summary>
+/// <param name="data">first byte of the text, may be nullptr if size is 0</param>
+/// <param name="size">bytes of text</param>
+WordScanner::WordScanner(const char* data, size_t size) :
+    m_position(data),
+    m_end(data + size),
+    m_lowered(),
+    m_skippedWords(0)
+{
+    // intentionally blank
+}
+
+
+/// <summary>
+/// Finds the next word of the buffer, lowercased. Words with anything else than
+/// letters are skipped and counted (see skippedWords()).
+/// </summary>
+/// <param name="word">set to the word found, left as it was at the end of the buffer</param>
+/// <returns>true if a word was found, false at the end of the buffer</returns>
+bool WordScanner::next(WordView& word)
+{
+    while (true)
+    {
+        while ((m_position < m_end) && isSpace(*m_position)) m_position++;
+        if (m_position == m_end) return false; // early return, nothing left
+
+        const auto start{ m_position };
+        bool hasUpper{ false };
+        bool hasOther{ false };
+        scanWord(hasUpper, hasOther);
+        const auto length{ static_cast<size_t>(m_position - start) };
+
+        if (hasOther)
+        {
+            m_skippedWords++;
+            continue;
+        }
+
+        if (!hasUpper)
+        {
+            word = { start, length };
+            return true;
+        }
+
+        m_lowered.emplace_back(start, length);
+        for (auto& letter : m_lowered.back())
+        {
+            if ((letter >= 'A') && (letter <= 'Z')) letter = static_cast<char>(letter - 'A' + 'a');
+        }
+        word = { m_lowered.back().data(), length };
+        return true;
+    }
+}
+
+
+/// <summary>
+/// Moves m_position from the first byte of a word to the whitespace or end of
+/// buffer after it, noting what the word holds besides 'a'-'z'.
+///
+/// While 16 bytes are left, they are classified at once: one mask of the whitespace,
+/// one of the upper case letters and one of everything else that isn't a lower case
+/// letter. The lowest whitespace bit is where the word ends, and only the bits
+/// below it count for the word. The last few bytes take the scalar loop, so nothing
+/// past the end of the buffer is ever read.
+/// </summary>
+/// <param name="hasUpper">set if the word has an 'A'-'Z'</param>
+/// <param name="hasOther">set if the word has anything else than a letter</param>
+void WordScanner::scanWord(bool& hasUpper, bool& hasOther)
+{
+#ifdef WORD_SCANNER_SSE2
+    const auto inRange = [](__m128i block, char low, char high)
+    {
+        return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(static_cast<char>(low - 1))),
+            _mm_cmplt_epi8(block, _mm_set1_epi8(static_cast<char>(high + 1))));
+    };
+
+    while (m_end - m_position >= 16)
+    {
+        const auto block{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_position)) };
+        const auto space{ _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), inRange(block, '\t', '\r')) };
+        const auto upper{ inRange(block, 'A', 'Z') };
+        const auto letter{ _mm_or_si128(upper, inRange(block, 'a', 'z')) };
+
+        const auto spaceMask{ static_cast<uint32_t>(_mm_movemask_epi8(space)) };
+        const auto upperMask{ static_cast<uint32_t>(_mm_movemask_epi8(upper)) };
+        const auto otherMask{ ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(space, letter))) & 0xFFFFu };
+
+        // bytes of the word in this block: all 16, or the ones below the first whitespace
+        const auto wordLength{ (spaceMask == 0) ? 16u : countBits((spaceMask & (~spaceMask + 1)) - 1) };
+        const auto wordMask{ (1u << wordLength) - 1 };
+        hasUpper = hasUpper || ((upperMask & wordMask) != 0);
+        hasOther = hasOther || ((otherMask & wordMask) != 0);
+        m_position += wordLength;
+
+        if (spaceMask != 0) return; // early return, the word ended in this block
+    }
+#endif
+
+    while ((m_position < m_end) && !isSpace(*m_position))
+    {
+        const auto letter{ *m_position };
+        if ((letter >= 'A') && (letter <= 'Z')) hasUpper = true;
+        else if ((letter < 'a') || (letter > 'z')) hasOther = true;
+        m_position++;
+    }
+}
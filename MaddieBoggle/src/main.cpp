@@ -1,71 +1,373 @@
 
 #include <iostream>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include "AnswerWriter.h"
+#include "BatchSolver.h"
 #include "BoggleBoard.h"
+#include "BoggleServer.h"
 #include "BoggleSolver.h"
 #include "Dictionary.h"
+#include "DictionaryImage.h"
+#include "StatsReport.h"
 #include "ThreadPool.h"
+#include "ThreadTuner.h"
 
 
 using namespace std;
 
 
-// This value was determined through various runtime metrics. See 
-// design documents folder for the metrics spreadsheet.
-constexpr size_t MAX_NUM_POOL_THREADS{ 4 };
-
-
-constexpr size_t DEFAULT_NODE_POOL_SIZE{ 20000 };
-
-
 int main(const int argc, const char* const argv[])
 {
     // extra scoping for memory profiling
     {
         // PROCESS CLI ARGS --------------------------------------------------------
-        if (argc != 4)
+        vector<string> fileArgs{};
+        bool minimizeDictionary{ false };                   // --dawg  : build a suffix sharing dictionary
+        DictionaryLayout layout{ DictionaryLayout::TRIE };  // --radix : collapse single child chains
+        bool useImageCache{ false };                        // --cache : load/save a binary dictionary image
+        bool batchMode{ false };                            // --batch : solve a directory or manifest of boards
+        bool serverMode{ false };                           // --serve : answer boards read from stdin
+        string socketPath{};                                // --socket <path> : answer boards read from a local socket
+        TaskScheduling scheduling{ TaskScheduling::WORK_STEALING }; // --shared-queue : one task queue for all threads
+        size_t threadCount{ thread::hardware_concurrency() };       // --threads <count> : size of the thread pool
+        bool autoTune{ false };                                     // --threads auto : measure the best thread count
+        WordLengthRange lengths{};                          // --min-length <count>, --max-length <count> : lengths of the words to find
+        bool useBoardTrie{ false };                         // --board-trie : search a per board cut of the dictionary
+        SearchEngine engine{ SearchEngine::AUTO };          // --engine <board | dictionary | auto> : how every board is searched
+        AnswerFormat answerFormat{ AnswerFormat::TEXT };    // --format <text | json | ids | front-coded> : format of the answers
+        bool showStats{ false };                            // --stats [text | json] : report phase times and counters to stderr
+        StatsFormat statsFormat{ StatsFormat::TEXT };
+        bool badArgs{ false };
+        for (int i = 1; i < argc; i++)
         {
-            std::cerr << "Usage: MaddieBoggle <dictionary_filename> <board_filename> <output_filename>" << std::endl;
+            const string arg{ argv[i] };
+            if (arg == "--dawg") minimizeDictionary = true;
+            else if (arg == "--radix") layout = DictionaryLayout::RADIX;
+            else if (arg == "--cache") useImageCache = true;
+            else if (arg == "--batch") batchMode = true;
+            else if (arg == "--serve") serverMode = true;
+            else if (arg == "--shared-queue") scheduling = TaskScheduling::SHARED_QUEUE;
+            else if (arg == "--stats")
+            {
+                showStats = true;
+                const string value{ (i + 1 < argc) ? argv[i + 1] : "" };
+                if (value == "json") statsFormat = StatsFormat::JSON;
+                if ((value == "json") || (value == "text")) i++; // the format is optional
+            }
+            else if (arg == "--threads")
+            {
+                const string value{ (++i < argc) ? argv[i] : "" };
+                if (value == "auto") autoTune = true;
+                else if (!value.empty() && (value.size() < 6) && (value.find_first_not_of("0123456789") == string::npos) && (stoul(value) > 0)) threadCount = stoul(value);
+                else badArgs = true;
+            }
+            else if (arg == "--board-trie")
+            {
+                useBoardTrie = true;
+            }
+            else if (arg == "--engine")
+            {
+                const string value{ (++i < argc) ? argv[i] : "" };
+                if (value == "board") engine = SearchEngine::BOARD;
+                else if (value == "dictionary") engine = SearchEngine::DICTIONARY;
+                else if (value != "auto") badArgs = true;
+            }
+            else if (arg == "--format")
+            {
+                const string value{ (++i < argc) ? argv[i] : "" };
+                if (!AnswerWriter::parseFormat(value, answerFormat)) badArgs = true;
+            }
+            else if ((arg == "--min-length") || (arg == "--max-length"))
+            {
+                const string value{ (++i < argc) ? argv[i] : "" };
+                if (value.empty() || (value.size() > 5) || (value.find_first_not_of("0123456789") != string::npos)) badArgs = true;
+                else if (arg == "--min-length") lengths.m_min = stoul(value);
+                else lengths.m_max = stoul(value);
+            }
+            else if (arg == "--socket")
+            {
+                serverMode = true;
+                if (++i < argc) socketPath = argv[i];
+                else badArgs = true;
+            }
+            else fileArgs.push_back(arg);
+        }
+
+        const size_t expectedFileArgs{ serverMode ? size_t{ 1 } : size_t{ 3 } };
+        const bool limitLengths{ (lengths.m_min > 0) || (lengths.m_max != SIZE_MAX) };
+        if (badArgs || (fileArgs.size() != expectedFileArgs) || (minimizeDictionary && (layout != DictionaryLayout::TRIE)) || (batchMode && serverMode) || (autoTune && serverMode)
+            || (lengths.m_min > lengths.m_max) || (limitLengths && serverMode) || (useBoardTrie && serverMode)
+            || ((engine != SearchEngine::AUTO) && serverMode) || ((answerFormat != AnswerFormat::TEXT) && serverMode))
+        {
+            std::cerr << "Usage: MaddieBoggle [--dawg | --radix] [--cache] [--shared-queue] [--threads <count | auto>] [--min-length <count>] [--max-length <count>] [--board-trie]\n"
+                << "                    [--engine <board | dictionary | auto>] [--format <text | json | ids | front-coded>] [--stats [text | json]]\n"
+                << "                    <dictionary_filename> <board_filename> <output_filename | ->\n"
+                << "       MaddieBoggle [--dawg | --radix] [--cache] [--shared-queue] [--threads <count | auto>] [--min-length <count>] [--max-length <count>] [--board-trie]\n"
+                << "                    [--engine <board | dictionary | auto>] [--format <text | json | ids | front-coded>] [--stats [text | json]]\n"
+                << "                    --batch <dictionary_filename> <boards_directory | boards_manifest> <output_directory>\n"
+                << "       MaddieBoggle [--dawg | --radix] [--cache] [--shared-queue] [--threads <count>] [--stats [text | json]] (--serve | --socket <socket_path>) <dictionary_filename>" << std::endl;
             return -1;
         }
 
-        cout << "Maddie Boggle\n"; // sanity print
+        /* Serving over stdin/stdout keeps stdout for responses only, and so does
+        writing the answers to stdout, so anything informational goes to stderr instead. */
+        const bool serveStdio{ serverMode && socketPath.empty() };
+        const bool answersToStdout{ !serverMode && !batchMode && (fileArgs[2] == "-") };
+        ostream& info{ (serveStdio || answersToStdout) ? cerr : cout };
 
-        const string dictionaryPath{ argv[1] };
-        const string boardPath{ argv[2] };
-        const string outputPath{ argv[3] };
+        info << "Maddie Boggle\n"; // sanity print
 
-        // CREATE THREAD POOL ------------------------------------------------------
-        auto threadPool{ make_shared<ThreadPool>(MAX_NUM_POOL_THREADS) };
+        const string dictionaryPath{ fileArgs[0] };
+
+        /* Phases are always timed, it costs a clock read per phase. The report
+        goes to stderr so it never mixes with answers or server responses. */
+        StatsReport stats{};
+        auto reportStats = [&stats, showStats, statsFormat](const ThreadPool& pool) {
+            stats.endPhase();
+            if (!showStats) return;
+            stats.addCounter("stolen_tasks", pool.stolenTasks());
+            stats.setWorkers(pool.getWorkerStats());
+            stats.write(cerr, statsFormat);
+        };
 
-        
         // IMPORT DICTIONARY -------------------------------------------------------
-        auto tempDictionary{ make_unique<Dictionary>(DEFAULT_NODE_POOL_SIZE) };
+        stats.startPhase("dictionary_import");
+        auto tempDictionary{ make_unique<Dictionary>() };
         
-        auto errCode{ tempDictionary->importDictionary(dictionaryPath) };
-        if (errCode != ErrorCode::SUCCESS)
+        ErrorCode errCode{ ErrorCode::SUCCESS };
+
+        /* With --cache, a binary image of the frozen dictionary is kept next to the
+        text file, one per layout. It is only used while the text file is unchanged,
+        otherwise the dictionary is imported as usual and the image is rewritten. */
+        uint64_t fingerprint{ 0 };
+        string imagePath{};
+        bool loadedFromImage{ false };
+        if (useImageCache)
         {
-            return static_cast<int>(errCode);
+            errCode = DictionaryImage::fingerprintFile(dictionaryPath, fingerprint);
+            if (errCode != ErrorCode::SUCCESS)
+            {
+                return static_cast<int>(errCode);
+            }
+
+            const string layoutName{ minimizeDictionary ? "dawg" : ((layout == DictionaryLayout::RADIX) ? "radix" : "trie") };
+            imagePath = dictionaryPath + "." + layoutName + ".img";
+            loadedFromImage = (tempDictionary->loadImage(imagePath, fingerprint) == ErrorCode::SUCCESS);
         }
+
+        if (loadedFromImage)
+        {
+            info << "Dictionary loaded from image: " << imagePath << "\n";
+        }
+        else if (minimizeDictionary)
+        {
+            /* Builds an already frozen dictionary, there is no trie to compile. */
+            errCode = tempDictionary->importMinimizedDictionary(dictionaryPath);
+            if (errCode != ErrorCode::SUCCESS)
+            {
+                return static_cast<int>(errCode);
+            }
+
+            const auto report{ tempDictionary->getMinimizationReport() };
+            info << "Dictionary nodes before minimization: " << report.m_nodesBefore
+                << ", after minimization: " << report.m_nodesAfter << "\n";
+        }
+        else
+        {
+            /* The words are inserted on a pool of their own, since the solving pool
+            may still need to be tuned. The threads end with the import. */
+            {
+                ThreadPool buildPool(threadCount, scheduling);
+                errCode = tempDictionary->importDictionary(dictionaryPath, buildPool);
+            }
+            if (errCode != ErrorCode::SUCCESS)
+            {
+                return static_cast<int>(errCode);
+            }
+
+            const auto& childArena{ tempDictionary->getChildArena() };
+            stats.addCounter("trie_nodes_allocated", tempDictionary->trieNodeCount());
+            stats.addCounter("child_arena_bytes", childArena.bytesUsed());
+            stats.addCounter("child_arena_blocks", childArena.blockCount());
+            stats.addCounter("child_arena_bytes_reserved", childArena.bytesReserved());
+
+            /* Compile the trie into its flat read-only form before sharing it. */
+            errCode = tempDictionary->freeze(layout);
+            if (errCode != ErrorCode::SUCCESS)
+            {
+                return static_cast<int>(errCode);
+            }
+        }
+
+        if (useImageCache && !loadedFromImage)
+        {
+            // a missing image only costs the next run its startup time, so carry on
+            if (tempDictionary->saveImage(imagePath, fingerprint) != ErrorCode::SUCCESS)
+            {
+                cerr << "Unable to write dictionary image: " << imagePath << "\n";
+            }
+        }
+
+        if (minimizeDictionary || (layout != DictionaryLayout::TRIE))
+        {
+            info << "Dictionary records: " << tempDictionary->nodeCount() 
+                << ", memory: " << tempDictionary->memoryUsage() << " bytes\n";
+        }
+
+        stats.addCounter("dictionary_words", tempDictionary->wordCount());
+        stats.addCounter("dictionary_records", tempDictionary->nodeCount());
+        stats.addCounter("dictionary_bytes", tempDictionary->memoryUsage());
+        stats.addCounter("longest_word", tempDictionary->longestWord());
+
         /* Moving this to a pointer to a const object so it is thread safe. */
         shared_ptr<const Dictionary> threadSafeDictionary{ move(tempDictionary) };
 
 
+        // SERVE BOARDS ------------------------------------------------------------
+        if (serverMode)
+        {
+            /* Runs until the input ends or a client asks for a shutdown. */
+            auto threadPool{ make_shared<ThreadPool>(threadCount, scheduling) };
+            threadPool->setCollectStats(showStats);
+            stats.startPhase("serve");
+            BoggleServer server(threadSafeDictionary, threadPool);
+            if (serveStdio)
+            {
+                server.serve(cin, cout);
+            }
+            else
+            {
+                errCode = server.serveSocket(socketPath);
+            }
+
+            server.reportLatency(cerr);
+            reportStats(*threadPool);
+            return static_cast<int>(errCode);
+        }
+
+        const string boardPath{ fileArgs[1] };     // boards directory or manifest in batch mode
+        const string outputPath{ fileArgs[2] };    // output directory in batch mode
+
+
+        /* In batch mode, the boards are listed before the thread pool exists so
+        the first one can be used to tune it. */
+        vector<BatchEntry> batchEntries{};
+        if (batchMode)
+        {
+            stats.startPhase("board_listing");
+            errCode = BatchSolver::listBoards(boardPath, outputPath, batchEntries, answerFormat);
+            if (errCode != ErrorCode::SUCCESS)
+            {
+                return static_cast<int>(errCode);
+            }
+        }
+
+
         // IMPORT BOARD ------------------------------------------------------------
+        if (!batchMode || autoTune) stats.startPhase("board_import");
         BoggleBoard board{};
-        errCode = importBoard(boardPath, board);
-        if (errCode != ErrorCode::SUCCESS)
+        if (!batchMode)
         {
+            errCode = importBoard(boardPath, board);
+            if (errCode != ErrorCode::SUCCESS)
+            {
+                return static_cast<int>(errCode);
+            }
+        }
+        else if (autoTune && !batchEntries.empty())
+        {
+            // the batch reports a bad board itself, the pool just isn't tuned then
+            if (importBoard(batchEntries.front().m_boardPath, board) != ErrorCode::SUCCESS) board.clear();
+        }
+
+
+        // CREATE THREAD POOL ------------------------------------------------------
+        size_t splitDepth{ BoggleSolver::MAX_SPLIT_DEPTH };
+        if (autoTune && !board.empty())
+        {
+            /* Short calibration solves of the board (the first one of a batch)
+            with every candidate thread count and split depth. */
+            stats.startPhase("thread_tuning");
+            ThreadTuner tuner(threadSafeDictionary, board, scheduling, lengths, useBoardTrie, engine);
+            const auto best{ tuner.tune() };
+            tuner.report(info);
+
+            threadCount = best.m_threadCount;
+            splitDepth = best.m_splitDepth;
+        }
+        auto threadPool{ make_shared<ThreadPool>(threadCount, scheduling) };
+        threadPool->setCollectStats(showStats);
+
+
+        // SOLVE BATCH -------------------------------------------------------------
+        if (batchMode)
+        {
+            /* The dictionary and the thread pool are shared by every board. */
+            stats.startPhase("batch_solve");
+            BatchSolver batch(threadSafeDictionary, threadPool, splitDepth, lengths, useBoardTrie, engine, answerFormat);
+            for (const auto& entry : batchEntries)
+            {
+                batch.addBoard(entry.m_boardPath, entry.m_outputPath);
+            }
+
+            errCode = batch.solveAll(cout);
+
+            SearchStats search{};
+            for (const auto& result : batch.getResults())
+            {
+                search.m_nodesExpanded += result.m_search.m_nodesExpanded;
+                search.m_dictionaryLookups += result.m_search.m_dictionaryLookups;
+                search.m_prunedPaths += result.m_search.m_prunedPaths;
+            }
+            stats.addCounter("boards", batchEntries.size());
+            stats.addCounter("dfs_nodes_expanded", search.m_nodesExpanded);
+            stats.addCounter("dictionary_lookups", search.m_dictionaryLookups);
+            stats.addCounter("pruned_paths", search.m_prunedPaths);
+            reportStats(*threadPool);
             return static_cast<int>(errCode);
         }
 
 
         // SOLVE BOARD -------------------------------------------------------------
-        auto solver{ BoggleSolver(threadSafeDictionary, threadPool, board) };
-        solver.solveBoard();
+        stats.startPhase("solve");
+        auto solver{ BoggleSolver(threadSafeDictionary, threadPool, board, splitDepth, lengths, useBoardTrie, engine) };
+        errCode = solver.solveBoard();
+        if (errCode != ErrorCode::SUCCESS)
+        {
+            return static_cast<int>(errCode);
+        }
         threadPool->waitForCompletion();
-        solver.exportAnswers(outputPath);
+
+        stats.startPhase("export");
+        errCode = solver.exportAnswers(outputPath, answerFormat);
+        stats.endPhase();
+        if (errCode != ErrorCode::SUCCESS)
+        {
+            return static_cast<int>(errCode);
+        }
+
+        if (showStats)
+        {
+            const auto search{ solver.getSearchStats() };
+            const auto answers{ solver.getAnswerStats() };
+            size_t boardCells{ 0 };
+            for (const auto& row : board) boardCells += row.size();
+            stats.addCounter("board_cells", boardCells);
+            stats.addCounter("dfs_nodes_expanded", search.m_nodesExpanded);
+            stats.addCounter("dictionary_lookups", search.m_dictionaryLookups);
+            stats.addCounter("pruned_paths", search.m_prunedPaths);
+            stats.addCounter("search_trie_records", solver.searchTrieNodes());
+            stats.addCounter("dictionary_engine", (solver.getEngine() == SearchEngine::DICTIONARY) ? 1 : 0);
+            stats.addCounter("split_tasks", solver.splitCount());
+            stats.addCounter("answers_found", answers.m_wordsFound);
+            stats.addCounter("unique_answers", answers.m_uniqueWords);
+            stats.addCounter("duplicate_answers", answers.m_wordsFound - answers.m_uniqueWords);
+        }
+        reportStats(*threadPool);
     }
     // end extra memory profiling scope
 